@@ -0,0 +1,260 @@
+#include <love/common/data/files/file_compression.hpp>
+#include <love/common/data/files/file_io.hpp>
+#include <love/common/data/files/logger.hpp>
+#include <love/common/data/strings/string.hpp>
+#include <love/common/system/metrics.hpp>
+#include <love/common/system/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace love_engine;
+
+typedef struct Benchmark_ {
+    std::string name;
+    // Runs the measured operation @p iterations times
+    std::function<void(uint64_t iterations)> run;
+    // Bytes one iteration processes, for throughput. 0 if not meaningful.
+    uint64_t bytesPerIteration = 0;
+} Benchmark;
+
+typedef struct Result_ {
+    uint64_t iterations = 0;
+    // Nanoseconds per iteration of every repetition
+    std::vector<double> realTimes;
+    std::vector<double> cpuTimes;
+} Result;
+
+// Stops the compiler from optimising away @p value
+template<class T>
+static void _keep(T&& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+static double _median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const size_t middle = values.size() / 2;
+    return (values.size() % 2) ? values[middle] : (values[middle - 1] + values[middle]) / 2.;
+}
+
+// @return Wall and process CPU nanoseconds of running @p benchmark for @p iterations.
+static std::pair<double, double> _time(const Benchmark& benchmark, const uint64_t iterations) {
+    const std::clock_t cpuStart = std::clock();
+    const auto start = std::chrono::steady_clock::now();
+    benchmark.run(iterations);
+    const double real = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    const double cpu = static_cast<double>(std::clock() - cpuStart) * 1e9 / CLOCKS_PER_SEC;
+    return {real, cpu};
+}
+
+// Grows the iteration count until one repetition takes @p minTime, then repeats it
+static Result _run(const Benchmark& benchmark, const double minTime, const size_t repetitions) {
+    Result result;
+    uint64_t iterations = 1;
+    while (true) {
+        const double real = _time(benchmark, iterations).first;
+        if ((real >= minTime) || (iterations >= (uint64_t(1) << 40))) break;
+        const double scale = (real > 0.) ? std::min(10., 1.4 * minTime / real) : 10.;
+        iterations = std::max(iterations + 1, static_cast<uint64_t>(iterations * scale));
+    }
+
+    result.iterations = iterations;
+    for (size_t i = 0; i < repetitions; ++i) {
+        const auto [real, cpu] = _time(benchmark, iterations);
+        result.realTimes.push_back(real / iterations);
+        result.cpuTimes.push_back(cpu / iterations);
+    }
+    return result;
+}
+
+// Deterministic data that compresses like typical game files: repeated records with noise
+static std::vector<uint8_t> _make_Data(const size_t size) {
+    std::mt19937 random(42);
+    std::vector<uint8_t> data(size);
+    const char record[] = "{\"id\":0000,\"name\":\"entity\",\"x\":0.000,\"z\":0.000}\n";
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = (random() % 8 == 0) ? static_cast<uint8_t>('0' + random() % 10) : static_cast<uint8_t>(record[i % (sizeof(record) - 1)]);
+    }
+    return data;
+}
+
+static std::vector<Benchmark> _get_Benchmarks(const std::string& directory) {
+    std::vector<Benchmark> benchmarks;
+
+    // Logger
+    benchmarks.push_back(Benchmark{.name = "Logger/log_console", .run = [](uint64_t iterations) {
+        const Logger logger("");
+        for (uint64_t i = 0; i < iterations; ++i) logger.log("Benchmark message with a typical length for the engine's logs.");
+    }});
+    benchmarks.push_back(Benchmark{.name = "Logger/log_file", .run = [directory](uint64_t iterations) {
+        const Logger logger(directory + "/logger.log", true);
+        for (uint64_t i = 0; i < iterations; ++i) logger.log("Benchmark message with a typical length for the engine's logs.");
+        // Include the asynchronous appends, so the cost is not hidden from the next benchmark
+        const Metrics::Gauge& pendingWrites = Metrics::get_Gauge("love_log_pending_writes");
+        while (pendingWrites.get() > 0) std::this_thread::yield();
+    }});
+
+    // Thread
+    benchmarks.push_back(Benchmark{.name = "Thread/create_join", .run = [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Thread thread("BENCHMARK", []() {});
+            thread.join();
+        }
+    }});
+    benchmarks.push_back(Benchmark{.name = "Thread/get_Thread_Name", .run = [](uint64_t iterations) {
+        const std::thread::id id = std::this_thread::get_id();
+        for (uint64_t i = 0; i < iterations; ++i) _keep(Thread::get_Thread_Name(id));
+    }});
+
+    // FileIO
+    for (const size_t size : {size_t(4096), size_t(1024 * 1024)}) {
+        const std::string suffix = (size < 1024 * 1024) ? "4KiB" : "1MiB";
+        const std::string path = directory + "/file_" + suffix;
+        const std::string data(size, 'x');
+        benchmarks.push_back(Benchmark{.name = "FileIO/write_File/" + suffix, .run = [path, data](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) FileIO::write_File(path, data);
+        }, .bytesPerIteration = size});
+        benchmarks.push_back(Benchmark{.name = "FileIO/write_File_Atomic/" + suffix, .run = [path, data](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) FileIO::write_File_Atomic(path, data);
+        }, .bytesPerIteration = size});
+        benchmarks.push_back(Benchmark{.name = "FileIO/read_File_Content/" + suffix, .run = [path](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) _keep(FileIO::read_File_Content(path));
+        }, .bytesPerIteration = size});
+    }
+    benchmarks.push_back(Benchmark{.name = "FileIO/append_File/256B", .run = [directory](uint64_t iterations) {
+        const std::string path = directory + "/append";
+        const std::string data(256, 'x');
+        FileIO::clear_File(path);
+        for (uint64_t i = 0; i < iterations; ++i) FileIO::append_File(path, data);
+    }, .bytesPerIteration = 256});
+
+    // FileCompression
+    const auto data = std::make_shared<const std::vector<uint8_t>>(_make_Data(1024 * 1024));
+    for (uint32_t preset = 0; preset <= 9; ++preset) {
+        benchmarks.push_back(Benchmark{.name = "FileCompression/compress/preset_" + std::to_string(preset), .run = [data, preset](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) _keep(FileCompression::compress(data->data(), data->size(), preset));
+        }, .bytesPerIteration = data->size()});
+        // Compressed on first run, so filtered out benchmarks cost nothing
+        const auto compressed = std::make_shared<std::vector<uint8_t>>();
+        benchmarks.push_back(Benchmark{.name = "FileCompression/decompress/preset_" + std::to_string(preset), .run = [data, compressed, preset](uint64_t iterations) {
+            if (compressed->empty()) *compressed = FileCompression::compress(data->data(), data->size(), preset);
+            for (uint64_t i = 0; i < iterations; ++i) _keep(FileCompression::decompress(compressed->data(), compressed->size(), data->size()));
+        }, .bytesPerIteration = data->size()});
+    }
+
+    // String
+    const std::string text(1024, 'a');
+    benchmarks.push_back(Benchmark{.name = "String/reverse/1KiB", .run = [text](uint64_t iterations) {
+        std::string value = text;
+        for (uint64_t i = 0; i < iterations; ++i) _keep(String::reverse(value));
+    }, .bytesPerIteration = 1024});
+    benchmarks.push_back(Benchmark{.name = "String/insert/1KiB", .run = [text](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            std::string value = text;
+            _keep(String::insert(value, 512, "inserted"));
+        }
+    }, .bytesPerIteration = 1024});
+    benchmarks.push_back(Benchmark{.name = "String/is_ASCII/1KiB", .run = [text](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) _keep(String::is_ASCII(text));
+    }, .bytesPerIteration = 1024});
+    benchmarks.push_back(Benchmark{.name = "String/translate_Escape_Character", .run = [](uint64_t iterations) {
+        const char escapes[] = "abfnrtv\\'\"?0";
+        for (uint64_t i = 0; i < iterations; ++i) _keep(String::translate_Escape_Character(escapes[i % (sizeof(escapes) - 1)]));
+    }});
+
+    return benchmarks;
+}
+
+static std::string _escape_Json(const std::string& value) {
+    std::string escaped;
+    for (const char character : value) {
+        if ((character == '"') || (character == '\\')) escaped += '\\';
+        escaped += character;
+    }
+    return escaped;
+}
+
+// love_bench [--filter <substring>] [--out <file>] [--min-time <ms>] [--repetitions <count>]
+// Runs microbenchmarks of the common library and writes the results as JSON, laid out like Google
+// Benchmark's output so existing comparison tools can read it. Progress goes to stderr.
+int main(int argc, char** argv) {
+    std::string filter, outPath = "love_bench.json";
+    double minTime = 200e6;
+    size_t repetitions = 5;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0) filter = argv[++i];
+        else if (std::strcmp(argv[i], "--out") == 0) outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--min-time") == 0) minTime = std::strtod(argv[++i], nullptr) * 1e6;
+        else if (std::strcmp(argv[i], "--repetitions") == 0) repetitions = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+    }
+
+    const std::string directory = (std::filesystem::temp_directory_path() / "love_bench").string();
+    std::filesystem::create_directories(directory);
+
+    // Logger benchmarks print every message, which would bury the progress output
+#ifdef _WIN32
+    std::FILE* console = std::freopen("NUL", "w", stdout);
+#else
+    std::FILE* console = std::freopen("/dev/null", "w", stdout);
+#endif
+    if (!console) std::fprintf(stderr, "Could not silence stdout; logger output follows.\n");
+
+    std::string json;
+    const std::time_t now = std::time(nullptr);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    json += "{\n  \"context\": {\n";
+    json += "    \"date\": \"" + std::string(date) + "\",\n";
+    json += "    \"executable\": \"" + _escape_Json(argv[0]) + "\",\n";
+    json += "    \"num_cpus\": " + std::to_string(std::thread::hardware_concurrency()) + ",\n";
+#ifdef DEBUG
+    json += "    \"library_build_type\": \"debug\",\n";
+#else
+    json += "    \"library_build_type\": \"release\",\n";
+#endif
+    json += "    \"repetitions\": " + std::to_string(repetitions) + "\n  },\n  \"benchmarks\": [";
+
+    bool first = true;
+    for (const Benchmark& benchmark : _get_Benchmarks(directory)) {
+        if (!filter.empty() && (benchmark.name.find(filter) == std::string::npos)) continue;
+        const Result result = _run(benchmark, minTime, repetitions);
+        const double realTime = _median(result.realTimes), cpuTime = _median(result.cpuTimes);
+        const auto [minRealTime, maxRealTime] = std::minmax_element(result.realTimes.begin(), result.realTimes.end());
+
+        char line[512];
+        std::snprintf(line, sizeof(line),
+            "%s\n    {\n      \"name\": \"%s\",\n      \"run_type\": \"aggregate\",\n      \"aggregate_name\": \"median\",\n"
+            "      \"iterations\": %llu,\n      \"real_time\": %.3f,\n      \"real_time_min\": %.3f,\n      \"real_time_max\": %.3f,\n"
+            "      \"cpu_time\": %.3f,\n      \"time_unit\": \"ns\"",
+            first ? "" : ",", _escape_Json(benchmark.name).c_str(), static_cast<unsigned long long>(result.iterations),
+            realTime, *minRealTime, *maxRealTime, cpuTime
+        );
+        json += line;
+        if (benchmark.bytesPerIteration) {
+            std::snprintf(line, sizeof(line), ",\n      \"bytes_per_second\": %.0f", benchmark.bytesPerIteration * 1e9 / realTime);
+            json += line;
+        }
+        json += "\n    }";
+        first = false;
+
+        std::fprintf(stderr, "%-45s %14.1f ns %14.1f ns cpu %12llu iterations\n",
+            benchmark.name.c_str(), realTime, cpuTime, static_cast<unsigned long long>(result.iterations)
+        );
+    }
+    json += "\n  ]\n}\n";
+
+    FileIO::write_File(outPath, json);
+    std::filesystem::remove_all(directory);
+    std::fprintf(stderr, "Results written to \"%s\".\n", outPath.c_str());
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,83 @@
+#include <love/common/system/thread_pool.hpp>
+
+#include <love/server/world/pathfinder.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace love_engine;
+
+// pathfinding_bench [queries] [world size...]
+// Resolves random path requests on a world with scattered walls and prints paths per second.
+// Each size runs twice with the same queries, so the second pass measures a warm region cache.
+int main(int argc, char** argv) {
+    const size_t queries = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    std::vector<uint32_t> sizes;
+    for (int i = 2; i < argc; ++i) sizes.push_back(static_cast<uint32_t>(std::strtoul(argv[i], nullptr, 10)));
+    if (sizes.empty()) sizes = {256, 512, 1024};
+
+    ThreadPool pool("PATH_WORKER");
+    std::printf("%8s %8s %10s %12s %12s %10s %10s\n", "size", "pass", "build ms", "paths/s", "mean length", "hits", "failed");
+
+    for (const uint32_t size : sizes) {
+        World world(size, size);
+        std::mt19937 random(1234);
+        std::uniform_int_distribution<int32_t> coordinate(0, static_cast<int32_t>(size) - 1), length(4, 24), cost(1, 4);
+
+        // Short wall segments plus rough terrain
+        for (uint32_t wall = 0; wall < size * size / 64; ++wall) {
+            const int32_t x = coordinate(random), z = coordinate(random), wallLength = length(random);
+            const bool horizontal = random() & 1;
+            for (int32_t i = 0; i < wallLength; ++i) world.set_Tile_Cost(horizontal ? x + i : x, horizontal ? z : z + i, 0);
+        }
+        for (uint32_t tile = 0; tile < size * size / 8; ++tile) {
+            const int32_t x = coordinate(random), z = coordinate(random);
+            if (world.is_Walkable(x, z)) world.set_Tile_Cost(x, z, static_cast<uint8_t>(cost(random)));
+        }
+
+        std::vector<AiComponent::Path_Request> requests;
+        requests.reserve(queries);
+        while (requests.size() < queries) {
+            const int32_t sx = coordinate(random), sz = coordinate(random), gx = coordinate(random), gz = coordinate(random);
+            if (!world.is_Walkable(sx, sz) || !world.is_Walkable(gx, gz)) continue;
+            requests.push_back(AiComponent::Path_Request{
+                .agent = static_cast<AiComponent::Agent_Id>(requests.size()),
+                .requestId = requests.size() + 1,
+                .start = AiComponent::Point{sx + 0.5f, 0.f, sz + 0.5f},
+                .goal = AiComponent::Point{gx + 0.5f, 0.f, gz + 0.5f},
+            });
+        }
+
+        const auto buildStart = std::chrono::steady_clock::now();
+        Pathfinder pathfinder(world, pool, Pathfinder::Settings{});
+        const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+
+        for (int pass = 0; pass < 2; ++pass) {
+            const Pathfinder::Statistics before = pathfinder.get_Statistics();
+            std::atomic<size_t> delivered = 0, waypoints = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+            pathfinder.resolve(std::vector<AiComponent::Path_Request>(requests), [&](AiComponent::Path_Result&& result) {
+                waypoints.fetch_add(result.waypoints.size(), std::memory_order_relaxed);
+                delivered.fetch_add(1, std::memory_order_relaxed);
+            });
+            pool.wait_For_Idle();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const Pathfinder::Statistics after = pathfinder.get_Statistics();
+            const uint64_t failed = after.failedQueries - before.failedQueries;
+            const size_t found = delivered.load() - failed;
+            std::printf("%8u %8s %10.1f %12.0f %12.1f %10llu %10llu\n",
+                size, pass == 0 ? "cold" : "warm", buildMs, static_cast<double>(delivered.load()) / seconds,
+                found ? static_cast<double>(waypoints.load()) / found : 0.,
+                static_cast<unsigned long long>(after.cacheHits - before.cacheHits), static_cast<unsigned long long>(failed)
+            );
+        }
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,65 @@
+#include <love/common/system/thread_pool.hpp>
+
+#include <love/server/components/physics_component.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace love_engine;
+
+// physics_bench [steps] [body count...]
+// Steps a box of falling spheres above a static floor and prints the time per step.
+int main(int argc, char** argv) {
+    const int steps = (argc > 1) ? std::atoi(argv[1]) : 100;
+    std::vector<size_t> bodyCounts;
+    for (int i = 2; i < argc; ++i) bodyCounts.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (bodyCounts.empty()) bodyCounts = {10000, 25000, 50000, 100000};
+
+    ThreadPool pool("PHYSICS_WORKER");
+    std::printf("%10s %12s %12s %12s %10s %10s\n", "bodies", "mean ms", "min ms", "max ms", "pairs", "islands");
+
+    for (const size_t bodyCount : bodyCounts) {
+        PhysicsComponent physics(PhysicsComponent::Settings{});
+        std::mt19937 random(1234);
+
+        // Roughly 8 cubic units per body
+        const float side = std::cbrt(static_cast<float>(bodyCount) * 8.f);
+        std::uniform_real_distribution<float> position(0.f, side), velocity(-1.f, 1.f);
+
+        // Static floor, one sphere per cell
+        for (float x = 0.f; x < side; x += 2.f) {
+            for (float z = 0.f; z < side; z += 2.f) physics.add_Body(x, -1.f, z, 0.f, 0.f, 0.f, 1.f, 0.f);
+        }
+        while (physics.get_Body_Count() < bodyCount) {
+            physics.add_Body(
+                position(random), position(random), position(random),
+                velocity(random), velocity(random), velocity(random),
+                0.5f, 1.f
+            );
+        }
+
+        double total = 0., fastest = 1e30, slowest = 0.;
+        size_t pairs = 0, islands = 0;
+        for (int step = 0; step < steps; ++step) {
+            const auto start = std::chrono::steady_clock::now();
+            physics.step(pool, 1.f / 60.f);
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            total += ms;
+            fastest = std::min(fastest, ms);
+            slowest = std::max(slowest, ms);
+            pairs += physics.get_Step_Statistics().pairs;
+            islands += physics.get_Step_Statistics().islands;
+        }
+
+        std::printf("%10zu %12.3f %12.3f %12.3f %10zu %10zu\n",
+            bodyCount, total / steps, fastest, slowest, pairs / steps, islands / steps
+        );
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,82 @@
+#include <love/server/world/world.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+
+using namespace love_engine;
+
+typedef struct Tick_Times_ {
+    double mean = 0.;
+    double max = 0.;
+    size_t ticks = 0;
+} Tick_Times;
+
+// Changes random tiles each tick, like a busy simulation would
+static void _tick(World& world, std::mt19937& random, const size_t edits) {
+    std::uniform_int_distribution<int32_t> x(0, static_cast<int32_t>(world.get_Width()) - 1), z(0, static_cast<int32_t>(world.get_Depth()) - 1);
+    for (size_t i = 0; i < edits; ++i) world.set_Tile_Cost(x(random), z(random), static_cast<uint8_t>(random() % 4 + 1));
+    world.update();
+}
+
+static double _time_Tick(World& world, std::mt19937& random, const size_t edits) {
+    const auto start = std::chrono::steady_clock::now();
+    _tick(world, random, edits);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void _add_Tick(Tick_Times& times, const double ms) {
+    times.mean = (times.mean * times.ticks + ms) / (times.ticks + 1);
+    times.max = std::max(times.max, ms);
+    ++times.ticks;
+}
+
+// snapshot_bench [world size] [edits per tick]
+// Compares tick times while a world snapshot saves in the background against a blocking save.
+int main(int argc, char** argv) {
+    const uint32_t size = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 4096;
+    const size_t edits = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    const std::string path = (std::filesystem::temp_directory_path() / "love_snapshot_bench.bkv").string();
+
+    World world(size, size, World::Settings{}, [](const int32_t chunkX, const int32_t chunkZ, std::vector<uint8_t>& tiles) {
+        std::mt19937 random(static_cast<uint32_t>(chunkX * 7919 + chunkZ));
+        for (uint8_t& tile : tiles) tile = static_cast<uint8_t>(random() % 5);
+    });
+    std::mt19937 random(1234);
+
+    Tick_Times idle;
+    for (int i = 0; i < 100; ++i) _add_Tick(idle, _time_Tick(world, random, edits));
+
+    // Background save: tick until the snapshot is written
+    Tick_Times background;
+    const uint64_t copiedBefore = world.get_Statistics().copiedChunks;
+    {
+        const auto start = std::chrono::steady_clock::now();
+        world.save_Snapshot(path);
+        _add_Tick(background, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    while (world.get_Statistics().snapshotSaves == 0) _add_Tick(background, _time_Tick(world, random, edits));
+    const World::Statistics statistics = world.get_Statistics();
+
+    // Blocking save: the whole save lands in one tick
+    const auto start = std::chrono::steady_clock::now();
+    World::write_Snapshot(world.take_Snapshot(), path);
+    _tick(world, random, edits);
+    const double blockingMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("world %ux%u, %zu edits per tick, save took %.1f ms\n",
+        size, size, edits, std::chrono::duration<double, std::milli>(statistics.lastSnapshotSaveTime).count()
+    );
+    std::printf("%22s %12s %12s %10s\n", "", "mean ms", "max ms", "ticks");
+    std::printf("%22s %12.3f %12.3f %10zu\n", "no save", idle.mean, idle.max, idle.ticks);
+    std::printf("%22s %12.3f %12.3f %10zu\n", "background save", background.mean, background.max, background.ticks);
+    std::printf("%22s %12.3f %12.3f %10d\n", "blocking save", blockingMs, blockingMs, 1);
+    std::printf("chunks copied on write during the background save: %llu\n", static_cast<unsigned long long>(statistics.copiedChunks - copiedBefore));
+
+    std::filesystem::remove(path);
+    exit(EXIT_SUCCESS);
+}
@@ -1,12 +1,20 @@
 #include "client_state_loading.hpp"
 
+#include <chrono>
+
 namespace example_game {
 
     void ClientState_Loading::update() noexcept {
-        _shouldExit = true;
+        // Every asset loads at once, so reading, decompressing and decoding overlap across the loader threads
+        if (_loads.empty()) {
+            for (const std::string& path : _assetPaths) _loads.push_back(_assets.load_Async(path));
+        }
+
+        while ((_loaded < _loads.size()) && (_loads[_loaded].wait_for(std::chrono::seconds(0)) == std::future_status::ready)) ++_loaded;
+        if (_loaded == _loads.size()) _shouldExit = true;
     }
 
-    void ClientState_Loading::render(std::float128_t lag) noexcept {
+    void ClientState_Loading::render(std::float32_t lag) noexcept {
         //
     }
 }
@@ -2,15 +2,28 @@
 #define EXAMPLE_CLIENT_STATE_LOADING_HPP
 
 #include <love/client/client_state.hpp>
+#include <love/common/data/assets/asset_manager.hpp>
+
+#include <future>
+#include <string>
+#include <vector>
 
 namespace example_game {
     class ClientState_Loading : public love_engine::ClientState {
         public:
-            ClientState_Loading() = default;
+            ClientState_Loading(love_engine::AssetManager& assets, const std::vector<std::string>& assetPaths)
+            : _assets(assets), _assetPaths(assetPaths) {}
             ~ClientState_Loading() = default;
             
             void update() noexcept override;
-            void render(std::float128_t lag) noexcept override;
+            void render(std::float32_t lag) noexcept override;
+            std::vector<std::string> get_Asset_Hints() const noexcept override { return _assetPaths; }
+
+        private:
+            love_engine::AssetManager& _assets;
+            std::vector<std::string> _assetPaths;
+            std::vector<std::shared_future<love_engine::AssetManager::Asset>> _loads;
+            size_t _loaded = 0;
     };
 }
 
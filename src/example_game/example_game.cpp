@@ -1,5 +1,6 @@
 #include <love/common/love_engine_instance.hpp>
 #include <love/common/data/files/logger.hpp>
+#include <love/common/system/startup_graph.hpp>
 #include <love/common/system/system_info.hpp>
 
 #include <love/client/client_instance.hpp>
@@ -7,19 +8,36 @@
 #include "client/client_states/client_state_loading.hpp"
 
 #include <cstdlib>
+#include <filesystem>
 
 using namespace love_engine;
 using namespace example_game;
 
 int main(int argc, char** argv) {
-    LoveEngineInstance::init(FileIO::get_Executable_Directory() + "../crash-reports");
     Logger logger(FileIO::get_Executable_Directory() + "../logs/latest.log", true);
-    logger.log("System Info:\n" + SystemInfo::get_Consolidated_System_Info());
 
-    ClientState_Loading loading_State;
+    std::vector<std::string> assetPaths;
+    StartupGraph startup;
+    startup.add_Step(StartupGraph::Step{.name = "log_system_info", .dependencies = {"system_info"}, .run = [&logger]() {
+        logger.log("System Info:\n" + SystemInfo::get_Consolidated_System_Info());
+    }});
+    startup.add_Step(StartupGraph::Step{.name = "asset_paths", .dependencies = {"executable_directory"}, .run = [&assetPaths]() {
+        const std::string assetDirectory = FileIO::get_Executable_Directory() + "../assets";
+        if (std::filesystem::is_directory(assetDirectory)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(assetDirectory)) {
+                if (entry.is_regular_file()) assetPaths.push_back(entry.path().string());
+            }
+        }
+    }});
+    LoveEngineInstance::init(FileIO::get_Executable_Directory() + "../crash-reports", startup, &logger);
+
+    AssetManager assets(AssetManager::Settings{});
+
+    ClientState_Loading loading_State(assets, assetPaths);
     ClientInstance client(&loading_State, ClientInstance::Settings{.msPerTick = 50.f});
+    client.set_Asset_Manager(&assets);
     client.run();
 
-    LoveEngineInstance::cleanup();
+    LoveEngineInstance::cleanup(&logger);
     exit(EXIT_SUCCESS);
 }
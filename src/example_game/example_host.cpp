@@ -1,16 +1,115 @@
 #include <love/common/love_engine_instance.hpp>
+#include <love/common/error/crash.hpp>
+#include <love/common/data/assets/asset_manager.hpp>
+#include <love/common/data/files/file_watcher.hpp>
 #include <love/common/data/files/logger.hpp>
+#include <love/common/system/metrics_server.hpp>
+#include <love/common/system/profiler.hpp>
+#include <love/common/system/startup_graph.hpp>
 #include <love/common/system/system_info.hpp>
 
+#include <love/server/server_instance.hpp>
+
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <sstream>
 
 using namespace love_engine;
 
 int main(int argc, char** argv) {
-    LoveEngineInstance::init();
     Logger logger(FileIO::get_Executable_Directory() + "../logs/latest.log", true);
-    logger.log("System Info:\n" + SystemInfo::get_Consolidated_System_Info());
 
-    LoveEngineInstance::cleanup();
+    // host [--record <file> | --replay <file>] [--profile <file>]
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* profilePath = nullptr;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0) replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--profile") == 0) profilePath = argv[++i];
+    }
+
+    // Independent of each other, so they start up alongside the engine
+    std::unique_ptr<ServerInstance> serverInstance;
+    std::unique_ptr<MetricsServer> metricsServer;
+    StartupGraph startup;
+    startup.add_Step(StartupGraph::Step{.name = "log_system_info", .dependencies = {"system_info"}, .run = [&logger]() {
+        logger.log("System Info:\n" + SystemInfo::get_Consolidated_System_Info());
+    }});
+    startup.add_Step(StartupGraph::Step{.name = "server", .run = [&serverInstance]() {
+        serverInstance = std::make_unique<ServerInstance>(ServerInstance::Settings{.msPerTick = 50.f});
+    }});
+    startup.add_Step(StartupGraph::Step{.name = "metrics_server", .dependencies = {"metrics"}, .run = [&logger, &metricsServer]() {
+        // Scrape with http://127.0.0.1:9464/metrics, or read the snapshot next to the log
+        try {
+            metricsServer = std::make_unique<MetricsServer>(MetricsServer::Settings{
+                .port = 9464,
+                .snapshotPath = FileIO::get_Executable_Directory() + "../logs/metrics.prom",
+            });
+        } catch (std::runtime_error& e) {
+            logger.log(Log_Status::WARNING, std::string("Metrics endpoint disabled. ") + e.what());
+        }
+    }});
+    LoveEngineInstance::init(FileIO::get_Executable_Directory() + "crash-reports", startup, &logger);
+    ServerInstance& server = *serverInstance;
+    server.get_Command_Queue().set_Logger(&logger);
+    // Ctrl+C and SIGTERM end the tick loop, so the exit callbacks below still run
+    Crash::set_Stop_Function([&server]() { server.stop(); });
+
+    if (replayPath != nullptr) {
+        const CommandRecorder::Replay_Result result = CommandRecorder::replay(server, replayPath);
+        std::stringstream message;
+        message << "Replayed " << result.ticks << " ticks and " << result.commands << " commands from \"" << replayPath << "\"."
+            << "\n\tTotal tick time: " << (result.totalTickTime.count() / 1000) << "us"
+            << "\n\tMean tick time: " << (result.ticks ? (result.totalTickTime.count() / result.ticks / 1000) : 0) << "us"
+            << "\n\tMax tick time: " << (result.maxTickTime.count() / 1000) << "us";
+        logger.log(message.str());
+
+        LoveEngineInstance::cleanup(&logger);
+        exit(EXIT_SUCCESS);
+    }
+
+    // Independent, so they run at the same time on exit
+    LoveEngineInstance::add_Exit_Callback(ShutdownRegistry::Callback{.name = "metrics_server", .run = [&metricsServer]() { metricsServer.reset(); }});
+    if (profilePath != nullptr) {
+        Profiler::begin_Capture();
+        LoveEngineInstance::add_Exit_Callback(ShutdownRegistry::Callback{
+            .name = "profile",
+            .run = [&logger, profilePath]() {
+                Profiler::end_Capture();
+                Profiler::write_Chrome_Trace(profilePath);
+                logger.log("Profile written to \"" + std::string(profilePath) + "\":\n" + Profiler::get_Summary());
+            },
+            // Large captures take a while to write, and a cut off trace is useless
+            .timeout = ShutdownRegistry::NO_TIMEOUT,
+        });
+    }
+
+    // Assets edited on disk are read again on their next load. Watcher paths are normalized, so asset paths are too.
+    AssetManager assets(AssetManager::Settings{});
+    FileWatcher fileWatcher(FileWatcher::Settings{});
+    const std::string assetDirectory = std::filesystem::path(FileIO::get_Executable_Directory() + "../assets").lexically_normal().generic_string();
+    fileWatcher.subscribe(assetDirectory, [&assets](const std::vector<FileWatcher::Event>& events) {
+        for (const FileWatcher::Event& event : events) assets.invalidate(event.path);
+    });
+    server.set_File_Watcher(&fileWatcher);
+
+    // Streamed to disk while the server runs, so the exit callback only writes the last frame
+    std::unique_ptr<CommandRecorder> recorder;
+    if (recordPath != nullptr) {
+        recorder = std::make_unique<CommandRecorder>(recordPath);
+        server.set_Command_Recorder(recorder.get());
+        LoveEngineInstance::add_Exit_Callback(ShutdownRegistry::Callback{
+            .name = "command_recording",
+            .run = [&recorder]() { recorder->flush(); },
+            .timeout = ShutdownRegistry::NO_TIMEOUT,
+        });
+        logger.log(std::string("Recording commands to \"") + recordPath + "\".");
+    }
+    server.run();
+
+    LoveEngineInstance::cleanup(&logger);
     exit(EXIT_SUCCESS);
 }
@@ -1,32 +1,29 @@
 #include "client_instance.hpp"
 
-#include <chrono>
+#include <love/common/system/profiler.hpp>
 
 namespace love_engine {
 
     void ClientInstance::run() noexcept {
-        auto previousTime = std::chrono::high_resolution_clock::now();
-        std::float128_t lag = 0.0f;
-        while (!_clientState->should_Exit()) {
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            std::float128_t elapsedTime = std::chrono::duration<std::float128_t, std::chrono::milliseconds::period>(currentTime - previousTime).count();
-            previousTime = currentTime;
-            lag += elapsedTime;
-
-            // Prioritize game update when behind, skip to rendering when ahead
-            while (lag >= _settings.msPerTick) {
+        if (_assets) _assets->prefetch(_clientState->get_Asset_Hints());
+        _timestep.run(
+            [this]() { return _clientState->should_Exit(); },
+            [this]() {
                 if (_nextClientState) {
                     _clientState = _nextClientState;
                     _nextClientState = nullptr;
-                    previousTime = std::chrono::high_resolution_clock::now();
+                    _timestep.reset();
+                    if (_assets) _assets->prefetch(_clientState->get_Asset_Hints());
                 }
 
+                LOVE_PROFILE_ZONE("ClientState::update");
                 _clientState->update();
-                lag -= _settings.msPerTick;
+            },
+            [this](std::float32_t lag) {
+                LOVE_PROFILE_ZONE("ClientState::render");
+                _clientState->render(lag);
             }
-
-            _clientState->render(lag / _settings.msPerTick);
-        }
+        );
     }
 
 }
@@ -3,8 +3,11 @@
 
 #include "client_state.hpp"
 
+#include <love/common/data/assets/asset_manager.hpp>
 #include <love/common/error/crash.hpp>
+#include <love/common/system/fixed_timestep.hpp>
 
+#include <chrono>
 #include <stdfloat>
 
 namespace love_engine {
@@ -13,9 +16,17 @@ namespace love_engine {
         public:
             typedef struct Settings_ {
                 std::float32_t msPerTick = 20.f;
+                // Ticks run back to back when behind before the remaining lag is dropped. Must be at least 1.
+                uint32_t maxCatchUpTicks = 5;
             } Settings;
+            // @throw std::invalid_argument If maxCatchUpTicks is 0 or msPerTick is not positive.
             ClientInstance(ClientState *const clientState, const Settings settings)
-            : _settings(settings), _clientState(clientState) {
+            : _settings(settings), _timestep(FixedTimestep::Settings{
+                .tickDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::duration<std::float32_t, std::milli>(settings.msPerTick)
+                ),
+                .maxCatchUpTicks = settings.maxCatchUpTicks,
+            }), _clientState(clientState) {
                 if (clientState == nullptr) Crash::crash("clientState must not be NULL.");
             }
             ~ClientInstance() = default;
@@ -23,11 +34,17 @@ namespace love_engine {
             void run() noexcept;
 
             inline void set_ClientState(ClientState *clientState) noexcept { _nextClientState = clientState; }
+            // Prefetches the asset hints of each state that becomes active. May be null.
+            inline void set_Asset_Manager(AssetManager *assets) noexcept { _assets = assets; }
+
+            inline const FixedTimestep::Statistics& get_Tick_Statistics() const noexcept { return _timestep.get_Statistics(); }
 
         private:
             Settings _settings;
+            FixedTimestep _timestep;
             ClientState *_clientState = nullptr;
             ClientState *_nextClientState = nullptr;
+            AssetManager *_assets = nullptr;
     };
 
 }
@@ -2,6 +2,8 @@
 #define LOVE_CLIENT_STATE_HPP
 
 #include <stdfloat>
+#include <string>
+#include <vector>
 
 namespace love_engine {
 
@@ -13,7 +15,10 @@ namespace love_engine {
             // Bullet is on left of screen on tick 1, and right on tick two, but render happens
             // at tick 1.5. Input is 0.5, meaning the bullet should render in the middle of the screen.
             // @param lag Percentage of the way to next tick; "ms since last tick"/"ms per tick"
-            virtual void render(std::float128_t lag) noexcept = 0;
+            virtual void render(std::float32_t lag) noexcept = 0;
+            // Assets this state expects to need soon, such as those of the state after it.
+            // They are prefetched when the state becomes active.
+            virtual std::vector<std::string> get_Asset_Hints() const noexcept { return {}; }
             // Exits ClientInstance if true.
             bool should_Exit() const noexcept { return _shouldExit; }
 
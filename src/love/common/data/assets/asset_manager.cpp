@@ -0,0 +1,323 @@
+#include "asset_manager.hpp"
+
+#include "../files/file_compression.hpp"
+#include "../files/file_io.hpp"
+#include "../../system/async.hpp"
+
+#include <filesystem>
+
+#include <lzma.h>
+
+namespace love_engine {
+    static const std::string _COMPRESSED_EXTENSION = ".xz";
+
+    static bool _is_Compressed(const std::string& filePath) noexcept {
+        return filePath.ends_with(_COMPRESSED_EXTENSION);
+    }
+
+    // Extension that selects the decoder, ignoring the compressed extension
+    static std::string _get_Decoder_Extension(const std::string& filePath) noexcept {
+        const std::string path = _is_Compressed(filePath) ? filePath.substr(0, filePath.length() - _COMPRESSED_EXTENSION.length()) : filePath;
+        return std::filesystem::path(path).extension().string();
+    }
+
+    AssetManager::Content_Hash AssetManager::hash_Content(const uint8_t*const data, const size_t size) noexcept {
+        return lzma_crc64(data, size, 0);
+    }
+
+    void AssetManager::set_Decoder(const std::string& extension, const Decoder& decoder) noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _decoders[extension] = decoder;
+    }
+
+    void AssetManager::add_Archive(const std::shared_ptr<const PackArchive>& archive) noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _archives.insert(_archives.begin(), archive);
+    }
+
+    AssetManager::Asset AssetManager::_find_Cached(const std::string& filePath) noexcept {
+        const auto key = _pathKeys.find(filePath);
+        if (key == _pathKeys.end()) return Asset{};
+        const auto entry = _assets.find(key->second);
+        if (entry == _assets.end()) return Asset{};
+
+        _lru.splice(_lru.begin(), _lru, entry->second.lruPosition);
+        return entry->second.asset;
+    }
+
+    std::unordered_map<AssetManager::Asset_Key, AssetManager::Entry, AssetManager::Asset_Key_Hasher>::iterator AssetManager::_find_Content(
+        Asset_Key& key, const std::vector<uint8_t>& content
+    ) noexcept {
+        // An evicted slot ends the search early, which at worst caches the same contents twice
+        for (;; ++key.slot) {
+            const auto entry = _assets.find(key);
+            if (entry == _assets.end()) return entry;
+            if (*entry->second.content == content) return entry;
+            ++_statistics.hashCollisions;
+        }
+    }
+
+    AssetManager::Asset AssetManager::_insert(Asset_Key& key, const Asset& asset, const std::shared_ptr<const std::vector<uint8_t>>& content) noexcept {
+        const auto existing = _find_Content(key, *content);
+        if (existing != _assets.end()) {
+            _lru.splice(_lru.begin(), _lru, existing->second.lruPosition);
+            return existing->second.asset;
+        }
+
+        // Without a decoder the asset is the content itself
+        const size_t size = asset.size + ((asset.data == content) ? 0 : content->size());
+        _lru.push_front(key);
+        _assets.emplace(key, Entry{.asset = asset, .content = content, .size = size, .lruPosition = _lru.begin()});
+        _residentBytes += size;
+        _evict();
+        return asset;
+    }
+
+    void AssetManager::_evict() noexcept {
+        auto position = _lru.end();
+        while ((_residentBytes > _settings.memoryBudget) && (position != _lru.begin())) {
+            --position;
+            const auto entry = _assets.find(*position);
+            // Held by a caller, so evicting would only cause a duplicate load. Without a decoder the entry's
+            // contents are a second owner.
+            const long owners = (entry->second.asset.data == entry->second.content) ? 2 : 1;
+            if (entry->second.asset.data.use_count() > owners) continue;
+
+            _residentBytes -= entry->second.size;
+            for (const std::string& path : entry->second.paths) _pathKeys.erase(path);
+            _assets.erase(entry);
+            position = _lru.erase(position);
+            ++_statistics.evictions;
+        }
+    }
+
+    void AssetManager::_link_Path(const std::string& filePath, const Asset_Key& key) noexcept {
+        _unlink_Path(filePath);
+        const auto entry = _assets.find(key);
+        if (entry == _assets.end()) return;
+        _pathKeys.emplace(filePath, key);
+        entry->second.paths.push_back(filePath);
+    }
+
+    void AssetManager::_unlink_Path(const std::string& filePath) noexcept {
+        const auto key = _pathKeys.find(filePath);
+        if (key == _pathKeys.end()) return;
+        const auto entry = _assets.find(key->second);
+        if (entry != _assets.end()) std::erase(entry->second.paths, filePath);
+        _pathKeys.erase(key);
+    }
+
+    std::vector<std::coroutine_handle<>> AssetManager::_finish_Load(const std::string& filePath) noexcept {
+        _loading.erase(filePath);
+        const auto waiters = _loadWaiters.find(filePath);
+        if (waiters == _loadWaiters.end()) return {};
+        std::vector<std::coroutine_handle<>> handles = std::move(waiters->second);
+        _loadWaiters.erase(waiters);
+        return handles;
+    }
+
+    void AssetManager::_resume(const std::vector<std::coroutine_handle<>>& waiters) noexcept {
+        for (const std::coroutine_handle<> waiter : waiters) _loaders.submit([waiter]() { waiter.resume(); });
+    }
+
+    void AssetManager::_run_Load(const std::string& filePath, std::promise<Asset>& promise) noexcept {
+        std::vector<std::coroutine_handle<>> waiters;
+        try {
+            std::shared_ptr<const PackArchive> archive;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (const auto& candidate : _archives) {
+                    if (!candidate->contains(filePath)) continue;
+                    archive = candidate;
+                    break;
+                }
+            }
+
+            std::shared_ptr<std::vector<uint8_t>> content = std::make_shared<std::vector<uint8_t>>();
+            if (archive) *content = archive->read(filePath);
+            else {
+                const FileIO::FileContent file = _is_Compressed(filePath)
+                    ? FileCompression::decompress_File_Raw(filePath.c_str())
+                    : FileIO::read_File_Content(filePath);
+                content->assign(file.data(), file.data() + file.size());
+            }
+            Asset_Key key{.hash = hash_Content(content->data(), content->size()), .extension = _get_Decoder_Extension(filePath)};
+
+            Decoder decoder;
+            bool shared = false;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                const auto entry = _find_Content(key, *content);
+                if (entry != _assets.end()) {
+                    // Same contents and decoder as an asset loaded from another path
+                    ++_statistics.contentHits;
+                    _lru.splice(_lru.begin(), _lru, entry->second.lruPosition);
+                    if (!_loading.at(filePath).invalidated) _link_Path(filePath, key);
+                    promise.set_value(entry->second.asset);
+                    waiters = _finish_Load(filePath);
+                    shared = true;
+                } else {
+                    const auto found = _decoders.find(key.extension);
+                    if (found != _decoders.end()) decoder = found->second;
+                }
+            }
+
+            if (!shared) {
+                // The decoder consumes a copy, so the contents stay around to confirm later hash matches
+                Asset asset{.hash = key.hash, .data = nullptr, .size = content->size()};
+                if (decoder) asset.data = decoder(std::vector<uint8_t>(*content), asset.size);
+                else asset.data = content;
+
+                std::lock_guard<std::mutex> lock(_mutex);
+                asset = _insert(key, asset, content);
+                if (!_loading.at(filePath).invalidated) _link_Path(filePath, key);
+                promise.set_value(asset);
+                waiters = _finish_Load(filePath);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            promise.set_exception(std::current_exception());
+            waiters = _finish_Load(filePath);
+        }
+        _resume(waiters);
+    }
+
+    AssetManager::Asset AssetManager::load(const std::string& filePath) {
+        std::promise<Asset> promise;
+        std::shared_future<Asset> future;
+        bool owner = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const Asset cached = _find_Cached(filePath);
+            if (cached.data) {
+                ++_statistics.hits;
+                return cached;
+            }
+
+            const auto loading = _loading.find(filePath);
+            if (loading != _loading.end()) {
+                ++_statistics.sharedLoads;
+                future = loading->second.future;
+            } else {
+                ++_statistics.misses;
+                future = promise.get_future().share();
+                _loading.emplace(filePath, Load{.future = future});
+                owner = true;
+            }
+        }
+
+        // Nobody else is loading it, so load here rather than wait for a loader thread
+        if (owner) _run_Load(filePath, promise);
+        return future.get();
+    }
+
+    std::shared_future<AssetManager::Asset> AssetManager::load_Async(const std::string& filePath) noexcept {
+        auto promise = std::make_shared<std::promise<Asset>>();
+        std::shared_future<Asset> future;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const Asset cached = _find_Cached(filePath);
+            if (cached.data) {
+                ++_statistics.hits;
+                promise->set_value(cached);
+                return promise->get_future().share();
+            }
+
+            const auto loading = _loading.find(filePath);
+            if (loading != _loading.end()) {
+                ++_statistics.sharedLoads;
+                return loading->second.future;
+            }
+
+            ++_statistics.misses;
+            future = promise->get_future().share();
+            _loading.emplace(filePath, Load{.future = future});
+        }
+
+        _loaders.submit([this, filePath, promise]() { _run_Load(filePath, *promise); });
+        return future;
+    }
+
+    Task<AssetManager::Asset> AssetManager::load_Task(std::string filePath) {
+        // Resumed by _run_Load() once the load it waits for finished
+        struct Load_Awaiter {
+            AssetManager& manager;
+            const std::string& filePath;
+            const std::shared_future<Asset>& future;
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle) noexcept {
+                std::lock_guard<std::mutex> lock(manager._mutex);
+                // Futures are set under the mutex, so a finished load cannot be missed
+                if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) return false;
+                manager._loadWaiters[filePath].push_back(handle);
+                return true;
+            }
+            void await_resume() const noexcept {}
+        };
+
+        std::promise<Asset> promise;
+        std::shared_future<Asset> future;
+        bool owner = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const Asset cached = _find_Cached(filePath);
+            if (cached.data) {
+                ++_statistics.hits;
+                co_return cached;
+            }
+
+            const auto loading = _loading.find(filePath);
+            if (loading != _loading.end()) {
+                ++_statistics.sharedLoads;
+                future = loading->second.future;
+            } else {
+                ++_statistics.misses;
+                future = promise.get_future().share();
+                _loading.emplace(filePath, Load{.future = future});
+                owner = true;
+            }
+        }
+
+        // Loader threads never block on each other's loads, so the pool cannot run out of threads that make progress
+        if (owner) {
+            co_await Async::resume_On(_loaders);
+            _run_Load(filePath, promise);
+        } else co_await Load_Awaiter{*this, filePath, future};
+        co_return future.get();
+    }
+
+    void AssetManager::prefetch(const std::vector<std::string>& filePaths) noexcept {
+        for (const std::string& filePath : filePaths) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_pathKeys.contains(filePath)) continue;
+                if (_loading.contains(filePath)) continue;
+                ++_statistics.prefetches;
+            }
+            load_Async(filePath);
+        }
+    }
+
+    bool AssetManager::is_Cached(const std::string& filePath) const noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto key = _pathKeys.find(filePath);
+        return (key != _pathKeys.end()) && _assets.contains(key->second);
+    }
+
+    void AssetManager::invalidate(const std::string& filePath) noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _unlink_Path(filePath);
+        // The running load may have read the file before it changed
+        const auto loading = _loading.find(filePath);
+        if (loading != _loading.end()) loading->second.invalidated = true;
+    }
+
+    AssetManager::Statistics AssetManager::get_Statistics() const noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Statistics statistics = _statistics;
+        statistics.residentAssets = _assets.size();
+        statistics.residentBytes = _residentBytes;
+        return statistics;
+    }
+}
@@ -0,0 +1,169 @@
+#ifndef LOVE_ASSET_MANAGER_HPP
+#define LOVE_ASSET_MANAGER_HPP
+
+#include "../files/pack_archive.hpp"
+#include "../../system/task.hpp"
+#include "../../system/thread_pool.hpp"
+
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace love_engine {
+    // Loads and decodes assets on background threads and caches them by contents and decoder, so files with
+    // identical contents and extension share one decoded asset. Concurrent requests for the same file share one load.
+    // Decoded assets are kept in a least recently used cache under a memory budget. Assets still held by a
+    // caller are never evicted.
+    // Files ending in ".xz" are decompressed with FileCompression first; the extension before it picks the decoder.
+    // Paths found in an added pack archive are read from it instead of the file system.
+    // Thread-safe.
+    class AssetManager {
+        public:
+            typedef uint64_t Content_Hash;
+
+            typedef struct Asset_ {
+                Content_Hash hash = 0;
+                std::shared_ptr<const void> data;
+                // Bytes counted against the memory budget
+                size_t size = 0;
+
+                // @param T Type produced by the asset's decoder.
+                template<class T>
+                std::shared_ptr<const T> get() const noexcept { return std::static_pointer_cast<const T>(data); }
+            } Asset;
+
+            // Turns file contents into a decoded asset. Runs on loader threads and must not load other assets.
+            // @param size Set to the decoded asset's memory use.
+            typedef std::function<std::shared_ptr<const void>(std::vector<uint8_t>&& content, size_t& size)> Decoder;
+
+            typedef struct Settings_ {
+                size_t memoryBudget = 256 * 1024 * 1024;
+                size_t loaderThreads = std::thread::hardware_concurrency();
+            } Settings;
+
+            typedef struct Statistics_ {
+                uint64_t hits = 0;
+                uint64_t misses = 0;
+                // Misses whose contents were already cached under another path with the same decoder
+                uint64_t contentHits = 0;
+                // Loads whose content hash matched a cached asset with different contents
+                uint64_t hashCollisions = 0;
+                // Requests that joined a load already running
+                uint64_t sharedLoads = 0;
+                uint64_t prefetches = 0;
+                uint64_t evictions = 0;
+                size_t residentAssets = 0;
+                size_t residentBytes = 0;
+            } Statistics;
+
+            AssetManager(const Settings settings) : _settings(settings), _loaders("ASSET_LOADER", std::max<size_t>(settings.loaderThreads, 1)) {}
+            AssetManager(AssetManager const&) = delete;
+            void operator=(AssetManager const&) = delete;
+            ~AssetManager() = default;
+
+            // Without a decoder, assets are their file contents as a std::vector<uint8_t>.
+            // @param extension Including the dot, e.g. ".png".
+            void set_Decoder(const std::string& extension, const Decoder& decoder) noexcept;
+            // Archives added later take precedence.
+            void add_Archive(const std::shared_ptr<const PackArchive>& archive) noexcept;
+
+            // Loads on the calling thread unless the asset is cached or already loading.
+            // @throw std::runtime_error If a file error occurs or the decoder throws.
+            Asset load(const std::string& filePath);
+            // The future throws std::runtime_error from get() if the load fails.
+            std::shared_future<Asset> load_Async(const std::string& filePath) noexcept;
+            // For coroutines: loads on a loader thread, and the awaiting coroutine continues there. A load already
+            // running is awaited without holding a thread. Cached assets are returned on the calling thread.
+            // @throw std::runtime_error If a file error occurs or the decoder throws.
+            Task<Asset> load_Task(std::string filePath);
+            // Loads assets that will be needed soon in the background. Cached and loading assets are skipped.
+            void prefetch(const std::vector<std::string>& filePaths) noexcept;
+
+            bool is_Cached(const std::string& filePath) const noexcept;
+            // Forgets which contents @p filePath had, so the next load reads the file again. A load already running
+            // still completes, but its result is not cached for @p filePath.
+            void invalidate(const std::string& filePath) noexcept;
+
+            Statistics get_Statistics() const noexcept;
+
+            static Content_Hash hash_Content(const uint8_t*const data, const size_t size) noexcept;
+
+        private:
+            // Content hashes can collide, so assets with the same hash and extension but different contents are told
+            // apart by @p slot.
+            typedef struct Asset_Key_ {
+                Content_Hash hash = 0;
+                // Extension that picked the decoder
+                std::string extension;
+                uint32_t slot = 0;
+                bool operator==(const Asset_Key_&) const = default;
+            } Asset_Key;
+            struct Asset_Key_Hasher {
+                size_t operator()(const Asset_Key& key) const noexcept {
+                    return key.hash ^ std::hash<std::string>()(key.extension) ^ key.slot;
+                }
+            };
+            typedef struct Entry_ {
+                Asset asset;
+                // File contents the asset was decoded from, to confirm content hash matches
+                std::shared_ptr<const std::vector<uint8_t>> content;
+                // Bytes counted against the memory budget
+                size_t size = 0;
+                std::list<Asset_Key>::iterator lruPosition;
+                // Paths in _pathKeys that point here, dropped with the entry
+                std::vector<std::string> paths;
+            } Entry;
+
+            typedef struct Load_ {
+                std::shared_future<Asset> future;
+                // Set by invalidate() while the load runs, so its possibly stale result is not cached for the path
+                bool invalidated = false;
+            } Load;
+
+            // Requires _mutex. @return The cached asset, or one with null data.
+            Asset _find_Cached(const std::string& filePath) noexcept;
+            // Requires _mutex. Moves @p key's slot, starting from its current one, to the asset decoded from
+            // @p content, or to the first free slot. Each occupied slot passed counts as a hash collision.
+            // @return The cached asset, or _assets.end().
+            std::unordered_map<Asset_Key, Entry, Asset_Key_Hasher>::iterator _find_Content(Asset_Key& key, const std::vector<uint8_t>& content) noexcept;
+            // Requires _mutex. @return @p asset, or the equal asset cached first.
+            Asset _insert(Asset_Key& key, const Asset& asset, const std::shared_ptr<const std::vector<uint8_t>>& content) noexcept;
+            // Requires _mutex.
+            void _evict() noexcept;
+            // Requires _mutex. Points @p filePath at @p key's cached asset.
+            void _link_Path(const std::string& filePath, const Asset_Key& key) noexcept;
+            // Requires _mutex.
+            void _unlink_Path(const std::string& filePath) noexcept;
+            void _run_Load(const std::string& filePath, std::promise<Asset>& promise) noexcept;
+            // Requires _mutex. Call once the load of @p filePath finished, then _resume() what it returns.
+            std::vector<std::coroutine_handle<>> _finish_Load(const std::string& filePath) noexcept;
+            void _resume(const std::vector<std::coroutine_handle<>>& waiters) noexcept;
+
+            Settings _settings;
+
+            mutable std::mutex _mutex;
+            std::unordered_map<std::string, Decoder> _decoders;
+            std::vector<std::shared_ptr<const PackArchive>> _archives;
+            std::unordered_map<std::string, Asset_Key> _pathKeys;
+            std::unordered_map<Asset_Key, Entry, Asset_Key_Hasher> _assets;
+            // Most recently used first
+            std::list<Asset_Key> _lru;
+            std::unordered_map<std::string, Load> _loading;
+            // Coroutines from load_Task() waiting for a load that another caller started
+            std::unordered_map<std::string, std::vector<std::coroutine_handle<>>> _loadWaiters;
+            size_t _residentBytes = 0;
+            Statistics _statistics;
+
+            // Last member, so loads finish before the cache is destroyed
+            ThreadPool _loaders;
+    };
+}
+
+#endif // LOVE_ASSET_MANAGER_HPP
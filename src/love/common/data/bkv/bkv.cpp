@@ -0,0 +1,121 @@
+#include "bkv.hpp"
+
+#include "../../error/stack_trace.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace love_engine {
+    // Calls @p f(type, key, keyLength, payload, payloadSize) for every well-formed top-level entry until it returns true.
+    template<class F>
+    void _for_Each_Entry(const std::vector<uint8_t>& data, F&& f) noexcept {
+        size_t head = 0;
+        while (head + 2 <= data.size()) {
+            const BKV::BKV_Type type = static_cast<BKV::BKV_Type>(data[head]);
+            const size_t keyLength = data[head + 1];
+            const size_t payloadHead = head + 2 + keyLength;
+            if (payloadHead > data.size()) return;
+
+            const size_t payloadSize = BKV::get_Payload_Size(type, data.data() + payloadHead, data.size() - payloadHead);
+            if (payloadSize == 0) return;
+
+            if (f(type, reinterpret_cast<const char*>(data.data() + head + 2), keyLength, data.data() + payloadHead, payloadSize)) return;
+            head = payloadHead + payloadSize;
+        }
+    }
+
+    size_t BKV::get_Payload_Size(const BKV_Type type, const uint8_t*const payload, const size_t available) noexcept {
+        size_t size = 0;
+        switch (type) {
+            case BKV_Type::I8: size = 1; break;
+            case BKV_Type::I16: size = 2; break;
+            case BKV_Type::I32: case BKV_Type::F32: size = 4; break;
+            case BKV_Type::I64: case BKV_Type::F64: size = 8; break;
+            case BKV_Type::STRING: case BKV_Type::BYTES: case BKV_Type::COMPOUND: {
+                if (available < sizeof(uint32_t)) return 0;
+                uint32_t length;
+                std::memcpy(&length, payload, sizeof(length));
+                size = sizeof(length) + length;
+                break;
+            }
+            default: return 0;
+        }
+        return (size <= available) ? size : 0;
+    }
+
+    bool BKV::contains(const std::string& key) const noexcept {
+        bool found = false;
+        _for_Each_Entry(_data, [&](BKV_Type, const char* entryKey, size_t keyLength, const uint8_t*, size_t) {
+            found = (keyLength == key.length()) && (std::memcmp(entryKey, key.data(), keyLength) == 0);
+            return found;
+        });
+        return found;
+    }
+
+    std::vector<std::string> BKV::get_Keys() const noexcept {
+        std::vector<std::string> keys;
+        _for_Each_Entry(_data, [&](BKV_Type, const char* entryKey, size_t keyLength, const uint8_t*, size_t) {
+            keys.emplace_back(entryKey, keyLength);
+            return false;
+        });
+        return keys;
+    }
+
+    const uint8_t* BKV::_find(const std::string& key, const BKV_Type type) const {
+        const uint8_t* payload = nullptr;
+        BKV_Type foundType = type;
+        _for_Each_Entry(_data, [&](BKV_Type entryType, const char* entryKey, size_t keyLength, const uint8_t* entryPayload, size_t) {
+            if ((keyLength != key.length()) || (std::memcmp(entryKey, key.data(), keyLength) != 0)) return false;
+            payload = entryPayload;
+            foundType = entryType;
+            return true;
+        });
+
+        if (payload == nullptr) {
+            std::stringstream error;
+            error << "BKV does not contain key \"" << key << "\".";
+            throw std::invalid_argument(StackTrace::append_Stacktrace(error));
+        }
+        if (foundType != type) {
+            std::stringstream error;
+            error << "BKV key \"" << key << "\" has type " << static_cast<int>(foundType) << ", expected " << static_cast<int>(type) << ".";
+            throw std::invalid_argument(StackTrace::append_Stacktrace(error));
+        }
+        return payload;
+    }
+
+    template<class T>
+    T BKV::_get_Value(const std::string& key, const BKV_Type type) const {
+        T value;
+        std::memcpy(&value, _find(key, type), sizeof(T));
+        return value;
+    }
+    template int8_t BKV::_get_Value<int8_t>(const std::string&, const BKV_Type) const;
+    template int16_t BKV::_get_Value<int16_t>(const std::string&, const BKV_Type) const;
+    template int32_t BKV::_get_Value<int32_t>(const std::string&, const BKV_Type) const;
+    template int64_t BKV::_get_Value<int64_t>(const std::string&, const BKV_Type) const;
+    template float BKV::_get_Value<float>(const std::string&, const BKV_Type) const;
+    template double BKV::_get_Value<double>(const std::string&, const BKV_Type) const;
+
+    std::string BKV::get_String(const std::string& key) const {
+        const uint8_t* payload = _find(key, BKV_Type::STRING);
+        uint32_t length;
+        std::memcpy(&length, payload, sizeof(length));
+        return std::string(reinterpret_cast<const char*>(payload + sizeof(length)), length);
+    }
+
+    std::vector<uint8_t> BKV::get_Bytes(const std::string& key) const {
+        const uint8_t* payload = _find(key, BKV_Type::BYTES);
+        uint32_t length;
+        std::memcpy(&length, payload, sizeof(length));
+        return std::vector<uint8_t>(payload + sizeof(length), payload + sizeof(length) + length);
+    }
+
+    BKV BKV::get_Compound(const std::string& key) const {
+        const uint8_t* payload = _find(key, BKV_Type::COMPOUND);
+        uint32_t length;
+        std::memcpy(&length, payload, sizeof(length));
+        return BKV(payload + sizeof(length), length);
+    }
+}
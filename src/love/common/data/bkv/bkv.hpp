@@ -0,0 +1,70 @@
+#ifndef LOVE_BKV_HPP
+#define LOVE_BKV_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    // Binary key-value record.
+    // Each entry is [type: u8][key length: u8][key][payload]. Numbers are stored in host byte order;
+    // strings, byte arrays and compounds are prefixed with their u32 size.
+    class BKV {
+        public:
+            enum class BKV_Type : uint8_t {
+                I8 = 1,
+                I16,
+                I32,
+                I64,
+                F32,
+                F64,
+                STRING,
+                BYTES,
+                COMPOUND,
+            };
+
+            BKV() = default;
+            BKV(std::vector<uint8_t> data) : _data(std::move(data)) {}
+            BKV(const uint8_t*const data, const size_t size) : _data(data, data + size) {}
+            ~BKV() = default;
+
+            const uint8_t* data() const noexcept { return _data.data(); }
+            size_t size() const noexcept { return _data.size(); }
+            bool empty() const noexcept { return _data.empty(); }
+
+            bool contains(const std::string& key) const noexcept;
+            std::vector<std::string> get_Keys() const noexcept;
+
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            int8_t get_I8(const std::string& key) const { return _get_Value<int8_t>(key, BKV_Type::I8); }
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            int16_t get_I16(const std::string& key) const { return _get_Value<int16_t>(key, BKV_Type::I16); }
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            int32_t get_I32(const std::string& key) const { return _get_Value<int32_t>(key, BKV_Type::I32); }
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            int64_t get_I64(const std::string& key) const { return _get_Value<int64_t>(key, BKV_Type::I64); }
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            float get_F32(const std::string& key) const { return _get_Value<float>(key, BKV_Type::F32); }
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            double get_F64(const std::string& key) const { return _get_Value<double>(key, BKV_Type::F64); }
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            std::string get_String(const std::string& key) const;
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            std::vector<uint8_t> get_Bytes(const std::string& key) const;
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            BKV get_Compound(const std::string& key) const;
+
+            // @return Size of the payload starting at @p payload, or 0 if it is truncated.
+            static size_t get_Payload_Size(const BKV_Type type, const uint8_t*const payload, const size_t available) noexcept;
+
+        private:
+            template<class T>
+            T _get_Value(const std::string& key, const BKV_Type type) const;
+            // @throw std::invalid_argument If @p key is missing or holds a different type.
+            const uint8_t* _find(const std::string& key, const BKV_Type type) const;
+
+            std::vector<uint8_t> _data;
+    };
+}
+
+#endif // LOVE_BKV_HPP
@@ -0,0 +1,67 @@
+#include "bkv_builder.hpp"
+
+#include "../../error/stack_trace.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace love_engine {
+    void BKV_Builder::_add_Key(const std::string& key, const BKV::BKV_Type type) {
+        if (key.length() > UINT8_MAX) {
+            std::stringstream error;
+            error << "BKV key \"" << key << "\" is longer than " << UINT8_MAX << " characters.";
+            throw std::length_error(StackTrace::append_Stacktrace(error));
+        }
+        _data.push_back(static_cast<uint8_t>(type));
+        _data.push_back(static_cast<uint8_t>(key.length()));
+        _data.insert(_data.end(), key.begin(), key.end());
+    }
+
+    template<class T>
+    BKV_Builder& BKV_Builder::_add_Value(const std::string& key, const BKV::BKV_Type type, const T value) {
+        _add_Key(key, type);
+        const size_t head = _data.size();
+        _data.resize(head + sizeof(T));
+        std::memcpy(_data.data() + head, &value, sizeof(T));
+        return *this;
+    }
+    template BKV_Builder& BKV_Builder::_add_Value<int8_t>(const std::string&, const BKV::BKV_Type, const int8_t);
+    template BKV_Builder& BKV_Builder::_add_Value<int16_t>(const std::string&, const BKV::BKV_Type, const int16_t);
+    template BKV_Builder& BKV_Builder::_add_Value<int32_t>(const std::string&, const BKV::BKV_Type, const int32_t);
+    template BKV_Builder& BKV_Builder::_add_Value<int64_t>(const std::string&, const BKV::BKV_Type, const int64_t);
+    template BKV_Builder& BKV_Builder::_add_Value<float>(const std::string&, const BKV::BKV_Type, const float);
+    template BKV_Builder& BKV_Builder::_add_Value<double>(const std::string&, const BKV::BKV_Type, const double);
+
+    BKV_Builder& BKV_Builder::_add_Sized(const std::string& key, const BKV::BKV_Type type, const uint8_t*const data, const size_t size) {
+        _add_Key(key, type);
+        const uint32_t length = static_cast<uint32_t>(size);
+        const size_t head = _data.size();
+        _data.resize(head + sizeof(length) + size);
+        std::memcpy(_data.data() + head, &length, sizeof(length));
+        if (size > 0) std::memcpy(_data.data() + head + sizeof(length), data, size);
+        return *this;
+    }
+
+    BKV_Builder& BKV_Builder::open_Compound(const std::string& key) {
+        _add_Key(key, BKV::BKV_Type::COMPOUND);
+        _openCompounds.push_back(_data.size());
+        _data.resize(_data.size() + sizeof(uint32_t)); // Filled in by close_Compound()
+        return *this;
+    }
+
+    BKV_Builder& BKV_Builder::close_Compound() {
+        if (_openCompounds.empty()) throw std::logic_error(StackTrace::append_Stacktrace("No BKV compound is open."));
+
+        const size_t sizeHead = _openCompounds.back();
+        _openCompounds.pop_back();
+        const uint32_t length = static_cast<uint32_t>(_data.size() - sizeHead - sizeof(uint32_t));
+        std::memcpy(_data.data() + sizeHead, &length, sizeof(length));
+        return *this;
+    }
+
+    BKV BKV_Builder::build() const {
+        if (!_openCompounds.empty()) throw std::logic_error(StackTrace::append_Stacktrace("A BKV compound is still open."));
+        return BKV(_data);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef LOVE_BKV_BUILDER_HPP
+#define LOVE_BKV_BUILDER_HPP
+
+#include "bkv.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    class BKV_Builder {
+        public:
+            BKV_Builder() = default;
+            ~BKV_Builder() = default;
+
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_I8(const std::string& key, const int8_t value) { return _add_Value(key, BKV::BKV_Type::I8, value); }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_I16(const std::string& key, const int16_t value) { return _add_Value(key, BKV::BKV_Type::I16, value); }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_I32(const std::string& key, const int32_t value) { return _add_Value(key, BKV::BKV_Type::I32, value); }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_I64(const std::string& key, const int64_t value) { return _add_Value(key, BKV::BKV_Type::I64, value); }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_F32(const std::string& key, const float value) { return _add_Value(key, BKV::BKV_Type::F32, value); }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_F64(const std::string& key, const double value) { return _add_Value(key, BKV::BKV_Type::F64, value); }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_String(const std::string& key, const std::string& value) {
+                return _add_Sized(key, BKV::BKV_Type::STRING, reinterpret_cast<const uint8_t*>(value.data()), value.length());
+            }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_Bytes(const std::string& key, const uint8_t*const data, const size_t size) {
+                return _add_Sized(key, BKV::BKV_Type::BYTES, data, size);
+            }
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& add_Compound(const std::string& key, const BKV& compound) {
+                return _add_Sized(key, BKV::BKV_Type::COMPOUND, compound.data(), compound.size());
+            }
+
+            // Entries added until the matching close_Compound() go into a compound named @p key.
+            // @throw std::length_error If @p key is longer than 255 characters.
+            BKV_Builder& open_Compound(const std::string& key);
+            // @throw std::logic_error If no compound is open.
+            BKV_Builder& close_Compound();
+
+            // @throw std::logic_error If a compound is still open.
+            BKV build() const;
+            void clear() noexcept { _data.clear(); _openCompounds.clear(); }
+
+        private:
+            void _add_Key(const std::string& key, const BKV::BKV_Type type);
+            template<class T>
+            BKV_Builder& _add_Value(const std::string& key, const BKV::BKV_Type type, const T value);
+            BKV_Builder& _add_Sized(const std::string& key, const BKV::BKV_Type type, const uint8_t*const data, const size_t size);
+
+            std::vector<uint8_t> _data;
+            // Offsets of the size fields of open compounds
+            std::vector<size_t> _openCompounds;
+    };
+}
+
+#endif // LOVE_BKV_BUILDER_HPP
@@ -1,6 +1,8 @@
 #include "file_compression.hpp"
 
 #include "../../error/stack_trace.hpp"
+#include "../../system/metrics.hpp"
+#include "../../system/profiler.hpp"
 
 #include <cerrno>
 #include <cstdio>
@@ -96,93 +98,128 @@ namespace love_engine {
         }
     }
     
+    // Throughput is the rate of bytes over the rate of the histogram sum on the scraper's side
+    static void _record_Compression(const uint64_t inputBytes, const uint64_t outputBytes, const uint64_t startTime) noexcept {
+        static Metrics::Counter& input = Metrics::get_Counter("love_compression_input_bytes_total", "Uncompressed bytes compressed");
+        static Metrics::Counter& output = Metrics::get_Counter("love_compression_output_bytes_total", "Compressed bytes produced");
+        static Metrics::Histogram& time = Metrics::get_Histogram("love_compression_nanoseconds", "Time per compression", "nanoseconds");
+        input.add(inputBytes);
+        output.add(outputBytes);
+        time.record(Profiler::get_Time() - startTime);
+    }
+
+    static void _record_Decompression(const uint64_t inputBytes, const uint64_t outputBytes, const uint64_t startTime) noexcept {
+        static Metrics::Counter& input = Metrics::get_Counter("love_decompression_input_bytes_total", "Compressed bytes decompressed");
+        static Metrics::Counter& output = Metrics::get_Counter("love_decompression_output_bytes_total", "Uncompressed bytes produced");
+        static Metrics::Histogram& time = Metrics::get_Histogram("love_decompression_nanoseconds", "Time per decompression", "nanoseconds");
+        input.add(inputBytes);
+        output.add(outputBytes);
+        time.record(Profiler::get_Time() - startTime);
+    }
+
     void FileCompression::compress_File(const char*const filePath, const uint8_t*const data, const size_t size) {
+        LOVE_PROFILE_ZONE("FileCompression::compress_File");
+        const uint64_t startTime = Profiler::get_Time();
         lzma_stream stream = LZMA_STREAM_INIT;
         _initEncoder(&stream, filePath);
 	    lzma_action action = LZMA_RUN;
 
-        // Open file
-        std::lock_guard<std::mutex>(FileIO::get_Mutex());
-        FILE* file = std::fopen(filePath, "wb");
-        if (!file) {
-            std::stringstream error;
-            error << "Error opening file: " << filePath;
-            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        // Open file. Writes go to a temporary file that replaces the old one once complete.
+        std::string tempPath;
+        FILE* file = nullptr;
+        try {
+            file = FileIO::open_Temp_File(filePath, tempPath);
+        } catch (std::runtime_error& e) {
+            lzma_end(&stream);
+            throw e;
         }
 
-        size_t head = 0, charsWritten = 0;
-        uint8_t buf[BUFSIZ];
-        
-        stream.next_in = nullptr;
-        stream.avail_in = 0;
-        stream.next_out = buf;
-        stream.avail_out = sizeof(buf);
-
-        // Compress and write
-        while (true) {
-            // Fill the input buffer if it is empty.
-            if (stream.avail_in == 0 && head < size) {
-                charsWritten = std::min(sizeof(buf), size - head);
-                stream.next_in = data + head;
-                stream.avail_in = charsWritten;
-                head += charsWritten;
-
-                if (head >= size) action = LZMA_FINISH;
-            }
-
-            // Compress
-		    lzma_ret ret = lzma_code(&stream, action);
-            
-            if (stream.avail_out == 0 || ret == LZMA_STREAM_END) {
-                // When lzma_code() has returned LZMA_STREAM_END, the output buffer is likely to be only
-                // partially full. Calculate how much new data there is to be written to the output file.
-                charsWritten = sizeof(buf) - stream.avail_out;
-
-                if (std::fwrite(buf, 1, charsWritten, file) != charsWritten) {
-                    std::stringstream error;
-                    error << "Could not write to file \"" << filePath << "\": " << std::strerror(errno);
-                    throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        try {
+            size_t head = 0, charsWritten = 0;
+            uint8_t buf[BUFSIZ];
+
+            stream.next_in = nullptr;
+            stream.avail_in = 0;
+            stream.next_out = buf;
+            stream.avail_out = sizeof(buf);
+
+            // Compress and write
+            while (true) {
+                // Fill the input buffer if it is empty.
+                if (stream.avail_in == 0 && head < size) {
+                    charsWritten = std::min(sizeof(buf), size - head);
+                    stream.next_in = data + head;
+                    stream.avail_in = charsWritten;
+                    head += charsWritten;
+
+                    if (head >= size) action = LZMA_FINISH;
                 }
 
-                // Reset next_out and avail_out.
-                stream.next_out = buf;
-                stream.avail_out = sizeof(buf);
-            }
+                // Compress
+                lzma_ret ret = lzma_code(&stream, action);
 
-            if (ret != LZMA_OK) {
-                // Once everything has been encoded successfully, the return value of
-                // lzma_code() will be LZMA_STREAM_END.
-                if (ret == LZMA_STREAM_END) break;
+                if (stream.avail_out == 0 || ret == LZMA_STREAM_END) {
+                    // When lzma_code() has returned LZMA_STREAM_END, the output buffer is likely to be only
+                    // partially full. Calculate how much new data there is to be written to the output file.
+                    charsWritten = sizeof(buf) - stream.avail_out;
 
-                switch (ret) {
-                    case LZMA_MEM_ERROR: {
+                    if (std::fwrite(buf, 1, charsWritten, file) != charsWritten) {
                         std::stringstream error;
-                        error << "Ran out of memory while compressing file: " << filePath;
+                        error << "Could not write to file \"" << filePath << "\": " << std::strerror(errno);
                         throw std::runtime_error(StackTrace::append_Stacktrace(error));
                     }
 
-                    case LZMA_DATA_ERROR: {
-                        std::stringstream error;
-                        error << "File size is greater than maximum (2^63 bytes): " << filePath;
-                        throw std::runtime_error(StackTrace::append_Stacktrace(error));
-                    }
+                    // Reset next_out and avail_out.
+                    stream.next_out = buf;
+                    stream.avail_out = sizeof(buf);
+                }
 
-                    default: {
-                        std::stringstream error;
-                        error << "Unknown error occurred while compressing file: " << filePath;
-                        throw std::runtime_error(StackTrace::append_Stacktrace(error));
+                if (ret != LZMA_OK) {
+                    // Once everything has been encoded successfully, the return value of
+                    // lzma_code() will be LZMA_STREAM_END.
+                    if (ret == LZMA_STREAM_END) break;
+
+                    switch (ret) {
+                        case LZMA_MEM_ERROR: {
+                            std::stringstream error;
+                            error << "Ran out of memory while compressing file: " << filePath;
+                            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+                        }
+
+                        case LZMA_DATA_ERROR: {
+                            std::stringstream error;
+                            error << "File size is greater than maximum (2^63 bytes): " << filePath;
+                            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+                        }
+
+                        default: {
+                            std::stringstream error;
+                            error << "Unknown error occurred while compressing file: " << filePath;
+                            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+                        }
                     }
                 }
             }
-        }
 
-        // Close file
-        if (std::fclose(file)) {
-            std::stringstream error;
-            error << "Could not close file \"" << filePath << "\": " << std::strerror(errno);
-            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            // Close file
+            FileIO::sync_File(file, tempPath);
+            const int closeResult = std::fclose(file);
+            file = nullptr;
+            if (closeResult) {
+                std::stringstream error;
+                error << "Could not close file \"" << tempPath << "\": " << std::strerror(errno);
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+            _record_Compression(stream.total_in, stream.total_out, startTime);
+            lzma_end(&stream);
+            FileIO::replace_File(tempPath, filePath);
+        } catch (...) {
+            // The stream may already be ended, which lzma_end() allows
+            lzma_end(&stream);
+            if (file) std::fclose(file);
+            std::remove(tempPath.c_str());
+            throw;
         }
-	    lzma_end(&stream);
     }
 
     std::string FileCompression::decompress_File_String(const char*const filePath) {
@@ -194,12 +231,13 @@ namespace love_engine {
     }
     
     FileIO::FileContent FileCompression::decompress_File_Raw(const char*const filePath) {
+        LOVE_PROFILE_ZONE("FileCompression::decompress_File_Raw");
+        const uint64_t startTime = Profiler::get_Time();
         lzma_stream stream = LZMA_STREAM_INIT;
         _initDecoder(&stream, filePath);
 	    lzma_action action = LZMA_RUN;
 
         // Open file
-        std::lock_guard<std::mutex>(FileIO::get_Mutex());
         FILE* file = std::fopen(filePath, "rb");
         if (!file) {
             std::stringstream error;
@@ -302,8 +340,47 @@ namespace love_engine {
             error << "Could not close file \"" << filePath << "\": " << std::strerror(errno);
             throw std::runtime_error(StackTrace::append_Stacktrace(error));
         }
+        _record_Decompression(stream.total_in, stream.total_out, startTime);
 	    lzma_end(&stream);
 	    data.shrink_to_fit();
         return FileIO::FileContent(data, head);
     }
+
+    std::vector<uint8_t> FileCompression::compress(const uint8_t*const data, const size_t size, const uint32_t preset) {
+        LOVE_PROFILE_ZONE("FileCompression::compress");
+        const uint64_t startTime = Profiler::get_Time();
+        std::vector<uint8_t> compressed(lzma_stream_buffer_bound(size));
+        size_t compressedSize = 0;
+        const lzma_ret ret = lzma_easy_buffer_encode(
+            preset, LZMA_CHECK_CRC64, nullptr,
+            data, size, compressed.data(), &compressedSize, compressed.size()
+        );
+        if (ret != LZMA_OK) {
+            std::stringstream error;
+            error << "Could not compress " << size << " bytes: error " << ret;
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        compressed.resize(compressedSize);
+        _record_Compression(size, compressedSize, startTime);
+        return compressed;
+    }
+
+    std::vector<uint8_t> FileCompression::decompress(const uint8_t*const data, const size_t compressedSize, const size_t size) {
+        LOVE_PROFILE_ZONE("FileCompression::decompress");
+        const uint64_t startTime = Profiler::get_Time();
+        std::vector<uint8_t> decompressed(size);
+        uint64_t memoryLimit = UINT64_MAX;
+        size_t inputPosition = 0, outputPosition = 0;
+        const lzma_ret ret = lzma_stream_buffer_decode(
+            &memoryLimit, 0, nullptr,
+            data, &inputPosition, compressedSize, decompressed.data(), &outputPosition, decompressed.size()
+        );
+        if ((ret != LZMA_OK) || (outputPosition != size)) {
+            std::stringstream error;
+            error << "Could not decompress " << compressedSize << " bytes into " << size << " bytes: error " << ret;
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        _record_Decompression(compressedSize, size, startTime);
+        return decompressed;
+    }
 }
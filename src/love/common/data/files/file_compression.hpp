@@ -4,6 +4,7 @@
 #include "file_io.hpp"
 
 #include <cstdint>
+#include <vector>
 
 namespace love_engine {
     class FileCompression {
@@ -22,6 +23,14 @@ namespace love_engine {
             static std::string decompress_File_String(const char*const filePath);
             // @throw std::runtime_error If a file error occurs.
             static FileIO::FileContent decompress_File_Raw(const char*const filePath);
+
+            // Compresses @p data into an in-memory .xz stream.
+            // @param preset 0 (fastest) to 9 (smallest).
+            // @throw std::runtime_error If compression fails.
+            static std::vector<uint8_t> compress(const uint8_t*const data, const size_t size, const uint32_t preset = COMPRESSION_PRESET);
+            // @param size Size of the decompressed data.
+            // @throw std::runtime_error If @p data is not an .xz stream of exactly @p size bytes.
+            static std::vector<uint8_t> decompress(const uint8_t*const data, const size_t compressedSize, const size_t size);
             
             // Level 3 seems to be a good compromise between compression size and speed.
             // Level 2-3 has a noticeable difference in size and moderate increase in compression time.
@@ -1,32 +1,56 @@
 #include "file_io.hpp"
 
+#include <atomic>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #ifdef _WIN32
 #include <Windows.h>
+#include <io.h>
 #elif defined(__APPLE__)
   #include <execinfo.h>
+  #include <fcntl.h>
   #include <iterator>
   #include <mach-o/dyld.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
 #elif defined(__unix__)
   #include <execinfo.h>
+  #include <fcntl.h>
   #include <iterator>
+  #include <sys/stat.h>
   #include <unistd.h>
 #endif
 
 #include "../../error/crash.hpp"
 #include "../../error/stack_trace.hpp"
+#include "../../system/metrics.hpp"
+#include "../../system/profiler.hpp"
 
 namespace love_engine {
     std::mutex _fileMutex;
     std::string _executable_Directory;
 
+    static void _count_Read(const uint64_t bytes) noexcept {
+        static Metrics::Counter& operations = Metrics::get_Counter("love_file_reads_total", "Files read by FileIO");
+        static Metrics::Counter& total = Metrics::get_Counter("love_file_read_bytes_total", "Bytes read by FileIO");
+        operations.add();
+        total.add(bytes);
+    }
+
+    static void _count_Write(const uint64_t bytes) noexcept {
+        static Metrics::Counter& operations = Metrics::get_Counter("love_file_writes_total", "File writes and appends by FileIO");
+        static Metrics::Counter& total = Metrics::get_Counter("love_file_written_bytes_total", "Bytes written by FileIO");
+        operations.add();
+        total.add(bytes);
+    }
+
     std::mutex& FileIO::get_Mutex() noexcept {
         return _fileMutex;
     }
@@ -147,6 +171,7 @@ namespace love_engine {
     }
 
     std::string FileIO::read_File(std::string filePath) {
+        LOVE_PROFILE_ZONE("FileIO::read_File");
         try {
             validate_Path(filePath);
         } catch (std::invalid_argument& e) { throw e; }
@@ -170,6 +195,7 @@ namespace love_engine {
             error << "Could not read from file \"" << filePath << "\": " << std::strerror(errno);
             throw std::runtime_error(StackTrace::append_Stacktrace(error));
         }
+        _count_Read(size);
 
         if (std::fclose(file)) {
             std::stringstream error;
@@ -180,6 +206,7 @@ namespace love_engine {
     }
     
     FileIO::FileContent FileIO::read_File_Content(std::string filePath) {
+        LOVE_PROFILE_ZONE("FileIO::read_File_Content");
         try {
             validate_Path(filePath);
         } catch (std::invalid_argument& e) { throw e; }
@@ -202,6 +229,7 @@ namespace love_engine {
             error << "Could not read from file \"" << filePath << "\": " << std::strerror(errno);
             throw std::runtime_error(StackTrace::append_Stacktrace(error));
         }
+        _count_Read(size);
 
         if (std::fclose(file)) {
             std::stringstream error;
@@ -212,6 +240,7 @@ namespace love_engine {
     }
     
     void FileIO::write_File(std::string filePath, const std::string& data) {
+        LOVE_PROFILE_ZONE("FileIO::write_File");
         try {
             validate_Path(filePath);
         } catch (std::invalid_argument& e) { throw e; }
@@ -229,6 +258,7 @@ namespace love_engine {
             error << "Could not write to file \"" << filePath << "\": " << std::strerror(errno);
             throw std::runtime_error(StackTrace::append_Stacktrace(error));
         }
+        _count_Write(data.length());
         
         if (std::fclose(file)) {
             std::stringstream error;
@@ -238,6 +268,7 @@ namespace love_engine {
     }
 
     void FileIO::write_File(std::string filePath, FileIO::FileContent& content) {
+        LOVE_PROFILE_ZONE("FileIO::write_File");
         try {
             validate_Path(filePath);
         } catch (std::invalid_argument& e) { throw e; }
@@ -255,6 +286,7 @@ namespace love_engine {
             error << "Could not write to file \"" << filePath << "\": " << std::strerror(errno);
             throw std::runtime_error(StackTrace::append_Stacktrace(error));
         }
+        _count_Write(content.size());
         
         if (std::fclose(file)) {
             std::stringstream error;
@@ -263,7 +295,8 @@ namespace love_engine {
         }
     }
     
-    void FileIO::append_File(std::string filePath, const std::string& data) {
+    void FileIO::append_File(std::string filePath, const std::string_view data) {
+        LOVE_PROFILE_ZONE("FileIO::append_File");
         try {
             validate_Path(filePath);
         } catch (std::invalid_argument& e) { throw e; }
@@ -281,6 +314,7 @@ namespace love_engine {
             error << "Could not write to file \"" << filePath << "\": " << std::strerror(errno);
             throw std::runtime_error(StackTrace::append_Stacktrace(error));
         }
+        _count_Write(data.length());
         
         if (std::fclose(file)) {
             std::stringstream error;
@@ -288,4 +322,119 @@ namespace love_engine {
             throw std::runtime_error(StackTrace::append_Stacktrace(error));
         }
     }
+
+    void FileIO::write_File_Atomic(std::string filePath, const uint8_t*const data, const size_t size) {
+        LOVE_PROFILE_ZONE("FileIO::write_File_Atomic");
+        try {
+            validate_Path(filePath);
+        } catch (std::invalid_argument& e) { throw e; }
+
+        // Not under _fileMutex, so other file work never waits on the syncs. The temp file is unique, and the
+        // rename replaces the target in one step.
+        std::string tempPath;
+        FILE* file = open_Temp_File(filePath, tempPath);
+
+        try {
+            if (std::fwrite(data, 1, size, file) != size) {
+                std::stringstream error;
+                error << "Could not write to file \"" << tempPath << "\": " << std::strerror(errno);
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+            _count_Write(size);
+            sync_File(file, tempPath);
+        } catch (std::runtime_error& e) {
+            std::fclose(file);
+            std::remove(tempPath.c_str());
+            throw e;
+        }
+
+        if (std::fclose(file)) {
+            std::stringstream error;
+            error << "Could not close file \"" << tempPath << "\": " << std::strerror(errno);
+            std::remove(tempPath.c_str());
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        try {
+            replace_File(tempPath, filePath);
+        } catch (std::runtime_error& e) {
+            std::remove(tempPath.c_str());
+            throw e;
+        }
+    }
+
+    FILE* FileIO::open_Temp_File(const std::string& filePath, std::string& tempPath) {
+        FILE* file = nullptr;
+#ifdef _WIN32
+        static std::atomic<uint32_t> counter = 0;
+        for (uint32_t attempt = 0; !file && attempt < 100; ++attempt) {
+            tempPath = filePath + "." + std::to_string(GetCurrentProcessId()) + "-" + std::to_string(counter++) + ".tmp";
+            file = std::fopen(tempPath.c_str(), "wbx");
+            if (!file && errno != EEXIST) break;
+        }
+#else
+        std::string pattern = filePath + ".XXXXXX";
+        const int descriptor = mkstemp(pattern.data());
+        tempPath = pattern;
+        if (descriptor >= 0) {
+            // mkstemp() creates the file readable by its owner only
+            fchmod(descriptor, 0644);
+            file = fdopen(descriptor, "wb");
+            if (!file) {
+                const int fdopenError = errno;
+                close(descriptor);
+                std::remove(tempPath.c_str());
+                errno = fdopenError;
+            }
+        }
+#endif
+        if (!file) {
+            std::stringstream error;
+            error << "Could not create a temporary file for \"" << filePath << "\": " << std::strerror(errno);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        return file;
+    }
+
+    void FileIO::sync_File(FILE*const file, const std::string& filePath) {
+        LOVE_PROFILE_ZONE("FileIO::sync_File");
+        if (std::fflush(file)) {
+            std::stringstream error;
+            error << "Could not flush file \"" << filePath << "\": " << std::strerror(errno);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+#ifdef _WIN32
+        if (_commit(_fileno(file))) {
+#else
+        if (fsync(fileno(file))) {
+#endif
+            std::stringstream error;
+            error << "Could not sync file \"" << filePath << "\": " << std::strerror(errno);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+    }
+
+    void FileIO::replace_File(const std::string& tempPath, const std::string& filePath) {
+#ifdef _WIN32
+        if (!MoveFileExA(tempPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            std::stringstream error;
+            error << "Could not replace file \"" << filePath << "\": error " << GetLastError();
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+#else
+        if (std::rename(tempPath.c_str(), filePath.c_str())) {
+            std::stringstream error;
+            error << "Could not replace file \"" << filePath << "\": " << std::strerror(errno);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+
+        // The rename is only durable once the directory entry is synced
+        std::string directory = std::filesystem::path(filePath).parent_path().string();
+        if (directory.empty()) directory = ".";
+        const int directoryFile = open(directory.c_str(), O_RDONLY);
+        if (directoryFile >= 0) {
+            fsync(directoryFile);
+            close(directoryFile);
+        }
+#endif
+    }
 }
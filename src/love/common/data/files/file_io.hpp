@@ -2,8 +2,10 @@
 #define LOVE_FILE_IO_HPP
 
 #include <cstdint>
+#include <cstdio>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace love_engine {
@@ -45,9 +47,33 @@ namespace love_engine {
             // @throw std::invalid_argument If @p filePath is empty.
             // @throw std::runtime_error If a file error occurs.
             static void write_File(std::string filePath, FileContent& content);
+            // Writes to a temporary file, syncs it to disk and renames it over @p filePath.
+            // A crash leaves either the old or the new file, never a partial one.
             // @throw std::invalid_argument If @p filePath is empty.
             // @throw std::runtime_error If a file error occurs.
-            static void append_File(std::string filePath, const std::string& data);
+            static void write_File_Atomic(std::string filePath, const std::string& data) {
+                write_File_Atomic(filePath, reinterpret_cast<const uint8_t*const>(data.data()), data.length());
+            }
+            // Writes to a temporary file, syncs it to disk and renames it over @p filePath.
+            // A crash leaves either the old or the new file, never a partial one. Does not take get_Mutex(), and
+            // concurrent writes to one path each land whole, the last rename winning.
+            // @throw std::invalid_argument If @p filePath is empty.
+            // @throw std::runtime_error If a file error occurs.
+            static void write_File_Atomic(std::string filePath, const uint8_t*const data, const size_t size);
+            // @throw std::invalid_argument If @p filePath is empty.
+            // @throw std::runtime_error If a file error occurs.
+            static void append_File(std::string filePath, const std::string_view data);
+
+            // Flushes @p file and waits until its contents are on disk.
+            // @throw std::runtime_error If a file error occurs.
+            static void sync_File(FILE*const file, const std::string& filePath);
+            // Renames @p tempPath over @p filePath in one step and syncs the rename to disk.
+            // @throw std::runtime_error If a file error occurs.
+            static void replace_File(const std::string& tempPath, const std::string& filePath);
+            // Creates a uniquely named temporary file next to @p filePath for an atomic write to it and sets @p tempPath
+            // to its path. Concurrent writes to the same file each get their own temporary file.
+            // @throw std::runtime_error If a file error occurs.
+            static FILE* open_Temp_File(const std::string& filePath, std::string& tempPath);
 
             static std::mutex& get_Mutex() noexcept;
     };
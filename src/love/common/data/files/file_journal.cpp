@@ -0,0 +1,158 @@
+#include "file_journal.hpp"
+
+#include "../../error/stack_trace.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#include <lzma.h>
+
+namespace love_engine {
+    constexpr size_t _BASE_HEADER_SIZE = sizeof(FileJournal::BASE_MAGIC) - 1 + sizeof(uint64_t);
+
+    FileJournal::~FileJournal() {
+        if (_journal) std::fclose(_journal);
+    }
+
+    void FileJournal::_open_Journal(const char*const mode) {
+        if (_journal) std::fclose(_journal);
+        _journal = std::fopen(_journalPath.c_str(), mode);
+        if (!_journal) {
+            std::stringstream error;
+            error << "Could not open file \"" << _journalPath << "\": " << std::strerror(errno);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+    }
+
+    std::vector<uint8_t> FileJournal::open(const Record_Function& apply) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        FileIO::ensure_Parent_Directory_Exists(_filePath);
+
+        // Base file: [magic][sequence: u64][state]
+        std::vector<uint8_t> state;
+        uint64_t baseSequence = 0;
+        if (std::filesystem::exists(_filePath)) {
+            const FileIO::FileContent content = FileIO::read_File_Content(_filePath);
+            if ((content.size() < _BASE_HEADER_SIZE) || (std::memcmp(content.data(), BASE_MAGIC, sizeof(BASE_MAGIC) - 1) != 0)) {
+                std::stringstream error;
+                error << "File is not a journal base: " << _filePath;
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+            std::memcpy(&baseSequence, content.data() + sizeof(BASE_MAGIC) - 1, sizeof(baseSequence));
+            state.assign(content.data() + _BASE_HEADER_SIZE, content.data() + content.size());
+        }
+        _sequence = baseSequence;
+
+        // Journal: [sequence: u64][size: u32][crc32: u32][record] per record
+        size_t validSize = 0;
+        if (std::filesystem::exists(_journalPath)) {
+            const FileIO::FileContent journal = FileIO::read_File_Content(_journalPath);
+            const uint8_t*const data = journal.data();
+            while (validSize + sizeof(Record_Header) <= journal.size()) {
+                Record_Header header;
+                std::memcpy(&header, data + validSize, sizeof(header));
+                const uint8_t*const record = data + validSize + sizeof(header);
+                if (validSize + sizeof(header) + header.size > journal.size()) break;
+                if (lzma_crc32(record, header.size, 0) != header.checksum) break;
+
+                // Records up to the base's sequence were compacted into it before a crash emptied the journal
+                if (header.sequence > baseSequence) {
+                    apply(header.sequence, record, header.size);
+                    _sequence = header.sequence;
+                }
+                validSize += sizeof(header) + header.size;
+            }
+
+            // Drop a torn tail so new records follow the last valid one
+            if (validSize != journal.size()) std::filesystem::resize_file(_journalPath, validSize);
+        }
+
+        _open_Journal("ab");
+        _journalSize = validSize;
+        return state;
+    }
+
+    void FileJournal::_discard_Tail() noexcept {
+        // Reopened, so nothing still buffered is written after the cut
+        std::fclose(_journal);
+        _journal = nullptr;
+        std::error_code error;
+        std::filesystem::resize_file(_journalPath, _journalSize, error);
+        if (!error) _journal = std::fopen(_journalPath.c_str(), "ab");
+    }
+
+    void FileJournal::append(const uint8_t*const data, const size_t size) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_journal) throw std::logic_error(StackTrace::append_Stacktrace("The journal is not open."));
+        if (size > UINT32_MAX) {
+            std::stringstream error;
+            error << "Journal record of " << size << " bytes is too large for \"" << _journalPath << "\".";
+            throw std::invalid_argument(StackTrace::append_Stacktrace(error));
+        }
+
+        const Record_Header header{
+            .sequence = _sequence + 1,
+            .size = static_cast<uint32_t>(size),
+            .checksum = lzma_crc32(data, size, 0),
+        };
+        try {
+            if ((std::fwrite(&header, 1, sizeof(header), _journal) != sizeof(header)) || (std::fwrite(data, 1, size, _journal) != size)) {
+                std::stringstream error;
+                error << "Could not write to file \"" << _journalPath << "\": " << std::strerror(errno);
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+
+            if (_settings.syncEachAppend) FileIO::sync_File(_journal, _journalPath);
+            else if (std::fflush(_journal)) {
+                std::stringstream error;
+                error << "Could not flush file \"" << _journalPath << "\": " << std::strerror(errno);
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+        } catch (...) {
+            // Otherwise open() would stop replaying at the torn record and drop every record after it
+            _discard_Tail();
+            throw;
+        }
+        ++_sequence;
+        _journalSize += sizeof(header) + size;
+    }
+
+    void FileJournal::sync() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_journal) FileIO::sync_File(_journal, _journalPath);
+    }
+
+    bool FileJournal::needs_Compaction() const noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _journalSize >= _settings.compactionThreshold;
+    }
+
+    void FileJournal::compact(const uint8_t*const state, const size_t size) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_journal) throw std::logic_error(StackTrace::append_Stacktrace("The journal is not open."));
+
+        std::vector<uint8_t> base(_BASE_HEADER_SIZE + size);
+        std::memcpy(base.data(), BASE_MAGIC, sizeof(BASE_MAGIC) - 1);
+        std::memcpy(base.data() + sizeof(BASE_MAGIC) - 1, &_sequence, sizeof(_sequence));
+        if (size > 0) std::memcpy(base.data() + _BASE_HEADER_SIZE, state, size);
+        FileIO::write_File_Atomic(_filePath, base.data(), base.size());
+
+        // A crash before the journal is emptied is harmless, since the base's sequence skips the old records
+        _open_Journal("wb");
+        FileIO::sync_File(_journal, _journalPath);
+        _journalSize = 0;
+    }
+
+    uint64_t FileJournal::get_Sequence() const noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _sequence;
+    }
+
+    size_t FileJournal::get_Journal_Size() const noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _journalSize;
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef LOVE_FILE_JOURNAL_HPP
+#define LOVE_FILE_JOURNAL_HPP
+
+#include "file_io.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    // A base file plus an append-only journal of changes to it (<file>.journal).
+    // Small updates are appended as records instead of rewriting the file. compact() writes a new base atomically
+    // and empties the journal. On open(), journal records newer than the base are replayed, and a record torn
+    // by a crash is dropped.
+    // Thread-safe.
+    class FileJournal {
+        public:
+            typedef std::function<void(const uint64_t sequence, const uint8_t*const data, const size_t size)> Record_Function;
+
+            typedef struct Settings_ {
+                // needs_Compaction() turns true once the journal grows past this size.
+                size_t compactionThreshold = 4 * 1024 * 1024;
+                // Sync every record to disk as it is appended. Otherwise records are flushed to the OS only.
+                bool syncEachAppend = false;
+            } Settings;
+
+            FileJournal(const std::string& filePath, const Settings settings) : _filePath(filePath), _journalPath(filePath + ".journal"), _settings(settings) {}
+            FileJournal(FileJournal const&) = delete;
+            void operator=(FileJournal const&) = delete;
+            ~FileJournal();
+
+            // Reads the base file and passes each journal record written after it to @p apply, in order.
+            // @return Contents of the base file, empty if there is none.
+            // @throw std::runtime_error If a file error occurs or the base file is not a journal base.
+            std::vector<uint8_t> open(const Record_Function& apply);
+
+            // A failed append leaves the journal as it was. If that fails too, the journal closes.
+            // @throw std::logic_error If the journal is not open.
+            // @throw std::invalid_argument If the record is larger than 4 GiB.
+            // @throw std::runtime_error If a file error occurs.
+            void append(const std::string& record) { append(reinterpret_cast<const uint8_t*const>(record.data()), record.length()); }
+            // @throw std::logic_error If the journal is not open.
+            // @throw std::invalid_argument If the record is larger than 4 GiB.
+            // @throw std::runtime_error If a file error occurs.
+            void append(const uint8_t*const data, const size_t size);
+            // Waits until every appended record is on disk.
+            // @throw std::runtime_error If a file error occurs.
+            void sync();
+
+            bool needs_Compaction() const noexcept;
+            // Atomically replaces the base file with @p state, which must include every appended record, then empties the journal.
+            // @throw std::logic_error If the journal is not open.
+            // @throw std::runtime_error If a file error occurs.
+            void compact(const uint8_t*const state, const size_t size);
+
+            // Sequence number of the last record appended or replayed.
+            uint64_t get_Sequence() const noexcept;
+            size_t get_Journal_Size() const noexcept;
+
+            static constexpr char BASE_MAGIC[] = "LOVEJNL1";
+
+        private:
+            typedef struct Record_Header_ {
+                uint64_t sequence;
+                uint32_t size;
+                uint32_t checksum;
+            } Record_Header;
+
+            void _open_Journal(const char*const mode);
+            // Cuts the journal back to _journalSize, dropping a partly written record
+            void _discard_Tail() noexcept;
+
+            std::string _filePath;
+            std::string _journalPath;
+            Settings _settings;
+
+            mutable std::mutex _mutex;
+            FILE* _journal = nullptr;
+            size_t _journalSize = 0;
+            uint64_t _sequence = 0;
+    };
+}
+
+#endif // LOVE_FILE_JOURNAL_HPP
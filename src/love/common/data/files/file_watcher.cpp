@@ -0,0 +1,312 @@
+#include "file_watcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace love_engine {
+    static std::string _normalize_Path(const std::string& path) noexcept {
+        std::string normal = std::filesystem::path(path).lexically_normal().generic_string();
+        while ((normal.length() > 1) && normal.ends_with('/')) normal.pop_back();
+        return normal;
+    }
+
+    static std::string _join_Path(const std::string& directory, const std::string& name) noexcept {
+        return directory.empty() ? name : directory + "/" + name;
+    }
+
+    // Files written this close before the last drain of the inotify queue may have lost their event, as
+    // file times are coarse.
+    static constexpr std::chrono::seconds _RESCAN_SLACK = std::chrono::seconds(2);
+
+    static bool _is_Under(const std::string& path, const std::string& root) noexcept {
+        if (!path.starts_with(root)) return false;
+        return (path.length() == root.length()) || (path[root.length()] == '/');
+    }
+
+    FileWatcher::FileWatcher(const Settings settings) : _settings(settings) {
+#ifdef __linux__
+        if (!settings.forcePolling) _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        _polling = _inotify < 0;
+#endif
+        _thread = std::make_unique<Thread>("FILE_WATCHER", [this]() { _watch_Loop(); });
+    }
+
+    FileWatcher::~FileWatcher() {
+        _stopping = true;
+        _thread->join();
+#ifdef __linux__
+        if (_inotify >= 0) close(_inotify);
+#endif
+    }
+
+    FileWatcher::Subscription_Id FileWatcher::subscribe(const std::string& path, const Callback& callback) noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const Subscription_Id id = _nextId++;
+        _subscriptions.emplace(id, Subscription{.path = _normalize_Path(path), .callback = callback});
+        if (!_polling) _add_Watches(_subscriptions[id].path);
+        return id;
+    }
+
+    void FileWatcher::unsubscribe(const Subscription_Id id) noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_subscriptions.erase(id) || _polling) return;
+
+#ifdef __linux__
+        // Cheaper to rebuild than to count which subscriptions share each directory
+        for (const auto& watch : _watches) inotify_rm_watch(_inotify, watch.first);
+        _watches.clear();
+        _knownFiles.clear();
+        for (const auto& subscription : _subscriptions) _add_Watches(subscription.second.path);
+#endif
+    }
+
+    size_t FileWatcher::dispatch() noexcept {
+        std::vector<std::vector<Event>> batches;
+        std::vector<Subscription> subscriptions;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_ready.empty()) return 0;
+            batches.swap(_ready);
+            subscriptions.reserve(_subscriptions.size());
+            for (const auto& subscription : _subscriptions) subscriptions.push_back(subscription.second);
+        }
+
+        size_t delivered = 0;
+        std::vector<Event> events;
+        for (const auto& batch : batches) {
+            delivered += batch.size();
+            for (const Subscription& subscription : subscriptions) {
+                events.clear();
+                for (const Event& event : batch) {
+                    if (_is_Under(event.path, subscription.path)) events.push_back(event);
+                }
+                if (!events.empty()) subscription.callback(events);
+            }
+        }
+        return delivered;
+    }
+
+    bool FileWatcher::_is_Watched(const std::string& path) const noexcept {
+        return std::any_of(_subscriptions.begin(), _subscriptions.end(), [&path](const auto& subscription) {
+            return _is_Under(path, subscription.second.path);
+        });
+    }
+
+    void FileWatcher::_add_Event(const std::string& path, const Change change) noexcept {
+        if (!_is_Watched(path)) return;
+
+        const Clock::time_point now = Clock::now();
+        if (_pending.empty()) _firstPending = now;
+        _lastPending = now;
+
+        const auto pending = _pending.find(path);
+        if (pending == _pending.end()) {
+            _pending.emplace(path, change);
+            return;
+        }
+
+        // Reduce to the net change since the last batch
+        switch (pending->second) {
+            case Change::CREATED:
+                if (change == Change::REMOVED) _pending.erase(pending);
+                break;
+            case Change::MODIFIED:
+                if (change == Change::REMOVED) pending->second = Change::REMOVED;
+                break;
+            case Change::REMOVED:
+                if (change != Change::REMOVED) pending->second = Change::MODIFIED;
+                break;
+        }
+    }
+
+    void FileWatcher::_flush_Pending(const Clock::time_point now) noexcept {
+        if (_pending.empty()) return;
+        if ((now - _lastPending < _settings.debounce) && (now - _firstPending < _settings.maxDelay)) return;
+
+        std::vector<Event> batch;
+        batch.reserve(_pending.size());
+        for (const auto& pending : _pending) batch.push_back(Event{.path = pending.first, .change = pending.second});
+        _pending.clear();
+        _ready.push_back(std::move(batch));
+    }
+
+    void FileWatcher::_watch_Loop() noexcept {
+        const std::chrono::milliseconds wait = std::clamp(_settings.debounce / 2, std::chrono::milliseconds(10), std::chrono::milliseconds(100));
+        Clock::time_point nextPoll = Clock::now();
+
+        while (!_stopping) {
+            if (_polling) {
+                if (Clock::now() >= nextPoll) {
+                    _poll();
+                    nextPoll = Clock::now() + _settings.pollInterval;
+                }
+                std::this_thread::sleep_for(wait);
+            } else _read_Inotify();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _flush_Pending(Clock::now());
+        }
+    }
+
+    void FileWatcher::_add_Watches(const std::string& path) noexcept {
+        // The parent is watched too, so the path is seen when it is created or replaced
+        const std::string parent = std::filesystem::path(path).parent_path().generic_string();
+        _add_Directory_Watch(parent);
+
+        std::error_code error;
+        if (std::filesystem::is_regular_file(path, error)) _knownFiles.insert(path);
+        if (!std::filesystem::is_directory(path, error)) return;
+        _add_Directory_Watch(path);
+        for (auto file = std::filesystem::recursive_directory_iterator(path, error); file != std::filesystem::recursive_directory_iterator(); file.increment(error)) {
+            if (error) break;
+            if (file->is_directory(error)) _add_Directory_Watch(file->path().generic_string());
+            else _knownFiles.insert(file->path().generic_string());
+        }
+    }
+
+    void FileWatcher::_add_Directory_Watch([[maybe_unused]] const std::string& directory) noexcept {
+#ifdef __linux__
+        const uint32_t mask = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+        const int watch = inotify_add_watch(_inotify, directory.empty() ? "." : directory.c_str(), mask);
+        if (watch >= 0) _watches[watch] = directory;
+#endif
+    }
+
+    void FileWatcher::_read_Inotify() noexcept {
+#ifdef __linux__
+        const std::filesystem::file_time_type started = std::filesystem::file_time_type::clock::now();
+        const int timeout = static_cast<int>(std::clamp(_settings.debounce / 2, std::chrono::milliseconds(10), std::chrono::milliseconds(100)).count());
+        pollfd request{.fd = _inotify, .events = POLLIN, .revents = 0};
+        if (::poll(&request, 1, timeout) <= 0) {
+            _syncedAt = started;
+            return;
+        }
+
+        alignas(inotify_event) char buffer[16384];
+        ssize_t length;
+        while ((length = read(_inotify, buffer, sizeof(buffer))) > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (ssize_t offset = 0; offset < length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    _rescan();
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    _watches.erase(event->wd);
+                    continue;
+                }
+
+                const auto watch = _watches.find(event->wd);
+                if ((watch == _watches.end()) || (event->len == 0)) continue;
+                const std::string path = _join_Path(watch->second, event->name);
+
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    if (!_is_Watched(path)) continue;
+                    if (!(event->mask & IN_ISDIR)) {
+                        // Saving through a temporary file renames it over the old one
+                        _add_Event(path, _knownFiles.insert(path).second ? Change::CREATED : Change::MODIFIED);
+                        continue;
+                    }
+
+                    // Files may have been created in the directory before its watch was added
+                    _add_Event(path, Change::CREATED);
+                    _add_Watches(path);
+                    std::error_code error;
+                    for (auto file = std::filesystem::recursive_directory_iterator(path, error); file != std::filesystem::recursive_directory_iterator(); file.increment(error)) {
+                        if (error) break;
+                        _add_Event(file->path().generic_string(), Change::CREATED);
+                    }
+                } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    // A directory takes the files under it along
+                    _knownFiles.erase(path);
+                    _knownFiles.erase(_knownFiles.lower_bound(path + "/"), _knownFiles.lower_bound(path + "0"));
+                    _add_Event(path, Change::REMOVED);
+                } else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE)) _add_Event(path, Change::MODIFIED);
+            }
+        }
+        if ((length < 0) && (errno == EAGAIN)) _syncedAt = started;
+#endif
+    }
+
+    void FileWatcher::_rescan() noexcept {
+        // Watches directories created while events were lost too
+        std::set<std::string> known;
+        known.swap(_knownFiles);
+        for (const auto& subscription : _subscriptions) _add_Watches(subscription.second.path);
+
+        // Only files written since the last complete read can have lost a modification
+        const std::filesystem::file_time_type modifiedAfter = _syncedAt - _RESCAN_SLACK;
+        std::error_code error;
+        for (const std::string& path : _knownFiles) {
+            if (!known.contains(path)) _add_Event(path, Change::CREATED);
+            else if (std::filesystem::last_write_time(path, error) >= modifiedAfter) _add_Event(path, Change::MODIFIED);
+        }
+        for (const std::string& path : known) {
+            if (!_knownFiles.contains(path)) _add_Event(path, Change::REMOVED);
+        }
+    }
+
+    void FileWatcher::_scan(const std::string& path, std::map<std::string, File_State>& files) noexcept {
+        std::error_code error;
+        const auto status = std::filesystem::status(path, error);
+        if (std::filesystem::is_regular_file(status)) {
+            files[path] = File_State{.time = std::filesystem::last_write_time(path, error), .size = std::filesystem::file_size(path, error)};
+            return;
+        }
+        if (!std::filesystem::is_directory(status)) return;
+
+        for (auto file = std::filesystem::recursive_directory_iterator(path, error); file != std::filesystem::recursive_directory_iterator(); file.increment(error)) {
+            if (error) break;
+            if (!file->is_regular_file(error)) continue;
+            files[file->path().generic_string()] = File_State{.time = file->last_write_time(error), .size = file->file_size(error)};
+        }
+    }
+
+    void FileWatcher::_poll() noexcept {
+        std::set<std::string> roots;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto& subscription : _subscriptions) roots.insert(subscription.second.path);
+        }
+        std::erase_if(_polledFiles, [&roots](const auto& polled) { return !roots.contains(polled.first); });
+
+        std::vector<Event> events;
+        for (const std::string& root : roots) {
+            std::map<std::string, File_State> files;
+            _scan(root, files);
+
+            const auto previous = _polledFiles.find(root);
+            if (previous == _polledFiles.end()) {
+                // Newly subscribed, so only remember what exists
+                _polledFiles.emplace(root, std::move(files));
+                continue;
+            }
+
+            for (const auto& file : files) {
+                const auto old = previous->second.find(file.first);
+                if (old == previous->second.end()) events.push_back(Event{.path = file.first, .change = Change::CREATED});
+                else if ((old->second.time != file.second.time) || (old->second.size != file.second.size)) {
+                    events.push_back(Event{.path = file.first, .change = Change::MODIFIED});
+                }
+            }
+            for (const auto& old : previous->second) {
+                if (!files.contains(old.first)) events.push_back(Event{.path = old.first, .change = Change::REMOVED});
+            }
+            previous->second = std::move(files);
+        }
+
+        if (events.empty()) return;
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const Event& event : events) _add_Event(event.path, event.change);
+    }
+}
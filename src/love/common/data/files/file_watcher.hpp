@@ -0,0 +1,126 @@
+#ifndef LOVE_FILE_WATCHER_HPP
+#define LOVE_FILE_WATCHER_HPP
+
+#include "../../system/thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace love_engine {
+    // Watches files and directories for changes on a background thread, so they can be reloaded while running.
+    // Uses inotify on Linux and polls file times and sizes elsewhere, or when inotify is unavailable.
+    // Changes are coalesced per path and held until none arrived for the debounce time, then delivered in one
+    // batch by dispatch() on the caller's thread.
+    // Thread-safe.
+    class FileWatcher {
+        public:
+            // Files replaced by renaming another file over them are MODIFIED, as with in-place writes.
+            enum class Change : uint8_t {
+                CREATED,
+                MODIFIED,
+                REMOVED,
+            };
+
+            typedef struct Event_ {
+                // Generic path, starting with the subscribed path
+                std::string path;
+                Change change;
+            } Event;
+
+            typedef uint32_t Subscription_Id;
+            // Receives every event of a batch under the subscribed path, sorted by path.
+            typedef std::function<void(const std::vector<Event>& events)> Callback;
+
+            typedef struct Settings_ {
+                // Quiet time after the last change before a batch is delivered
+                std::chrono::milliseconds debounce = std::chrono::milliseconds(100);
+                // A batch is delivered after this long even while changes keep arriving
+                std::chrono::milliseconds maxDelay = std::chrono::milliseconds(1000);
+                std::chrono::milliseconds pollInterval = std::chrono::milliseconds(500);
+                bool forcePolling = false;
+            } Settings;
+
+            FileWatcher(const Settings settings);
+            FileWatcher(FileWatcher const&) = delete;
+            void operator=(FileWatcher const&) = delete;
+            ~FileWatcher();
+
+            // Watches @p path, which may be a file or a directory watched recursively. The path need not exist yet.
+            Subscription_Id subscribe(const std::string& path, const Callback& callback) noexcept;
+            void unsubscribe(const Subscription_Id id) noexcept;
+
+            // Calls subscribers with every batch that is ready.
+            // @return Number of events delivered.
+            size_t dispatch() noexcept;
+
+            bool is_Polling() const noexcept { return _polling; }
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            typedef struct Subscription_ {
+                std::string path;
+                Callback callback;
+            } Subscription;
+
+            typedef struct File_State_ {
+                std::filesystem::file_time_type time;
+                uintmax_t size;
+            } File_State;
+
+            void _watch_Loop() noexcept;
+            // Requires _mutex.
+            bool _is_Watched(const std::string& path) const noexcept;
+            // Requires _mutex.
+            void _add_Event(const std::string& path, const Change change) noexcept;
+            // Requires _mutex.
+            void _flush_Pending(const Clock::time_point now) noexcept;
+
+            // Requires _mutex.
+            void _add_Watches(const std::string& path) noexcept;
+            // Requires _mutex.
+            void _add_Directory_Watch(const std::string& directory) noexcept;
+            void _read_Inotify() noexcept;
+            // Requires _mutex. Diffs the subscribed trees against _knownFiles after inotify dropped events.
+            void _rescan() noexcept;
+
+            void _poll() noexcept;
+            static void _scan(const std::string& path, std::map<std::string, File_State>& files) noexcept;
+
+            Settings _settings;
+            bool _polling = true;
+            int _inotify = -1;
+
+            mutable std::mutex _mutex;
+            std::unordered_map<Subscription_Id, Subscription> _subscriptions;
+            Subscription_Id _nextId = 1;
+            // Watch descriptor -> watched directory
+            std::unordered_map<int, std::string> _watches;
+            // Files known to exist under inotify watches, so a file moved over one is reported as MODIFIED
+            std::set<std::string> _knownFiles;
+            std::map<std::string, Change> _pending;
+            Clock::time_point _firstPending, _lastPending;
+            std::vector<std::vector<Event>> _ready;
+
+            // Only used by the watcher thread
+            std::map<std::string, std::map<std::string, File_State>> _polledFiles;
+            // Every inotify event before this was read
+            std::filesystem::file_time_type _syncedAt;
+
+            std::atomic<bool> _stopping = false;
+            // Last member, so it stops before the rest is destroyed
+            std::unique_ptr<Thread> _thread;
+    };
+}
+
+#endif // LOVE_FILE_WATCHER_HPP
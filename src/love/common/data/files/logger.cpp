@@ -1,17 +1,65 @@
 #include "logger.hpp"
 
 #include "../../error/crash.hpp"
+#include "../../memory/memory_tracker.hpp"
+#include "../../memory/pool_allocator.hpp"
+#include "../../system/metrics.hpp"
 #include "../../system/thread.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <mutex>
 #include <sstream>
 #include <sys/time.h>
 
 namespace love_engine {
-    std::string Logger::_generate_Log_Message(const Log_Status status, const std::string& message) noexcept {
+    // Most messages fit a pool size class, so formatting rarely takes the heap lock
+    static std::pmr::memory_resource* _get_Message_Resource() noexcept {
+        static MemoryTracker::Resource resource("logger", PoolAllocator::get_Resource());
+        return &resource;
+    }
+
+    // Sequence is odd while the slot is written
+    typedef struct Recent_Message_ {
+        std::atomic<uint64_t> sequence = 0;
+        size_t length = 0;
+        char text[Logger::RECENT_MESSAGE_SIZE];
+    } Recent_Message;
+    std::mutex _pendingWritesMutex;
+    std::condition_variable _writesDone;
+    size_t _pendingWrites = 0;
+
+    static Recent_Message _recentMessages[Logger::RECENT_MESSAGES];
+    static std::atomic<uint64_t> _recentMessageCount = 0;
+
+    static void _add_Recent_Message(const std::pmr::string& message) noexcept {
+        Recent_Message& slot = _recentMessages[_recentMessageCount.fetch_add(1, std::memory_order_relaxed) % Logger::RECENT_MESSAGES];
+        slot.sequence.fetch_add(1, std::memory_order_acquire);
+        slot.length = std::min(message.ends_with('\n') ? message.length() - 1 : message.length(), sizeof(slot.text));
+        std::memcpy(slot.text, message.data(), slot.length);
+        slot.sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    size_t Logger::get_Recent_Message(const size_t index, char* buffer, const size_t capacity) noexcept {
+        const uint64_t count = _recentMessageCount.load(std::memory_order_acquire);
+        const uint64_t kept = std::min<uint64_t>(count, RECENT_MESSAGES);
+        if (index >= kept) return 0;
+
+        const Recent_Message& slot = _recentMessages[(count - kept + index) % RECENT_MESSAGES];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) return 0;
+        const size_t length = std::min({slot.length, sizeof(slot.text), capacity});
+        std::memcpy(buffer, slot.text, length);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (slot.sequence.load(std::memory_order_relaxed) == sequence) ? length : 0;
+    }
+
+    std::pmr::string Logger::_generate_Log_Message(const Log_Status status, const std::string& message) noexcept {
         // Get time
         struct timeval tv;
         if (gettimeofday(&tv, nullptr)) {
@@ -33,26 +81,37 @@ namespace love_engine {
         std::snprintf(timeBuffer, sizeof(timeBuffer), "[%02d:%02d:%02d+%06ld]",
             now->tm_hour, now->tm_min, now->tm_sec, tv.tv_usec
         );
-        std::stringstream outputMessageBuffer;
-        outputMessageBuffer <<
-            timeBuffer <<
-            " [" << Thread::get_Thread_Name(std::this_thread::get_id()) << "/" <<
-            LOG_TYPE_STRINGS[static_cast<int>(status)] << "]: " <<
-            message << "\n"
-        ;
-        return outputMessageBuffer.str();
+        const std::string threadName = Thread::get_Thread_Name(std::this_thread::get_id());
+        const char*const type = LOG_TYPE_STRINGS[static_cast<int>(status)];
+        std::pmr::string outputMessage(_get_Message_Resource());
+        outputMessage.reserve(sizeof(timeBuffer) + threadName.length() + std::strlen(type) + message.length() + sizeof(" [/]: \n"));
+        outputMessage.append(timeBuffer).append(" [").append(threadName).append("/").append(type).append("]: ").append(message).append("\n");
+        return outputMessage;
     }
 
     void Logger::log(const Log_Status status, const std::string& message) const noexcept {
-        std::string outputMessage = _generate_Log_Message(status, message);
+        std::pmr::string outputMessage = _generate_Log_Message(status, message);
+        _add_Recent_Message(outputMessage);
 
         std::puts(outputMessage.c_str());
         if (!_logPath.empty()) {
+            static Metrics::Gauge& pendingWrites = Metrics::get_Gauge("love_log_pending_writes", "Log messages still being appended to a log file");
             try {
+                pendingWrites.add(1);
+                {
+                    std::lock_guard<std::mutex> lock(_pendingWritesMutex);
+                    ++_pendingWrites;
+                }
                 Thread asyncLogThread(
                     "ASYNC_LOG_OUTPUT",
-                    FileIO::append_File,
-                    _logPath.c_str(), outputMessage
+                    // The pooled message moves to the writer thread, which frees it back to the pool
+                    [](const std::string& filePath, const std::pmr::string& message) {
+                        FileIO::append_File(filePath, message);
+                        pendingWrites.add(-1);
+                        std::lock_guard<std::mutex> lock(_pendingWritesMutex);
+                        if (--_pendingWrites == 0) _writesDone.notify_all();
+                    },
+                    _logPath, std::move(outputMessage)
                 );
             } catch (std::exception& e) {
                 std::stringstream error;
@@ -61,4 +120,9 @@ namespace love_engine {
             }
         }
     }
+
+    bool Logger::wait_For_Writes(const std::chrono::milliseconds timeout) noexcept {
+        std::unique_lock<std::mutex> lock(_pendingWritesMutex);
+        return _writesDone.wait_for(lock, timeout, []() { return _pendingWrites == 0; });
+    }
 }
@@ -3,6 +3,9 @@
 
 #include "file_io.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
 #include <string>
 #include <thread>
 
@@ -42,8 +45,21 @@ namespace love_engine {
             void set_Log_Path(const std::string& filePath) noexcept { _logPath.assign(filePath); }
             void clear() { FileIO::clear_File(_logPath.c_str()); }
 
+            // The last RECENT_MESSAGES messages logged by any Logger are kept in fixed slots for crash dumps.
+            static constexpr size_t RECENT_MESSAGES = 64;
+            static constexpr size_t RECENT_MESSAGE_SIZE = 256;
+            // Copies a recent message without allocating or locking, so it may be called from signal handlers.
+            // @param index 0 for the oldest kept message.
+            // @return Length copied, truncated to RECENT_MESSAGE_SIZE, or 0 if there is no such message or it was
+            // overwritten while copying.
+            static size_t get_Recent_Message(const size_t index, char* buffer, const size_t capacity) noexcept;
+
+            // Blocks until every message logged so far by any Logger has been appended to its file.
+            // @return False if @p timeout passed first.
+            static bool wait_For_Writes(const std::chrono::milliseconds timeout) noexcept;
+
         private:
-            static std::string _generate_Log_Message(const Log_Status status, const std::string& message) noexcept;
+            static std::pmr::string _generate_Log_Message(const Log_Status status, const std::string& message) noexcept;
 
             std::string _logPath;
    };
@@ -0,0 +1,277 @@
+#include "pack_archive.hpp"
+
+#include "file_compression.hpp"
+#include "file_io.hpp"
+
+#include "../../error/stack_trace.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace love_engine {
+    // Header: [magic][entry count: u32][reserved: u32][directory size: u64][data offset: u64]
+    constexpr size_t _HEADER_SIZE = sizeof(PackArchive::MAGIC) - 1 + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    // Directory entry: [offset: u64][stored size: u64][size: u64][flags: u8][path length: u16][path]
+    constexpr size_t _ENTRY_HEADER_SIZE = 3 * sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint16_t);
+    constexpr uint8_t _FLAG_COMPRESSED = 1;
+
+    // 64-bit offsets, so archives can grow past 2 GiB where long is 32 bits
+    static void _seek(FILE*const file, const uint64_t offset, const std::string& filePath) {
+#ifdef _WIN32
+        const int result = _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+        const int result = fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+        if (result) {
+            std::stringstream error;
+            error << "Could not seek in file \"" << filePath << "\": " << std::strerror(errno);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+    }
+
+    static uint64_t _align_To_Page(const uint64_t offset) noexcept {
+        return (offset + PackArchive::PAGE_ALIGNMENT - 1) / PackArchive::PAGE_ALIGNMENT * PackArchive::PAGE_ALIGNMENT;
+    }
+
+    PackArchive::PackArchive(const std::string& filePath) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            std::stringstream error;
+            error << "Could not open file \"" << filePath << "\": error " << GetLastError();
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+        _size = static_cast<size_t>(size.QuadPart);
+
+        // The view keeps the file mapped after both handles are closed
+        HANDLE mapping = (_size != 0) ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        if (mapping) {
+            _data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+#else
+        const int file = ::open(filePath.c_str(), O_RDONLY);
+        if (file < 0) {
+            std::stringstream error;
+            error << "Could not open file \"" << filePath << "\": " << std::strerror(errno);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        struct stat status;
+        _size = (fstat(file, &status) == 0) ? static_cast<size_t>(status.st_size) : 0;
+
+        // The mapping stays valid after the descriptor is closed
+        if (_size != 0) {
+            void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (data != MAP_FAILED) _data = static_cast<const uint8_t*>(data);
+        }
+        close(file);
+#endif
+
+        auto fail = [this, &filePath](const char*const reason) {
+            _unmap();
+            std::stringstream error;
+            error << reason << ": " << filePath;
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        };
+        if (!_data) fail("Could not map pack archive");
+        if ((_size < _HEADER_SIZE) || (std::memcmp(_data, MAGIC, sizeof(MAGIC) - 1) != 0)) fail("File is not a pack archive");
+
+        uint32_t entryCount;
+        uint64_t directorySize;
+        std::memcpy(&entryCount, _data + sizeof(MAGIC) - 1, sizeof(entryCount));
+        std::memcpy(&directorySize, _data + sizeof(MAGIC) - 1 + 2 * sizeof(uint32_t), sizeof(directorySize));
+        if (directorySize > _size - _HEADER_SIZE) fail("Pack archive directory is truncated");
+        // Checked before reserving, so a corrupt count cannot ask for more memory than the directory could describe
+        if (entryCount > directorySize / _ENTRY_HEADER_SIZE) fail("Pack archive entry count exceeds its directory");
+
+        _entries.reserve(entryCount);
+        const uint8_t* head = _data + _HEADER_SIZE;
+        const uint8_t*const end = head + directorySize;
+        for (uint32_t i = 0; i < entryCount; ++i) {
+            if (static_cast<size_t>(end - head) < _ENTRY_HEADER_SIZE) fail("Pack archive directory is truncated");
+
+            Entry entry;
+            uint8_t flags;
+            uint16_t pathLength;
+            std::memcpy(&entry.offset, head, sizeof(uint64_t));
+            std::memcpy(&entry.storedSize, head + sizeof(uint64_t), sizeof(uint64_t));
+            std::memcpy(&entry.size, head + 2 * sizeof(uint64_t), sizeof(uint64_t));
+            std::memcpy(&flags, head + 3 * sizeof(uint64_t), sizeof(flags));
+            std::memcpy(&pathLength, head + 3 * sizeof(uint64_t) + sizeof(flags), sizeof(pathLength));
+            head += _ENTRY_HEADER_SIZE;
+
+            if (static_cast<size_t>(end - head) < pathLength) fail("Pack archive directory is truncated");
+            entry.path = std::string_view(reinterpret_cast<const char*>(head), pathLength);
+            entry.compressed = (flags & _FLAG_COMPRESSED) != 0;
+            head += pathLength;
+
+            if ((entry.offset > _size) || (entry.storedSize > _size - entry.offset)) fail("Pack archive entry is out of bounds");
+            if (!entry.compressed && (entry.storedSize != entry.size)) fail("Pack archive entry has a wrong size");
+            if (!_entries.empty() && (_entries.back().path >= entry.path)) fail("Pack archive directory is not sorted");
+            _entries.push_back(entry);
+        }
+    }
+
+    PackArchive::~PackArchive() {
+        _unmap();
+    }
+
+    void PackArchive::_unmap() noexcept {
+        if (!_data) return;
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+#else
+        munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+        _data = nullptr;
+    }
+
+    const PackArchive::Entry* PackArchive::find(const std::string_view path) const noexcept {
+        const auto entry = std::lower_bound(_entries.begin(), _entries.end(), path, [](const Entry& entry, const std::string_view path) {
+            return entry.path < path;
+        });
+        return ((entry != _entries.end()) && (entry->path == path)) ? &*entry : nullptr;
+    }
+
+    std::span<const uint8_t> PackArchive::get_View(const std::string_view path) const noexcept {
+        const Entry* entry = find(path);
+        if (!entry || entry->compressed) return {};
+        return std::span<const uint8_t>(_data + entry->offset, entry->size);
+    }
+
+    std::vector<uint8_t> PackArchive::read(const std::string_view path) const {
+        const Entry* entry = find(path);
+        if (!entry) {
+            std::stringstream error;
+            error << "Pack archive has no entry: " << path;
+            throw std::invalid_argument(StackTrace::append_Stacktrace(error));
+        }
+
+        if (entry->compressed) return FileCompression::decompress(_data + entry->offset, entry->storedSize, entry->size);
+        return std::vector<uint8_t>(_data + entry->offset, _data + entry->offset + entry->size);
+    }
+
+    PackArchive::Pack_Result PackArchive::pack(const std::string& directory, const std::string& archivePath, const Pack_Settings& settings) {
+        std::vector<std::string> paths;
+        for (const auto& file : std::filesystem::recursive_directory_iterator(directory)) {
+            if (file.is_regular_file()) paths.push_back(std::filesystem::relative(file.path(), directory).generic_string());
+        }
+        std::sort(paths.begin(), paths.end());
+
+        // Directory size only depends on the paths, so data can be written before the directory is final
+        uint64_t directorySize = 0;
+        for (const std::string& path : paths) {
+            if (path.length() > UINT16_MAX) {
+                std::stringstream error;
+                error << "Path is too long to pack: " << path;
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+            directorySize += _ENTRY_HEADER_SIZE + path.length();
+        }
+
+        FileIO::ensure_Parent_Directory_Exists(archivePath);
+        std::string tempPath;
+        FILE*const archive = FileIO::open_Temp_File(archivePath, tempPath);
+
+        auto write = [archive, &tempPath](const void*const data, const size_t size) {
+            // Empty files have no data pointer
+            if (size == 0) return;
+            if (std::fwrite(data, 1, size, archive) != size) {
+                std::stringstream error;
+                error << "Could not write to file \"" << tempPath << "\": " << std::strerror(errno);
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+        };
+
+        Pack_Result result;
+        try {
+            std::vector<uint8_t> directoryData;
+            directoryData.reserve(directorySize);
+            const std::vector<uint8_t> padding(PAGE_ALIGNMENT, 0);
+            uint64_t offset = _align_To_Page(_HEADER_SIZE + directorySize);
+            _seek(archive, offset, tempPath);
+
+            for (const std::string& path : paths) {
+                const FileIO::FileContent file = FileIO::read_File_Content((std::filesystem::path(directory) / path).string());
+                const std::string extension = std::filesystem::path(path).extension().string();
+                const bool skipCompression = std::find(settings.storedExtensions.begin(), settings.storedExtensions.end(), extension) != settings.storedExtensions.end();
+
+                std::vector<uint8_t> compressed;
+                if (settings.compress && !skipCompression && (file.size() != 0)) compressed = FileCompression::compress(file.data(), file.size());
+                const bool isCompressed = !compressed.empty() && (compressed.size() <= file.size() - file.size() / 8);
+
+                const uint8_t*const stored = isCompressed ? compressed.data() : file.data();
+                const uint64_t storedSize = isCompressed ? compressed.size() : file.size();
+                write(stored, storedSize);
+
+                const uint64_t size = file.size();
+                const uint8_t flags = isCompressed ? _FLAG_COMPRESSED : 0;
+                const uint16_t pathLength = static_cast<uint16_t>(path.length());
+                const size_t head = directoryData.size();
+                directoryData.resize(head + _ENTRY_HEADER_SIZE + pathLength);
+                std::memcpy(directoryData.data() + head, &offset, sizeof(offset));
+                std::memcpy(directoryData.data() + head + sizeof(uint64_t), &storedSize, sizeof(storedSize));
+                std::memcpy(directoryData.data() + head + 2 * sizeof(uint64_t), &size, sizeof(size));
+                std::memcpy(directoryData.data() + head + 3 * sizeof(uint64_t), &flags, sizeof(flags));
+                std::memcpy(directoryData.data() + head + 3 * sizeof(uint64_t) + sizeof(flags), &pathLength, sizeof(pathLength));
+                std::memcpy(directoryData.data() + head + _ENTRY_HEADER_SIZE, path.data(), pathLength);
+
+                // Pad to the next page, so every entry can be mapped on its own
+                const uint64_t next = _align_To_Page(offset + storedSize);
+                write(padding.data(), next - offset - storedSize);
+                offset = next;
+
+                ++result.entries;
+                if (isCompressed) ++result.compressedEntries;
+                result.inputBytes += size;
+            }
+            result.archiveBytes = offset;
+
+            const uint32_t entryCount = static_cast<uint32_t>(paths.size()), reserved = 0;
+            const uint64_t dataOffset = _align_To_Page(_HEADER_SIZE + directorySize);
+            _seek(archive, 0, tempPath);
+            write(MAGIC, sizeof(MAGIC) - 1);
+            write(&entryCount, sizeof(entryCount));
+            write(&reserved, sizeof(reserved));
+            write(&directorySize, sizeof(directorySize));
+            write(&dataOffset, sizeof(dataOffset));
+            write(directoryData.data(), directoryData.size());
+            FileIO::sync_File(archive, tempPath);
+        } catch (...) {
+            std::fclose(archive);
+            std::remove(tempPath.c_str());
+            throw;
+        }
+
+        if (std::fclose(archive)) {
+            std::stringstream error;
+            error << "Could not close file \"" << tempPath << "\": " << std::strerror(errno);
+            std::remove(tempPath.c_str());
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        try {
+            FileIO::replace_File(tempPath, archivePath);
+        } catch (...) {
+            std::remove(tempPath.c_str());
+            throw;
+        }
+        return result;
+    }
+}
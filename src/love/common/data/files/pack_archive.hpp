@@ -0,0 +1,75 @@
+#ifndef LOVE_PACK_ARCHIVE_HPP
+#define LOVE_PACK_ARCHIVE_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace love_engine {
+    // Read-only archive of many files, memory mapped as a whole.
+    // Layout: a header, a directory sorted by path, then every entry's data starting on a page boundary.
+    // Entries are stored raw, so they can be used straight from the mapping, or compressed with FileCompression.
+    // Paths are relative to the packed directory and use '/' separators.
+    // Thread-safe after construction.
+    class PackArchive {
+        public:
+            typedef struct Entry_ {
+                // Points into the mapping
+                std::string_view path;
+                uint64_t offset;
+                uint64_t storedSize;
+                uint64_t size;
+                bool compressed;
+            } Entry;
+
+            typedef struct Pack_Settings_ {
+                bool compress = true;
+                // Stored raw regardless, since they are compressed already
+                std::vector<std::string> storedExtensions = {".xz", ".png", ".jpg", ".ogg", ".mp3", ".zip"};
+            } Pack_Settings;
+
+            typedef struct Pack_Result_ {
+                size_t entries = 0;
+                size_t compressedEntries = 0;
+                uint64_t inputBytes = 0;
+                uint64_t archiveBytes = 0;
+            } Pack_Result;
+
+            // @throw std::runtime_error If the file cannot be mapped or is not a pack archive.
+            PackArchive(const std::string& filePath);
+            PackArchive(PackArchive const&) = delete;
+            void operator=(PackArchive const&) = delete;
+            ~PackArchive();
+
+            // @return Null if there is no entry at @p path.
+            const Entry* find(const std::string_view path) const noexcept;
+            bool contains(const std::string_view path) const noexcept { return find(path) != nullptr; }
+            const std::vector<Entry>& get_Entries() const noexcept { return _entries; }
+
+            // @return Data of an uncompressed entry straight from the mapping, or empty if it is missing or compressed.
+            std::span<const uint8_t> get_View(const std::string_view path) const noexcept;
+            // @throw std::invalid_argument If there is no entry at @p path.
+            // @throw std::runtime_error If the entry cannot be decompressed.
+            std::vector<uint8_t> read(const std::string_view path) const;
+
+            // Packs every file under @p directory into a new archive at @p archivePath, replacing it atomically.
+            // Entries are compressed only when that saves at least an eighth of their size.
+            // @throw std::runtime_error If a file error occurs.
+            static Pack_Result pack(const std::string& directory, const std::string& archivePath, const Pack_Settings& settings);
+
+            static constexpr char MAGIC[] = "LOVEPAK1";
+            // Entry data starts on multiples of this
+            static constexpr uint64_t PAGE_ALIGNMENT = 4096;
+
+        private:
+            void _unmap() noexcept;
+
+            const uint8_t* _data = nullptr;
+            size_t _size = 0;
+            std::vector<Entry> _entries;
+    };
+}
+
+#endif // LOVE_PACK_ARCHIVE_HPP
@@ -2,19 +2,40 @@
 
 #include "../love_engine_instance.hpp"
 #include "../data/files/file_io.hpp"
+#include "../data/files/logger.hpp"
 #include "../system/system_info.hpp"
 #include "../system/thread.hpp"
+#include "crash_dump.hpp"
 #include "stack_trace.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <csignal>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <mutex>
 #include <stdexcept>
 #include <sstream>
+#include <thread>
 #include <sys/time.h>
 
+#ifndef _WIN32
+#include <execinfo.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#endif
+
 namespace love_engine {
     volatile bool _crashed = false;
     std::string _crashDir(".");
@@ -158,4 +179,469 @@ namespace love_engine {
         }
         throw std::logic_error(StackTrace::append_Stacktrace(message));
     }
+
+    static const int _FATAL_SIGNALS[] = {
+        SIGILL, SIGFPE, SIGSEGV, SIGABRT,
+#ifdef SIGBUS
+        SIGBUS,
+#endif
+    };
+    // Ask the program to shut down normally rather than crash
+    static const int _STOP_SIGNALS[] = {SIGINT, SIGTERM};
+
+    static std::atomic<int> _stopSignals = 0;
+    static std::mutex _stopMutex;
+    static std::function<void()> _stopFunction;
+    static bool _stopRequested = false;
+
+    static void _request_Stop() noexcept {
+        std::function<void()> stopFunction;
+        {
+            std::lock_guard<std::mutex> lock(_stopMutex);
+            _stopRequested = true;
+            stopFunction = _stopFunction;
+        }
+        if (stopFunction) stopFunction();
+    }
+
+    void Crash::set_Stop_Function(const std::function<void()>& stopFunction) noexcept {
+        bool stopRequested;
+        {
+            std::lock_guard<std::mutex> lock(_stopMutex);
+            _stopFunction = stopFunction;
+            stopRequested = _stopRequested;
+        }
+        if (stopRequested && stopFunction) stopFunction();
+    }
+
+    static const char* _get_Signal_Description(const int signum) noexcept {
+        switch (signum) {
+            case SIGILL: return "(SIGILL) Illegal processor instruction.";
+            case SIGFPE: return "(SIGFPE) Floating point exception caused by overflow/underflow or division by zero.";
+            case SIGSEGV: return "(SIGSEGV) Attempted to read/write memory whose address was not allocated or accessible.";
+            case SIGABRT: return "(SIGABRT) Abort signal was raised.";
+#ifdef SIGBUS
+            case SIGBUS: return "(SIGBUS) Attempted to access memory that is misaligned or not backed by a file.";
+#endif
+            default: return "Unknown signal was raised.";
+        }
+    }
+
+#ifdef _WIN32
+    [[noreturn]] void _signal_Handler(int signum) {
+        Crash::crash(_get_Signal_Description(signum));
+    }
+
+    // Windows runs SIGINT handlers on a thread of their own, so the stop function can run here
+    void _stop_Signal_Handler(int signum) {
+        if (_stopSignals.fetch_add(1) > 0) {
+            std::signal(signum, SIG_DFL);
+            std::raise(signum);
+            return;
+        }
+        std::signal(signum, _stop_Signal_Handler);
+        _request_Stop();
+    }
+
+    void Crash::install_Signal_Handlers() noexcept {
+        for (const int signum : _FATAL_SIGNALS) std::signal(signum, _signal_Handler);
+        for (const int signum : _STOP_SIGNALS) std::signal(signum, _stop_Signal_Handler);
+    }
+
+    void Crash::add_Signal_Stack() noexcept {}
+    void Crash::remove_Signal_Stack() noexcept {}
+#else
+    static constexpr size_t _SIGNAL_STACK_SIZE = 64 * 1024;
+    static constexpr int _MAX_SIGNAL_FRAMES = 128;
+    // Longest the forked child may take to write the full report. The process holds its resources, e.g. its
+    // ports, until then.
+    static constexpr int _FULL_REPORT_TIMEOUT_MS = 250;
+
+    // NOTE: Everything the signal handler touches is allocated before it runs.
+    static std::atomic<long> _signalThread = 0;
+    static char _signalReport[8192];
+    static char _signalPath[4096];
+    static char _signalFullPath[4096];
+    static char _signalDumpPath[4096];
+    static void* _signalFrames[_MAX_SIGNAL_FRAMES];
+    static thread_local void* _signalStack = nullptr;
+    // Stop signals write a byte here, and a thread reading it calls the stop function outside the handler
+    static int _stopPipe[2] = {-1, -1};
+
+    // Appends to a fixed buffer, truncating when full. Async-signal-safe.
+    struct Signal_Buffer {
+        char* data;
+        size_t capacity;
+        size_t length = 0;
+
+        void append(const char* text, const size_t count) noexcept {
+            const size_t copied = std::min(count, capacity - 1 - length);
+            std::memcpy(data + length, text, copied);
+            length += copied;
+            data[length] = '\0';
+        }
+        void append(const char* text) noexcept { append(text, std::strlen(text)); }
+        void append_Number(uint64_t value, const unsigned base = 10, const size_t minDigits = 1) noexcept {
+            char digits[64];
+            size_t count = 0;
+            do {
+                digits[count++] = "0123456789abcdef"[value % base];
+                value /= base;
+            } while ((value != 0) || (count < minDigits));
+            while (count > 0) append(&digits[--count], 1);
+        }
+    };
+
+    typedef struct UTC_Time_ {
+        int64_t year;
+        unsigned month, day, hour, minute, second;
+    } UTC_Time;
+
+    // localtime() takes a lock, so crash times from signals are in UTC.
+    static UTC_Time _get_UTC_Time(const int64_t seconds) noexcept {
+        int64_t days = seconds / 86400, daySeconds = seconds % 86400;
+        if (daySeconds < 0) {
+            daySeconds += 86400;
+            --days;
+        }
+
+        // Civil date from days since 1970-01-01, after Howard Hinnant's date algorithms
+        days += 719468;
+        const int64_t era = ((days >= 0) ? days : days - 146096) / 146097;
+        const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+        const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+
+        UTC_Time time;
+        time.day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        time.month = (monthIndex < 10) ? monthIndex + 3 : monthIndex - 9;
+        time.year = static_cast<int64_t>(yearOfEra) + era * 400 + (time.month <= 2);
+        time.hour = static_cast<unsigned>(daySeconds / 3600);
+        time.minute = static_cast<unsigned>(daySeconds / 60 % 60);
+        time.second = static_cast<unsigned>(daySeconds % 60);
+        return time;
+    }
+
+    static long _get_Thread_Id() noexcept {
+#ifdef __linux__
+        return syscall(SYS_gettid);
+#else
+        return static_cast<long>(getpid());
+#endif
+    }
+
+    static uint64_t _get_Instruction_Address([[maybe_unused]] const void* context) noexcept {
+#if defined(__linux__) && defined(__x86_64__)
+        return static_cast<uint64_t>(static_cast<const ucontext_t*>(context)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__linux__) && defined(__aarch64__)
+        return static_cast<uint64_t>(static_cast<const ucontext_t*>(context)->uc_mcontext.pc);
+#else
+        return 0;
+#endif
+    }
+
+    static void _write_All(const int fd, const char* data, size_t length) noexcept {
+        while (length > 0) {
+            const ssize_t written = write(fd, data, length);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+    }
+
+    // Builds the report path the same way _get_Crash_Path() does, and the path of the full report next to it.
+    static void _set_Signal_Paths(const UTC_Time& time) noexcept {
+        Signal_Buffer path{.data = _signalPath, .capacity = sizeof(_signalPath)};
+        if (!_crashPath.empty()) path.append(_crashPath.c_str(), _crashPath.length());
+        else {
+            path.append(_crashDir.c_str(), _crashDir.length());
+            path.append("/crash-");
+            path.append_Number(static_cast<uint64_t>(time.year), 10, 4);
+            path.append("-");
+            path.append_Number(time.month, 10, 2);
+            path.append("-");
+            path.append_Number(time.day, 10, 2);
+            path.append("_");
+            path.append_Number(time.hour, 10, 2);
+            path.append(".");
+            path.append_Number(time.minute, 10, 2);
+            path.append(".");
+            path.append_Number(time.second, 10, 2);
+            path.append(".txt");
+        }
+
+        // crash-....txt -> crash-...-full.txt
+        const char* slash = std::strrchr(_signalPath, '/');
+        const char* extension = std::strrchr(_signalPath, '.');
+        const size_t stem = ((extension != nullptr) && ((slash == nullptr) || (extension > slash))) ? static_cast<size_t>(extension - _signalPath) : path.length;
+        Signal_Buffer fullPath{.data = _signalFullPath, .capacity = sizeof(_signalFullPath)};
+        fullPath.append(_signalPath, stem);
+        fullPath.append("-full");
+        fullPath.append(_signalPath + stem);
+        Signal_Buffer dumpPath{.data = _signalDumpPath, .capacity = sizeof(_signalDumpPath)};
+        dumpPath.append(_signalPath, stem);
+        dumpPath.append(".dmp");
+
+        // Create missing directories one level at a time
+        for (size_t i = 1; i < path.length; ++i) {
+            if (_signalPath[i] != '/') continue;
+            _signalPath[i] = '\0';
+            mkdir(_signalPath, 0755);
+            _signalPath[i] = '/';
+        }
+    }
+
+    static void _write_Signal_Report(const int fd, const Signal_Buffer& report, const int frameCount) noexcept {
+        _write_All(fd, report.data, report.length);
+        // The probe runs in the background, so a crash during startup may come before it finishes
+        const char* systemInfo = SystemInfo::get_Consolidated_System_Info_If_Ready();
+        if (systemInfo == nullptr) systemInfo = "Not probed yet.";
+        _write_All(fd, systemInfo, std::strlen(systemInfo));
+        static const char stackHeader[] = "\n\n---- Stack Trace -----\n";
+        _write_All(fd, stackHeader, sizeof(stackHeader) - 1);
+        // Writes module, symbol and raw address of every frame without allocating
+        backtrace_symbols_fd(_signalFrames, frameCount, fd);
+        static const char fullHeader[] = "\nFull report: ";
+        _write_All(fd, fullHeader, sizeof(fullHeader) - 1);
+        _write_All(fd, _signalFullPath, std::strlen(_signalFullPath));
+        static const char dumpHeader[] = "\nDump (symbolize with crashsym): ";
+        _write_All(fd, dumpHeader, sizeof(dumpHeader) - 1);
+        _write_All(fd, _signalDumpPath, std::strlen(_signalDumpPath));
+        _write_All(fd, "\n", 1);
+    }
+
+    // The child writes the parts that need no allocation and no lock first, so they survive a deadlock in the
+    // symbolization after them. A lock held by a thread that did not fork with it, including the allocator's, would
+    // hang the child, so it is killed once the timeout passes.
+    static void _write_Full_Report(const Signal_Buffer& report) noexcept {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 34)
+        // Unlike fork(), runs no atfork handlers, which may take the allocator lock
+        const pid_t child = _Fork();
+#else
+        const pid_t child = fork();
+#endif
+        if (child < 0) return;
+
+        if (child == 0) {
+            for (const int fatal : _FATAL_SIGNALS) std::signal(fatal, SIG_DFL);
+            const int file = open(_signalFullPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (file < 0) _exit(EXIT_FAILURE);
+
+            _write_All(file, report.data, report.length);
+            const char* systemInfo = SystemInfo::get_Consolidated_System_Info_If_Ready();
+            if (systemInfo == nullptr) systemInfo = "Not probed yet.";
+            _write_All(file, systemInfo, std::strlen(systemInfo));
+
+            static const char logHeader[] = "\n\n---- Recent Log Messages -----\n";
+            _write_All(file, logHeader, sizeof(logHeader) - 1);
+            char message[Logger::RECENT_MESSAGE_SIZE];
+            for (size_t i = 0; i < Logger::RECENT_MESSAGES; ++i) {
+                const size_t length = Logger::get_Recent_Message(i, message, sizeof(message));
+                if (length == 0) continue;
+                _write_All(file, message, length);
+                if (message[length - 1] != '\n') _write_All(file, "\n", 1);
+            }
+
+            // Allocates, so last
+            static const char stackHeader[] = "\n---- Stack Trace -----\n";
+            _write_All(file, stackHeader, sizeof(stackHeader) - 1);
+            try {
+                const std::string stackTrace = StackTrace::get_Stacktrace();
+                _write_All(file, stackTrace.data(), stackTrace.length());
+                _write_All(file, "\n", 1);
+            } catch (...) {}
+            close(file);
+            _exit(EXIT_SUCCESS);
+        }
+
+        for (int waited = 0; waitpid(child, nullptr, WNOHANG) == 0; waited += 10) {
+            if (waited >= _FULL_REPORT_TIMEOUT_MS) {
+                kill(child, SIGKILL);
+                waitpid(child, nullptr, 0);
+                return;
+            }
+            const timespec delay{.tv_sec = 0, .tv_nsec = 10 * 1000 * 1000};
+            nanosleep(&delay, nullptr);
+        }
+    }
+
+    static void _signal_Handler(const int signum, siginfo_t* info, void* context) noexcept {
+        const int savedErrno = errno;
+        const long self = _get_Thread_Id();
+        long owner = 0;
+        if (!_signalThread.compare_exchange_strong(owner, self)) {
+            // Faulted while reporting, so give up on the report
+            if (owner == self) _exit(128 + signum);
+            // Another thread is reporting and will end the process
+            for (;;) pause();
+        }
+        _crashed = true;
+
+        const int frameCount = backtrace(_signalFrames, _MAX_SIGNAL_FRAMES);
+        timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        const UTC_Time time = _get_UTC_Time(static_cast<int64_t>(now.tv_sec));
+        _set_Signal_Paths(time);
+
+        Signal_Buffer report{.data = _signalReport, .capacity = sizeof(_signalReport)};
+        report.append("---- Crash Report ----\n// ");
+        if (!_flavorTexts.empty()) {
+            const std::string& flavorText = _flavorTexts[static_cast<size_t>(now.tv_nsec) % _flavorTexts.size()];
+            report.append(flavorText.c_str(), flavorText.length());
+        }
+        report.append("\n\nTime: ");
+        report.append_Number(static_cast<uint64_t>(time.year), 10, 4);
+        report.append("-");
+        report.append_Number(time.month, 10, 2);
+        report.append("-");
+        report.append_Number(time.day, 10, 2);
+        report.append(" ");
+        report.append_Number(time.hour, 10, 2);
+        report.append(":");
+        report.append_Number(time.minute, 10, 2);
+        report.append(":");
+        report.append_Number(time.second, 10, 2);
+        report.append(".");
+        report.append_Number(static_cast<uint64_t>(now.tv_nsec / 1000), 10, 6);
+        report.append(" UTC\nCrashing Thread: ");
+#ifdef __linux__
+        // Thread sets native names, which the kernel hands out without locking
+        char threadName[17] = "";
+        prctl(PR_GET_NAME, threadName, 0, 0, 0);
+        report.append(threadName);
+        report.append(" ");
+#endif
+        report.append("(");
+        report.append_Number(static_cast<uint64_t>(self));
+        report.append(")\nDescription: ");
+        report.append(_get_Signal_Description(signum));
+        if ((signum == SIGILL) || (signum == SIGFPE) || (signum == SIGSEGV) || (signum == SIGBUS)) {
+            report.append(" Fault address: 0x");
+            report.append_Number(reinterpret_cast<uintptr_t>(info->si_addr), 16);
+            report.append(".");
+        }
+        report.append("\n\n--- System Details ---\n");
+
+        _write_Signal_Report(STDERR_FILENO, report, frameCount);
+        const int file = open(_signalPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (file >= 0) {
+            _write_Signal_Report(file, report, frameCount);
+            close(file);
+        }
+
+        const int dumpFile = open(_signalDumpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (dumpFile >= 0) {
+            CrashDump::Header header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, CrashDump::MAGIC, sizeof(header.magic));
+            header.version = CrashDump::VERSION;
+            header.signal = signum;
+            header.code = info->si_code;
+            header.faultAddress = reinterpret_cast<uintptr_t>(info->si_addr);
+            header.instructionAddress = _get_Instruction_Address(context);
+            header.timeSeconds = static_cast<int64_t>(now.tv_sec);
+            header.timeNanoseconds = static_cast<int64_t>(now.tv_nsec);
+            header.crashingThread = static_cast<int64_t>(self);
+            CrashDump::write(dumpFile, header, _signalFrames, frameCount);
+            close(dumpFile);
+        }
+
+        _write_Full_Report(report);
+
+        // The default action ends the process once the handler returns, dumping core where enabled
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = SIG_DFL;
+        sigemptyset(&action.sa_mask);
+        sigaction(signum, &action, nullptr);
+        errno = savedErrno;
+        raise(signum);
+    }
+
+    static void _stop_Signal_Handler(const int signum) noexcept {
+        const int savedErrno = errno;
+        if (_stopSignals.fetch_add(1) > 0) {
+            // Asked twice, so stop waiting for a clean shutdown
+            struct sigaction action;
+            std::memset(&action, 0, sizeof(action));
+            action.sa_handler = SIG_DFL;
+            sigemptyset(&action.sa_mask);
+            sigaction(signum, &action, nullptr);
+            raise(signum);
+        } else {
+            const char byte = 0;
+            [[maybe_unused]] const ssize_t written = write(_stopPipe[1], &byte, 1);
+        }
+        errno = savedErrno;
+    }
+
+    void Crash::install_Signal_Handlers() noexcept {
+        // backtrace() loads its unwinder on first use, which allocates
+        backtrace(_signalFrames, 1);
+        add_Signal_Stack();
+
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_sigaction = _signal_Handler;
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+        for (const int signum : _FATAL_SIGNALS) sigaction(signum, &action, nullptr);
+
+        if (_stopPipe[0] >= 0) return;
+        if (pipe(_stopPipe)) {
+            _stopPipe[0] = _stopPipe[1] = -1;
+            return;
+        }
+        for (const int fd : _stopPipe) fcntl(fd, F_SETFD, FD_CLOEXEC);
+        // Not a Thread, as it blocks until a stop is requested and must not count as open
+        std::thread([]() {
+            char byte;
+            while (read(_stopPipe[0], &byte, 1) < 0) {
+                if (errno != EINTR) return;
+            }
+            _request_Stop();
+        }).detach();
+
+        struct sigaction stopAction;
+        std::memset(&stopAction, 0, sizeof(stopAction));
+        stopAction.sa_handler = _stop_Signal_Handler;
+        stopAction.sa_flags = SA_RESTART;
+        sigemptyset(&stopAction.sa_mask);
+        for (const int signum : _STOP_SIGNALS) sigaction(signum, &stopAction, nullptr);
+    }
+
+    void Crash::add_Signal_Stack() noexcept {
+        // Leaves stacks set up by others, e.g. sanitizers, in place
+        stack_t current;
+        if (sigaltstack(nullptr, &current) || !(current.ss_flags & SS_DISABLE)) return;
+
+        stack_t stack;
+        stack.ss_sp = std::malloc(_SIGNAL_STACK_SIZE);
+        if (stack.ss_sp == nullptr) return;
+        stack.ss_size = _SIGNAL_STACK_SIZE;
+        stack.ss_flags = 0;
+        if (sigaltstack(&stack, nullptr)) {
+            std::free(stack.ss_sp);
+            return;
+        }
+        _signalStack = stack.ss_sp;
+    }
+
+    void Crash::remove_Signal_Stack() noexcept {
+        if (_signalStack == nullptr) return;
+        stack_t current;
+        if (sigaltstack(nullptr, &current) || (current.ss_sp != _signalStack) || (current.ss_flags & SS_ONSTACK)) return;
+
+        stack_t disable;
+        std::memset(&disable, 0, sizeof(disable));
+        disable.ss_flags = SS_DISABLE;
+        if (sigaltstack(&disable, nullptr)) return;
+        std::free(_signalStack);
+        _signalStack = nullptr;
+    }
+#endif
 }
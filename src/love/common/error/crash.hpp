@@ -14,6 +14,24 @@ namespace love_engine {
             static void set_Flavor_Texts(const std::vector<std::string>& flavorTexts) noexcept;
             // @throw std::logic_error If a crash is already initiated.
             [[noreturn]] static void crash(const std::string& message);
+
+            // Installs handlers for fatal signals: SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT. The handler writes a short report with raw stack frames to
+            // stderr and the crash directory, and a CrashDump next to it, without allocating, locking or throwing,
+            // so a fault while a lock is held cannot hang the process. A forked child then writes a "-full" report
+            // with the recent log messages and a symbolized stack, and is killed if it takes longer than a moment.
+            // The crash function is not called. Exit callbacks are not run; the signal is raised again so the
+            // process exits with it.
+            // SIGINT and SIGTERM are not crashes; they call the stop function instead.
+            // Called by LoveEngineInstance::init().
+            static void install_Signal_Handlers() noexcept;
+            // Calls @p stopFunction on a background thread once SIGINT or SIGTERM arrives, so the program can shut
+            // down and run its exit callbacks. Calls it right away if one already arrived. A second signal ends the
+            // process at once.
+            static void set_Stop_Function(const std::function<void()>& stopFunction) noexcept;
+            // Gives the calling thread an alternate stack for signal handlers, so stack overflows are reported too.
+            // Called by Thread for every thread it runs.
+            static void add_Signal_Stack() noexcept;
+            static void remove_Signal_Stack() noexcept;
     };
 }
 
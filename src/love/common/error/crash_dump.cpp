@@ -0,0 +1,225 @@
+#include "crash_dump.hpp"
+
+#include "../data/files/file_io.hpp"
+#include "../data/files/logger.hpp"
+#include "stack_trace.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace love_engine {
+#ifndef _WIN32
+    static void _write_All(const int fd, const void* data, size_t length) noexcept {
+        const char* bytes = static_cast<const char*>(data);
+        while (length > 0) {
+            const ssize_t written = ::write(fd, bytes, length);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            bytes += written;
+            length -= static_cast<size_t>(written);
+        }
+    }
+
+    static void _write_Record(const int fd, const CrashDump::Record_Type type, const void* prefix, const size_t prefixLength, const char* text, const size_t textLength) noexcept {
+        const CrashDump::Record_Header header{.type = type, .length = static_cast<uint32_t>(prefixLength + textLength)};
+        _write_All(fd, &header, sizeof(header));
+        if (prefixLength > 0) _write_All(fd, prefix, prefixLength);
+        if (textLength > 0) _write_All(fd, text, textLength);
+    }
+
+    // @return Characters consumed.
+    static size_t _parse_Hex(const char* text, const size_t length, uint64_t& value) noexcept {
+        value = 0;
+        size_t i = 0;
+        for (; i < length; ++i) {
+            const char c = text[i];
+            if ((c >= '0') && (c <= '9')) value = (value << 4) | static_cast<uint64_t>(c - '0');
+            else if ((c >= 'a') && (c <= 'f')) value = (value << 4) | static_cast<uint64_t>(c - 'a' + 10);
+            else break;
+        }
+        return i;
+    }
+
+    // "start-end perms offset dev inode path", keeping executable mappings of files
+    static void _write_Module_Line(const int fd, const char* line, const size_t length) noexcept {
+        CrashDump::Module_Record module;
+        size_t i = _parse_Hex(line, length, module.start);
+        if ((i >= length) || (line[i] != '-')) return;
+        ++i;
+        i += _parse_Hex(line + i, length - i, module.end);
+        if ((i + 5 >= length) || (line[i + 3] != 'x')) return;
+        i += 6;
+        i += _parse_Hex(line + i, length - i, module.offset);
+
+        // Skip dev and inode to the path
+        for (int field = 0; field < 2; ++field) {
+            while ((i < length) && (line[i] == ' ')) ++i;
+            while ((i < length) && (line[i] != ' ')) ++i;
+        }
+        while ((i < length) && (line[i] == ' ')) ++i;
+        if (i >= length) return;
+        _write_Record(fd, CrashDump::Record_Type::MODULE, &module, sizeof(module), line + i, length - i);
+    }
+
+    static void _write_Modules(const int fd) noexcept {
+        const int maps = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+        if (maps < 0) return;
+
+        char buffer[4096];
+        char line[4096 + 256];
+        size_t lineLength = 0;
+        ssize_t count;
+        while (((count = read(maps, buffer, sizeof(buffer))) > 0) || ((count < 0) && (errno == EINTR))) {
+            for (ssize_t i = 0; i < count; ++i) {
+                if (buffer[i] == '\n') {
+                    _write_Module_Line(fd, line, lineLength);
+                    lineLength = 0;
+                } else if (lineLength < sizeof(line)) line[lineLength++] = buffer[i];
+            }
+        }
+        if (lineLength > 0) _write_Module_Line(fd, line, lineLength);
+        close(maps);
+    }
+
+    static void _write_Threads([[maybe_unused]] const int fd) noexcept {
+#ifdef __linux__
+        const int tasks = open("/proc/self/task", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (tasks < 0) return;
+
+        // readdir() allocates, so directory entries are read with the system call
+        alignas(8) char entries[4096];
+        long count;
+        while ((count = syscall(SYS_getdents64, tasks, entries, sizeof(entries))) > 0) {
+            for (long offset = 0; offset < count;) {
+                // struct linux_dirent64: ino64, off64, reclen, type, name
+                const char* entry = entries + offset;
+                unsigned short recordLength;
+                std::memcpy(&recordLength, entry + 16, sizeof(recordLength));
+                offset += recordLength;
+                const char* name = entry + 19;
+                if ((name[0] < '0') || (name[0] > '9')) continue;
+
+                int64_t id = 0;
+                for (const char* c = name; (*c >= '0') && (*c <= '9'); ++c) id = id * 10 + (*c - '0');
+
+                char path[64] = "/proc/self/task/";
+                const size_t nameLength = std::min<size_t>(std::strlen(name), sizeof(path) - sizeof("/proc/self/task//comm"));
+                std::memcpy(path + 16, name, nameLength);
+                std::memcpy(path + 16 + nameLength, "/comm", sizeof("/comm"));
+
+                char threadName[64];
+                ssize_t threadNameLength = 0;
+                const int comm = open(path, O_RDONLY | O_CLOEXEC);
+                if (comm >= 0) {
+                    threadNameLength = std::max<ssize_t>(0, read(comm, threadName, sizeof(threadName)));
+                    close(comm);
+                }
+                while ((threadNameLength > 0) && (threadName[threadNameLength - 1] == '\n')) --threadNameLength;
+                _write_Record(fd, CrashDump::Record_Type::THREAD, &id, sizeof(id), threadName, static_cast<size_t>(threadNameLength));
+            }
+        }
+        close(tasks);
+#endif
+    }
+
+    void CrashDump::write(const int fd, const Header& header, void* const* frames, const int frameCount) noexcept {
+        _write_All(fd, &header, sizeof(header));
+
+        uint64_t addresses[256];
+        const size_t addressCount = std::min<size_t>(std::max(frameCount, 0), sizeof(addresses) / sizeof(addresses[0]));
+        for (size_t i = 0; i < addressCount; ++i) addresses[i] = reinterpret_cast<uintptr_t>(frames[i]);
+        _write_Record(fd, Record_Type::FRAMES, addresses, addressCount * sizeof(uint64_t), nullptr, 0);
+
+        _write_Modules(fd);
+        _write_Threads(fd);
+
+        char message[Logger::RECENT_MESSAGE_SIZE];
+        for (size_t i = 0; i < Logger::RECENT_MESSAGES; ++i) {
+            const size_t length = Logger::get_Recent_Message(i, message, sizeof(message));
+            if (length > 0) _write_Record(fd, Record_Type::LOG_MESSAGE, nullptr, 0, message, length);
+        }
+
+        _write_Record(fd, Record_Type::END, nullptr, 0, nullptr, 0);
+    }
+#else
+    void CrashDump::write(const int, const Header&, void* const*, const int) noexcept {}
+#endif
+
+    CrashDump::Dump CrashDump::read(const std::string& filePath) {
+        const std::string data = FileIO::read_File(filePath);
+        auto invalid = [&filePath](const char* reason) {
+            std::stringstream error;
+            error << "Invalid crash dump \"" << filePath << "\": " << reason;
+            return std::runtime_error(StackTrace::append_Stacktrace(error));
+        };
+
+        Dump dump;
+        if (data.size() < sizeof(Header)) throw invalid("too short");
+        std::memcpy(&dump.header, data.data(), sizeof(Header));
+        if (std::memcmp(dump.header.magic, MAGIC, sizeof(MAGIC)) != 0) throw invalid("wrong magic");
+        if (dump.header.version != VERSION) throw invalid("unsupported version");
+
+        // A dump cut short by a second fault still holds what was written before it
+        size_t offset = sizeof(Header);
+        for (;;) {
+            Record_Header record;
+            if (data.size() - offset < sizeof(record)) return dump;
+            std::memcpy(&record, data.data() + offset, sizeof(record));
+            offset += sizeof(record);
+            if (data.size() - offset < record.length) return dump;
+            const char* payload = data.data() + offset;
+            offset += record.length;
+
+            switch (record.type) {
+                case Record_Type::FRAMES:
+                    dump.frames.resize(record.length / sizeof(uint64_t));
+                    std::memcpy(dump.frames.data(), payload, dump.frames.size() * sizeof(uint64_t));
+                    break;
+                case Record_Type::MODULE: {
+                    if (record.length < sizeof(Module_Record)) throw invalid("short module record");
+                    Module_Record module;
+                    std::memcpy(&module, payload, sizeof(module));
+                    dump.modules.push_back(Module{
+                        .start = module.start, .end = module.end, .offset = module.offset,
+                        .path = std::string(payload + sizeof(module), record.length - sizeof(module)),
+                    });
+                    break;
+                }
+                case Record_Type::THREAD: {
+                    if (record.length < sizeof(int64_t)) throw invalid("short thread record");
+                    int64_t id;
+                    std::memcpy(&id, payload, sizeof(id));
+                    dump.threads.push_back(Thread_Entry{.id = id, .name = std::string(payload + sizeof(id), record.length - sizeof(id))});
+                    break;
+                }
+                case Record_Type::LOG_MESSAGE:
+                    dump.logMessages.emplace_back(payload, record.length);
+                    break;
+                case Record_Type::END:
+                    return dump;
+                default:
+                    break; // NOTE: Records from newer writers are skipped.
+            }
+        }
+    }
+
+    const CrashDump::Module* CrashDump::find_Module(const Dump& dump, const uint64_t address) noexcept {
+        const auto module = std::find_if(dump.modules.begin(), dump.modules.end(), [address](const Module& module) {
+            return (address >= module.start) && (address < module.end);
+        });
+        return (module == dump.modules.end()) ? nullptr : &*module;
+    }
+}
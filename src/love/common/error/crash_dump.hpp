@@ -0,0 +1,88 @@
+#ifndef LOVE_CRASH_DUMP_HPP
+#define LOVE_CRASH_DUMP_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    // Compact binary snapshot of a crash: raw return addresses, the executable modules mapped at the time, thread
+    // names and the last log messages. Written by the crash signal handler next to the text report and symbolized
+    // offline by crashsym, so crash handling stays bounded and stripped builds can still be diagnosed.
+    //
+    // Layout: Header, then records of a Record_Header and its payload, ending with an END record.
+    class CrashDump {
+        public:
+            static constexpr char MAGIC[8] = {'L', 'O', 'V', 'E', 'D', 'M', 'P', '\0'};
+            static constexpr uint32_t VERSION = 1;
+
+            enum class Record_Type : uint32_t {
+                // uint64_t return addresses, innermost first
+                FRAMES = 1,
+                // Module_Record followed by the path
+                MODULE = 2,
+                // int64_t thread id followed by the name
+                THREAD = 3,
+                // Message text
+                LOG_MESSAGE = 4,
+                END = 5,
+            };
+
+            typedef struct Header_ {
+                char magic[8];
+                uint32_t version;
+                int32_t signal;
+                int32_t code;
+                uint32_t reserved;
+                uint64_t faultAddress;
+                // Instruction that faulted, or 0 if unknown. Frames before it are in the signal handler.
+                uint64_t instructionAddress;
+                int64_t timeSeconds;
+                int64_t timeNanoseconds;
+                int64_t crashingThread;
+            } Header;
+
+            typedef struct Record_Header_ {
+                Record_Type type;
+                uint32_t length;
+            } Record_Header;
+
+            typedef struct Module_Record_ {
+                uint64_t start;
+                uint64_t end;
+                // Offset into the file that start maps
+                uint64_t offset;
+            } Module_Record;
+
+            typedef struct Module_ {
+                uint64_t start;
+                uint64_t end;
+                uint64_t offset;
+                std::string path;
+            } Module;
+
+            typedef struct Thread_Entry_ {
+                int64_t id;
+                std::string name;
+            } Thread_Entry;
+
+            typedef struct Dump_ {
+                Header header;
+                std::vector<uint64_t> frames;
+                std::vector<Module> modules;
+                std::vector<Thread_Entry> threads;
+                std::vector<std::string> logMessages;
+            } Dump;
+
+            // Async-signal-safe. Reads /proc/self directly and only uses stack memory. Does nothing on Windows.
+            static void write(const int fd, const Header& header, void* const* frames, const int frameCount) noexcept;
+
+            // @throw std::runtime_error If the file cannot be read or is not a valid dump.
+            static Dump read(const std::string& filePath);
+
+            // @return Module mapping @p address, or nullptr.
+            static const Module* find_Module(const Dump& dump, const uint64_t address) noexcept;
+    };
+}
+
+#endif // LOVE_CRASH_DUMP_HPP
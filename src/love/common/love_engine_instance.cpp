@@ -1,61 +1,75 @@
 #include "love_engine_instance.hpp"
 
-#include <csignal>
-#include <stack>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
 #include <thread>
 
+#include "data/files/logger.hpp"
 #include "error/crash.hpp"
+#include "system/metrics.hpp"
 #include "system/system_info.hpp"
 #include "system/thread.hpp"
 
 namespace love_engine {
-    std::stack<std::function<void()>> _callbacks;
+    ShutdownRegistry _exitCallbacks;
 
-    [[noreturn]] void _signal_Handler(int signum) {
-        switch (signum) {
-            case SIGINT:
-                Crash::crash("(SIGINT) Received interrupt signal.");
-            case SIGILL:
-                Crash::crash("(SIGILL) Illegal processor instruction.");
-            case SIGFPE:
-                Crash::crash("(SIGFPE) Floating point exception caused by overflow/underflow or division by zero.");
-            case SIGSEGV:
-                Crash::crash("(SIGSEGV) Attempted to read/write memory whose address was not allocated or accessible.");
-            case SIGABRT:
-                Crash::crash("(SIGABRT) Abort signal was raised.");
-            case SIGTERM:
-                Crash::crash("(SIGTERM) Received termination signal. Closing.");
-            default:
-                Crash::crash("Unknown signal was raised.");
+    void LoveEngineInstance::init(const std::string& crashDirectory, StartupGraph& steps, const Logger* logger) noexcept {
+        // Before any step runs, so faults in the steps are reported too. Signal stacks belong to the thread that
+        // sets them up, and this is the main thread.
+        Crash::install_Signal_Handlers();
+        try {
+            // Thread names belong to the thread that sets them up
+            steps.add_Step(StartupGraph::Step{
+                .name = "main_thread",
+                .run = []() { Thread::register_Thread(std::this_thread::get_id(), "Main"); },
+                .mainThread = true,
+            });
+            // Already done, but kept so steps can still depend on it
+            steps.add_Step(StartupGraph::Step{.name = "signal_handlers", .run = []() {}});
+            // Only starts the probe. Steps reading SystemInfo wait for it in its getters, so the rest start at once.
+            steps.add_Step(StartupGraph::Step{.name = "system_info", .run = []() { SystemInfo::start_Probe(); }});
+            steps.add_Step(StartupGraph::Step{.name = "executable_directory", .run = []() { FileIO::get_Executable_Directory(); }});
+            steps.add_Step(StartupGraph::Step{
+                .name = "crash_directory",
+                .dependencies = {"executable_directory"},
+                .run = [crashDirectory]() { Crash::set_Crash_Directory(crashDirectory); },
+            });
+            steps.add_Step(StartupGraph::Step{.name = "metrics", .run = []() {
+                Metrics::set_Gauge_Function("love_threads", "Threads started through Thread, including the main thread", []() {
+                    return static_cast<double>(Thread::get_Open_Thread_Count());
+                });
+            }});
+            // Steps mostly wait on the file system, so small machines still get a few threads
+            steps.run(std::max(4u, std::thread::hardware_concurrency()), logger);
+        } catch (const std::runtime_error& e) {
+            Crash::crash(e.what());
         }
     }
-
-    void _set_Signal_Handler() noexcept {
-        std::signal(SIGINT, _signal_Handler);
-        std::signal(SIGILL, _signal_Handler);
-        std::signal(SIGSEGV, _signal_Handler);
-        std::signal(SIGFPE, _signal_Handler);
-        std::signal(SIGABRT, _signal_Handler);
-        std::signal(SIGTERM, _signal_Handler);
-    }
-
-    void LoveEngineInstance::init(const std::string& crashDirectory) noexcept {
-        _set_Signal_Handler();
-        Thread::register_Thread(std::this_thread::get_id(), "Main");
-        SystemInfo::get_Consolidated_System_Info();
-        FileIO::get_Executable_Directory();
-        Crash::set_Crash_Directory(crashDirectory);
-    }
     
-    void LoveEngineInstance::cleanup() noexcept {
-        Thread::wait_For_Threads();
-        while (!_callbacks.empty()) {
-            _callbacks.top()();
-            _callbacks.pop();
+    void LoveEngineInstance::cleanup(const Logger* logger) noexcept {
+        const size_t running = _exitCallbacks.run(logger);
+        if (logger && (running > 0)) {
+            logger->log(Log_Status::WARNING, std::to_string(running) + " exit callback(s) still running. Exiting without destroying static objects.");
+        }
+        // Includes the shutdown report
+        Logger::wait_For_Writes(std::chrono::seconds(1));
+        if (running > 0) {
+            // exit() would destroy globals the hung callbacks may still use
+            std::fflush(nullptr);
+            std::_Exit(EXIT_FAILURE);
         }
     }
-    
-    void LoveEngineInstance::add_Exit_Callback(const std::function<void()>& callback) noexcept {
-        _callbacks.push(callback);
+
+    void LoveEngineInstance::add_Exit_Callback(const ShutdownRegistry::Callback& callback) noexcept {
+        try {
+            _exitCallbacks.add(callback);
+        } catch (const std::runtime_error& e) {
+            Crash::crash(e.what());
+        } catch (const std::invalid_argument& e) {
+            Crash::crash(e.what());
+        }
     }
 }
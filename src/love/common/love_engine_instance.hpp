@@ -2,6 +2,8 @@
 #define LOVE_LOVE_ENGINE_INSTANCE_HPP
 
 #include "data/files/file_io.hpp"
+#include "system/shutdown_registry.hpp"
+#include "system/startup_graph.hpp"
 
 #include <functional>
 
@@ -9,9 +11,27 @@ namespace love_engine {
     class LoveEngineInstance {
         public:
             static inline void init() noexcept { init(FileIO::get_Executable_Directory() + "crash-reports"); }
-            static void init(const std::string& crashDirectory) noexcept;
-            static void cleanup() noexcept;
-            static void add_Exit_Callback(const std::function<void()>& callback) noexcept;
+            static void init(const std::string& crashDirectory) noexcept {
+                StartupGraph steps;
+                init(crashDirectory, steps);
+            }
+            // Installs the signal handlers, then runs the engine's startup steps together with @p steps, which may
+            // depend on them by name: "signal_handlers", "main_thread", "system_info", "executable_directory",
+            // "crash_directory" and "metrics". "system_info" only starts the probe; SystemInfo's getters wait for it.
+            // Crashes if a step fails.
+            // @param logger If set, receives every step's timing.
+            static void init(const std::string& crashDirectory, StartupGraph& steps, const Logger* logger = nullptr) noexcept;
+            // Runs the exit callbacks, then waits briefly for log writes to finish.
+            // If a callback timed out, ends the process with EXIT_FAILURE instead of returning, so no static object
+            // is destroyed under it.
+            // @param logger If set, receives every timeout and every callback's duration.
+            static void cleanup(const Logger* logger = nullptr) noexcept;
+            // Crashes if a callback with the same name was already added, or if a dependency was not added yet.
+            static void add_Exit_Callback(const ShutdownRegistry::Callback& callback) noexcept;
+            // Runs in parallel with other callbacks, with the default priority and timeout.
+            static void add_Exit_Callback(const std::function<void()>& callback) noexcept {
+                add_Exit_Callback(ShutdownRegistry::Callback{.run = callback});
+            }
     };
 }
 
@@ -0,0 +1,92 @@
+#include "frame_arena.hpp"
+
+#include "memory_tracker.hpp"
+
+#include "../system/thread_placement.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <new>
+
+namespace love_engine {
+    std::atomic<uint64_t> FrameArena::_frame = 0;
+
+    static MemoryTracker::Counter& _get_Counter() noexcept {
+        static MemoryTracker::Counter& counter = MemoryTracker::get_Counter("frame_arena");
+        return counter;
+    }
+
+    FrameArena::~FrameArena() {
+        for (const Block& block : _blocks) {
+            ThreadPlacement::free_Local(block.data, block.size);
+            _get_Counter().add_Deallocation(block.size);
+        }
+    }
+
+    void* FrameArena::allocate(const size_t size, const size_t alignment) noexcept {
+        while (_current < _blocks.size()) {
+            Block& block = _blocks[_current];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            const uintptr_t address = (base + _offset + alignment - 1) & ~(alignment - 1);
+            if (address + size <= base + block.size) {
+                _offset = address + size - base;
+                return reinterpret_cast<void*>(address);
+            }
+            // Later blocks are reused from earlier frames before new ones are added
+            ++_current;
+            _offset = 0;
+        }
+
+        const size_t blockSize = std::max(_blockSize, size + alignment);
+        std::byte* data = static_cast<std::byte*>(ThreadPlacement::allocate_Local(blockSize));
+        if (data == nullptr) std::terminate(); // NOTE: allocate() is noexcept, so failing to get a NUMA-local block ends the process.
+        _blocks.push_back(Block{.data = data, .size = blockSize});
+        _get_Counter().add_Allocation(blockSize);
+        _current = _blocks.size() - 1;
+        _offset = 0;
+        return allocate(size, alignment);
+    }
+
+    void FrameArena::reset() noexcept {
+        _current = 0;
+        _offset = 0;
+    }
+
+    size_t FrameArena::get_Used() const noexcept {
+        size_t used = _offset;
+        for (size_t i = 0; (i < _current) && (i < _blocks.size()); ++i) used += _blocks[i].size;
+        return used;
+    }
+
+    size_t FrameArena::get_Capacity() const noexcept {
+        size_t capacity = 0;
+        for (const Block& block : _blocks) capacity += block.size;
+        return capacity;
+    }
+
+    FrameArena& FrameArena::get_Thread_Arena() noexcept {
+        thread_local FrameArena arena;
+        thread_local uint64_t arenaFrame = 0;
+
+        const uint64_t frame = get_Frame();
+        if (arenaFrame != frame) {
+            arena.reset();
+            arenaFrame = frame;
+        }
+        return arena;
+    }
+
+    class FrameResource : public std::pmr::memory_resource {
+        private:
+            void* do_allocate(const size_t size, const size_t alignment) override {
+                return FrameArena::get_Thread_Arena().allocate(size, alignment);
+            }
+            void do_deallocate(void*, const size_t, const size_t) override {}
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    std::pmr::memory_resource* FrameArena::get_Resource() noexcept {
+        static FrameResource resource;
+        return &resource;
+    }
+}
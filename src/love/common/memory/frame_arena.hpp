@@ -0,0 +1,64 @@
+#ifndef LOVE_FRAME_ARENA_HPP
+#define LOVE_FRAME_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace love_engine {
+    // Bump allocator for data that lives for one frame or tick. Allocating is a pointer increment and nothing
+    // is freed individually; reset() makes all memory reusable at once. Blocks are kept across resets, so a
+    // steady workload stops touching the heap after its first frames.
+    // Not thread-safe; every thread has its own arena from get_Thread_Arena(). Blocks are placed on the NUMA node
+    // of the thread that allocates them.
+    class FrameArena {
+        public:
+            FrameArena(const size_t blockSize = 256 * 1024) : _blockSize(blockSize) {}
+            FrameArena(FrameArena const&) = delete;
+            void operator=(FrameArena const&) = delete;
+            ~FrameArena();
+
+            // Never returns nullptr. Allocations larger than the block size get a block of their own.
+            // @param alignment Must be a power of two.
+            void* allocate(const size_t size, const size_t alignment = alignof(std::max_align_t)) noexcept;
+            template<class T, class... Args>
+            T* create(Args&&... args) noexcept { return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...); }
+
+            // Invalidates every allocation. Destructors are not run.
+            void reset() noexcept;
+
+            size_t get_Used() const noexcept;
+            size_t get_Capacity() const noexcept;
+
+            // Every thread's arena resets itself the next time it is used after this, invalidating the memory
+            // it handed out. Called once per tick by the server.
+            static void begin_Frame() noexcept { _frame.fetch_add(1, std::memory_order_release); }
+            static uint64_t get_Frame() noexcept { return _frame.load(std::memory_order_acquire); }
+
+            // @return The calling thread's arena, reset if a frame began since it was last used.
+            static FrameArena& get_Thread_Arena() noexcept;
+            // Allocates from the calling thread's arena; deallocation does nothing. For std::pmr containers
+            // that do not outlive the frame.
+            static std::pmr::memory_resource* get_Resource() noexcept;
+
+        private:
+            typedef struct Block_ {
+                // From ThreadPlacement::allocate_Local()
+                std::byte* data;
+                size_t size;
+            } Block;
+
+            const size_t _blockSize;
+            std::vector<Block> _blocks;
+            // Block being bumped and its offset
+            size_t _current = 0;
+            size_t _offset = 0;
+
+            static std::atomic<uint64_t> _frame;
+    };
+}
+
+#endif // LOVE_FRAME_ARENA_HPP
@@ -0,0 +1,89 @@
+#include "memory_tracker.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <sstream>
+
+namespace love_engine {
+    typedef struct Registry_ {
+        std::mutex mutex;
+        // Deque, so counters never move
+        std::deque<MemoryTracker::Counter> counters;
+    } Registry;
+
+    // Never destroyed, so counters stay valid for resources destroyed during static destruction
+    static Registry& _get_Registry() noexcept {
+        static Registry* registry = new Registry();
+        return *registry;
+    }
+
+    void MemoryTracker::Counter::add_Allocation(const size_t size) noexcept {
+        _allocations.fetch_add(1, std::memory_order_relaxed);
+        _allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        const uint64_t inUse = _bytesInUse.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peak = _peakBytesInUse.load(std::memory_order_relaxed);
+        while ((inUse > peak) && !_peakBytesInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed));
+    }
+
+    void MemoryTracker::Counter::add_Deallocation(const size_t size) noexcept {
+        _deallocations.fetch_add(1, std::memory_order_relaxed);
+        _bytesInUse.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    MemoryTracker::Statistics MemoryTracker::Counter::get_Statistics() const noexcept {
+        return Statistics{
+            .allocations = _allocations.load(std::memory_order_relaxed),
+            .deallocations = _deallocations.load(std::memory_order_relaxed),
+            .allocatedBytes = _allocatedBytes.load(std::memory_order_relaxed),
+            .bytesInUse = _bytesInUse.load(std::memory_order_relaxed),
+            .peakBytesInUse = _peakBytesInUse.load(std::memory_order_relaxed),
+        };
+    }
+
+    MemoryTracker::Resource::Resource(const std::string& subsystem, std::pmr::memory_resource* upstream) noexcept
+    : _counter(MemoryTracker::get_Counter(subsystem)), _upstream(upstream) {}
+
+    void* MemoryTracker::Resource::do_allocate(const size_t size, const size_t alignment) {
+        void* pointer = _upstream->allocate(size, alignment);
+        _counter.add_Allocation(size);
+        return pointer;
+    }
+
+    void MemoryTracker::Resource::do_deallocate(void* pointer, const size_t size, const size_t alignment) {
+        _counter.add_Deallocation(size);
+        _upstream->deallocate(pointer, size, alignment);
+    }
+
+    MemoryTracker::Counter& MemoryTracker::get_Counter(const std::string& subsystem) noexcept {
+        Registry& registry = _get_Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (Counter& counter : registry.counters) {
+            if (counter.get_Subsystem() == subsystem) return counter;
+        }
+        return registry.counters.emplace_back(subsystem);
+    }
+
+    std::vector<std::pair<std::string, MemoryTracker::Statistics>> MemoryTracker::get_Statistics() noexcept {
+        std::vector<std::pair<std::string, Statistics>> statistics;
+        {
+            Registry& registry = _get_Registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (const Counter& counter : registry.counters) statistics.emplace_back(counter.get_Subsystem(), counter.get_Statistics());
+        }
+        std::sort(statistics.begin(), statistics.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        return statistics;
+    }
+
+    std::string MemoryTracker::get_Report() noexcept {
+        std::stringstream report;
+        for (const auto& [subsystem, statistics] : get_Statistics()) {
+            report << subsystem << ": " << statistics.allocations << " allocations, "
+                << statistics.deallocations << " deallocations, "
+                << statistics.allocatedBytes << " bytes allocated, "
+                << statistics.bytesInUse << " bytes in use, "
+                << statistics.peakBytesInUse << " bytes peak\n";
+        }
+        return report.str();
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef LOVE_MEMORY_TRACKER_HPP
+#define LOVE_MEMORY_TRACKER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    // Allocation counters per subsystem, so heap use can be attributed without a profiler.
+    // Thread-safe.
+    class MemoryTracker {
+        public:
+            typedef struct Statistics_ {
+                uint64_t allocations = 0;
+                uint64_t deallocations = 0;
+                uint64_t allocatedBytes = 0;
+                uint64_t bytesInUse = 0;
+                uint64_t peakBytesInUse = 0;
+            } Statistics;
+
+            class Counter {
+                public:
+                    Counter(const std::string& subsystem) : _subsystem(subsystem) {}
+                    Counter(Counter const&) = delete;
+                    void operator=(Counter const&) = delete;
+
+                    void add_Allocation(const size_t size) noexcept;
+                    void add_Deallocation(const size_t size) noexcept;
+
+                    const std::string& get_Subsystem() const noexcept { return _subsystem; }
+                    Statistics get_Statistics() const noexcept;
+
+                private:
+                    const std::string _subsystem;
+                    std::atomic<uint64_t> _allocations = 0;
+                    std::atomic<uint64_t> _deallocations = 0;
+                    std::atomic<uint64_t> _allocatedBytes = 0;
+                    std::atomic<uint64_t> _bytesInUse = 0;
+                    std::atomic<uint64_t> _peakBytesInUse = 0;
+            };
+
+            // Counts every allocation that goes through it, then forwards to @p upstream.
+            class Resource : public std::pmr::memory_resource {
+                public:
+                    Resource(const std::string& subsystem, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept;
+
+                    Counter& get_Counter() const noexcept { return _counter; }
+
+                private:
+                    void* do_allocate(const size_t size, const size_t alignment) override;
+                    void do_deallocate(void* pointer, const size_t size, const size_t alignment) override;
+                    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+                    Counter& _counter;
+                    std::pmr::memory_resource* _upstream;
+            };
+
+            // @return The counter of @p subsystem, created on first use. It lives until the program exits.
+            static Counter& get_Counter(const std::string& subsystem) noexcept;
+            // @return Every counter's statistics, sorted by subsystem.
+            static std::vector<std::pair<std::string, Statistics>> get_Statistics() noexcept;
+            // One line per subsystem, for logs.
+            static std::string get_Report() noexcept;
+    };
+}
+
+#endif // LOVE_MEMORY_TRACKER_HPP
@@ -0,0 +1,178 @@
+#include "pool_allocator.hpp"
+
+#include <atomic>
+#include <iterator>
+#include <mutex>
+
+namespace love_engine {
+    static constexpr size_t _CLASS_COUNT = std::size(PoolAllocator::SIZE_CLASSES);
+    // Blocks moved between a thread cache and the shared list at once
+    static constexpr size_t _BATCH_SIZE = 32;
+    static constexpr size_t _SLAB_SIZE = 64 * 1024;
+
+    typedef struct Free_Block_ {
+        Free_Block_* next;
+    } Free_Block;
+
+    typedef struct Shared_Pool_ {
+        std::mutex mutex;
+        Free_Block* head = nullptr;
+    } Shared_Pool;
+
+    typedef struct Shared_State_ {
+        Shared_Pool pools[_CLASS_COUNT];
+        std::atomic<uint64_t> reservedBytes = 0;
+        std::atomic<uint64_t> fallbackAllocations = 0;
+    } Shared_State;
+
+    // Never destroyed, so blocks can be freed during static destruction
+    static Shared_State& _get_Shared() noexcept {
+        static Shared_State* shared = new Shared_State();
+        return *shared;
+    }
+
+    static size_t _get_Class(const size_t size) noexcept {
+        size_t sizeClass = 0;
+        while (PoolAllocator::SIZE_CLASSES[sizeClass] < size) ++sizeClass;
+        return sizeClass;
+    }
+
+    // Pushes a chain of blocks from @p first to @p last onto the shared list
+    static void _release_Chain(const size_t sizeClass, Free_Block* first, Free_Block* last) noexcept {
+        Shared_Pool& pool = _get_Shared().pools[sizeClass];
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        last->next = pool.head;
+        pool.head = first;
+    }
+
+    static Free_Block* _take_Shared_Block(const size_t sizeClass) noexcept {
+        Shared_Pool& pool = _get_Shared().pools[sizeClass];
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        Free_Block* block = pool.head;
+        if (block) pool.head = block->next;
+        return block;
+    }
+
+    // Set once the thread's cache is destroyed; trivially destructible, so it stays readable until the thread ends
+    static thread_local bool _cacheDestroyed = false;
+
+    class ThreadCache {
+        public:
+            ThreadCache() = default;
+            ~ThreadCache() {
+                _cacheDestroyed = true;
+                for (size_t sizeClass = 0; sizeClass < _CLASS_COUNT; ++sizeClass) {
+                    if (!_heads[sizeClass]) continue;
+                    Free_Block* last = _heads[sizeClass];
+                    while (last->next) last = last->next;
+                    _release_Chain(sizeClass, _heads[sizeClass], last);
+                }
+            }
+
+            void* allocate(const size_t sizeClass) {
+                if (!_heads[sizeClass]) _refill(sizeClass);
+                Free_Block* block = _heads[sizeClass];
+                _heads[sizeClass] = block->next;
+                --_counts[sizeClass];
+                return block;
+            }
+
+            void deallocate(void* pointer, const size_t sizeClass) noexcept {
+                Free_Block* block = static_cast<Free_Block*>(pointer);
+                block->next = _heads[sizeClass];
+                _heads[sizeClass] = block;
+                if (++_counts[sizeClass] < 2 * _BATCH_SIZE) return;
+
+                // Threads that free more than they allocate hand blocks back
+                Free_Block* first = _heads[sizeClass];
+                Free_Block* last = first;
+                for (size_t i = 1; i < _BATCH_SIZE; ++i) last = last->next;
+                _heads[sizeClass] = last->next;
+                _counts[sizeClass] -= _BATCH_SIZE;
+                _release_Chain(sizeClass, first, last);
+            }
+
+        private:
+            void _refill(const size_t sizeClass) {
+                Shared_Pool& pool = _get_Shared().pools[sizeClass];
+                {
+                    std::lock_guard<std::mutex> lock(pool.mutex);
+                    for (size_t i = 0; (i < _BATCH_SIZE) && pool.head; ++i) {
+                        Free_Block* block = pool.head;
+                        pool.head = block->next;
+                        block->next = _heads[sizeClass];
+                        _heads[sizeClass] = block;
+                        ++_counts[sizeClass];
+                    }
+                }
+                if (_heads[sizeClass]) return;
+
+                const size_t blockSize = PoolAllocator::SIZE_CLASSES[sizeClass];
+                std::byte* slab = static_cast<std::byte*>(::operator new(_SLAB_SIZE, std::align_val_t(PoolAllocator::ALIGNMENT)));
+                _get_Shared().reservedBytes.fetch_add(_SLAB_SIZE, std::memory_order_relaxed);
+                for (size_t offset = 0; offset + blockSize <= _SLAB_SIZE; offset += blockSize) {
+                    Free_Block* block = reinterpret_cast<Free_Block*>(slab + offset);
+                    block->next = _heads[sizeClass];
+                    _heads[sizeClass] = block;
+                    ++_counts[sizeClass];
+                }
+            }
+
+            Free_Block* _heads[_CLASS_COUNT] = {};
+            size_t _counts[_CLASS_COUNT] = {};
+    };
+
+    static thread_local ThreadCache _cache;
+
+    void* PoolAllocator::allocate(const size_t size) {
+        if (size > MAX_SIZE) return ::operator new(size);
+        const size_t sizeClass = _get_Class(size);
+        if (!_cacheDestroyed) return _cache.allocate(sizeClass);
+
+        // Thread is exiting, so bypass its cache
+        if (Free_Block* block = _take_Shared_Block(sizeClass)) return block;
+        _get_Shared().fallbackAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(SIZE_CLASSES[sizeClass], std::align_val_t(ALIGNMENT));
+    }
+
+    void PoolAllocator::deallocate(void* pointer, const size_t size) noexcept {
+        if (!pointer) return;
+        if (size > MAX_SIZE) {
+            ::operator delete(pointer);
+            return;
+        }
+        const size_t sizeClass = _get_Class(size);
+        if (!_cacheDestroyed) _cache.deallocate(pointer, sizeClass);
+        else {
+            Free_Block* block = static_cast<Free_Block*>(pointer);
+            _release_Chain(sizeClass, block, block);
+        }
+    }
+
+    class PoolResource : public std::pmr::memory_resource {
+        private:
+            void* do_allocate(const size_t size, const size_t alignment) override {
+                if (alignment <= PoolAllocator::ALIGNMENT) return PoolAllocator::allocate(size);
+                _get_Shared().fallbackAllocations.fetch_add(1, std::memory_order_relaxed);
+                return ::operator new(size, std::align_val_t(alignment));
+            }
+            void do_deallocate(void* pointer, const size_t size, const size_t alignment) override {
+                if (alignment <= PoolAllocator::ALIGNMENT) PoolAllocator::deallocate(pointer, size);
+                else ::operator delete(pointer, std::align_val_t(alignment));
+            }
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    std::pmr::memory_resource* PoolAllocator::get_Resource() noexcept {
+        static PoolResource resource;
+        return &resource;
+    }
+
+    PoolAllocator::Statistics PoolAllocator::get_Statistics() noexcept {
+        const Shared_State& shared = _get_Shared();
+        return Statistics{
+            .reservedBytes = shared.reservedBytes.load(std::memory_order_relaxed),
+            .fallbackAllocations = shared.fallbackAllocations.load(std::memory_order_relaxed),
+        };
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef LOVE_POOL_ALLOCATOR_HPP
+#define LOVE_POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace love_engine {
+    // Fixed-size pools for small objects, one per size class. Every thread keeps a cache of free blocks per
+    // class, so allocating and freeing normally touches no lock; blocks move to and from a shared list in
+    // batches. Memory is never returned to the system, only reused.
+    // Thread-safe.
+    class PoolAllocator {
+        public:
+            static constexpr size_t SIZE_CLASSES[] = {16, 32, 64, 128, 256, 512};
+            static constexpr size_t MAX_SIZE = 512;
+            // Every block is aligned to this
+            static constexpr size_t ALIGNMENT = 16;
+
+            typedef struct Statistics_ {
+                // Bytes taken from the system for pools
+                uint64_t reservedBytes = 0;
+                // Allocations too large or too aligned for a pool
+                uint64_t fallbackAllocations = 0;
+            } Statistics;
+
+            // Sizes above MAX_SIZE go to the global heap.
+            static void* allocate(const size_t size);
+            // @param size Same size as passed to allocate().
+            static void deallocate(void* pointer, const size_t size) noexcept;
+
+            template<class T, class... Args>
+            static T* create(Args&&... args) {
+                static_assert(alignof(T) <= ALIGNMENT, "Over-aligned types cannot be pooled");
+                return new (allocate(sizeof(T))) T(std::forward<Args>(args)...);
+            }
+            template<class T>
+            static void destroy(T* object) noexcept {
+                object->~T();
+                deallocate(object, sizeof(T));
+            }
+
+            // Pools what fits and forwards the rest to the global heap. For std::pmr containers of small nodes.
+            static std::pmr::memory_resource* get_Resource() noexcept;
+
+            static Statistics get_Statistics() noexcept;
+    };
+}
+
+#endif // LOVE_POOL_ALLOCATOR_HPP
@@ -0,0 +1,111 @@
+#include "async.hpp"
+
+#include "../data/files/file_compression.hpp"
+
+#include <cerrno>
+#include <mutex>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+namespace love_engine {
+    Task<FileIO::FileContent> Async::read_File(ThreadPool& pool, std::string filePath) {
+        co_await resume_On(pool);
+        co_return FileIO::read_File_Content(filePath);
+    }
+
+    Task<FileIO::FileContent> Async::decompress_File(ThreadPool& pool, std::string filePath) {
+        co_await resume_On(pool);
+        co_return FileCompression::decompress_File_Raw(filePath.c_str());
+    }
+
+    Task<std::vector<uint8_t>> Async::decompress(ThreadPool& pool, std::vector<uint8_t> data, const size_t size) {
+        co_await resume_On(pool);
+        co_return FileCompression::decompress(data.data(), data.size(), size);
+    }
+
+#ifndef _WIN32
+    Task<ssize_t> Async::receive(ThreadPool& pool, const int socket, void* buffer, const size_t length, sockaddr* from, socklen_t* fromLength) {
+        while (true) {
+            const ssize_t received = recvfrom(socket, buffer, length, MSG_DONTWAIT, from, fromLength);
+            if ((received >= 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) co_return received;
+            co_await readable(pool, socket);
+        }
+    }
+#endif
+
+#ifdef __linux__
+    typedef struct Readable_Waiter_ {
+        ThreadPool* pool;
+        int socket;
+        std::coroutine_handle<> handle;
+    } Readable_Waiter;
+
+    std::mutex _pollerMutex;
+    int _epoll = -1;
+    size_t _pollerWaiters = 0;
+    bool _pollerRunning = false;
+
+    static void _run_Poller() noexcept {
+        epoll_event events[64];
+        while (true) {
+            const int count = epoll_wait(_epoll, events, sizeof(events) / sizeof(events[0]), 100);
+            if ((count < 0) && (errno != EINTR)) break;
+
+            for (int i = 0; i < count; ++i) {
+                Readable_Waiter* waiter = static_cast<Readable_Waiter*>(events[i].data.ptr);
+                epoll_ctl(_epoll, EPOLL_CTL_DEL, waiter->socket, nullptr);
+                {
+                    std::lock_guard<std::mutex> lock(_pollerMutex);
+                    --_pollerWaiters;
+                }
+                waiter->pool->submit([handle = waiter->handle]() { handle.resume(); });
+                delete waiter;
+            }
+
+            // Idle pollers exit, so they never hold up shutdown
+            std::lock_guard<std::mutex> lock(_pollerMutex);
+            if (_pollerWaiters == 0) {
+                _pollerRunning = false;
+                return;
+            }
+        }
+        std::lock_guard<std::mutex> lock(_pollerMutex);
+        _pollerRunning = false;
+    }
+
+    void Async::_wait_Readable(ThreadPool& pool, const int socket, std::coroutine_handle<> handle) noexcept {
+        Readable_Waiter* waiter = new Readable_Waiter{.pool = &pool, .socket = socket, .handle = handle};
+        std::lock_guard<std::mutex> lock(_pollerMutex);
+        if (_epoll < 0) _epoll = epoll_create1(EPOLL_CLOEXEC);
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.ptr = waiter;
+        if ((_epoll < 0) || (epoll_ctl(_epoll, EPOLL_CTL_ADD, socket, &event) != 0)) {
+            // Resumed right away, so the caller sees the error from its next read
+            delete waiter;
+            pool.submit([handle]() { handle.resume(); });
+            return;
+        }
+        ++_pollerWaiters;
+        if (!_pollerRunning) {
+            _pollerRunning = true;
+            Thread poller("ASYNC_POLLER", _run_Poller);
+        }
+    }
+#elif !defined(_WIN32)
+    void Async::_wait_Readable(ThreadPool& pool, const int socket, std::coroutine_handle<> handle) noexcept {
+        // NOTE: Holds a worker while waiting. Only Linux has a poller thread.
+        pool.submit([socket, handle]() {
+            pollfd descriptor{.fd = socket, .events = POLLIN, .revents = 0};
+            while ((poll(&descriptor, 1, -1) < 0) && (errno == EINTR));
+            handle.resume();
+        });
+    }
+#endif
+}
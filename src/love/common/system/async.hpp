@@ -0,0 +1,81 @@
+#ifndef LOVE_ASYNC_HPP
+#define LOVE_ASYNC_HPP
+
+#include "task.hpp"
+#include "thread_pool.hpp"
+#include "../data/files/file_io.hpp"
+
+#include <coroutine>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif
+
+namespace love_engine {
+    // Awaitables for Task coroutines. Blocking work runs on a ThreadPool, and the coroutine continues on that
+    // pool afterwards; await ServerInstance::next_Tick() to get back to the tick thread.
+    class Async {
+        public:
+            // co_await resume_On(pool) continues the coroutine on one of @p pool's workers.
+            static auto resume_On(ThreadPool& pool) noexcept {
+                struct Awaiter {
+                    ThreadPool& pool;
+
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<> handle) noexcept { pool.submit([handle]() { handle.resume(); }); }
+                    void await_resume() const noexcept {}
+                };
+                return Awaiter{pool};
+            }
+
+            // Runs @p f on @p pool.
+            // @throw Whatever @p f threw.
+            template<class F>
+            static Task<std::invoke_result_t<F>> run_On(ThreadPool& pool, F f) {
+                co_await resume_On(pool);
+                co_return f();
+            }
+
+            // @throw std::runtime_error If the file cannot be read.
+            static Task<FileIO::FileContent> read_File(ThreadPool& pool, std::string filePath);
+            // @throw std::runtime_error If the file cannot be read or decompressed.
+            static Task<FileIO::FileContent> decompress_File(ThreadPool& pool, std::string filePath);
+            // @param size Decompressed size.
+            // @throw std::runtime_error If @p data is not valid compressed data.
+            static Task<std::vector<uint8_t>> decompress(ThreadPool& pool, std::vector<uint8_t> data, const size_t size);
+
+#ifndef _WIN32
+            // Waits without holding a thread until @p socket is readable, then continues on @p pool.
+            // A single poller thread watches every socket, and exits when nothing is waiting.
+            // NOTE: Only one coroutine may wait on a socket at a time.
+            static auto readable(ThreadPool& pool, const int socket) noexcept {
+                struct Awaiter {
+                    ThreadPool& pool;
+                    const int socket;
+
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<> handle) noexcept { _wait_Readable(pool, socket, handle); }
+                    void await_resume() const noexcept {}
+                };
+                return Awaiter{pool, socket};
+            }
+
+            // Receives one datagram or the bytes available on @p socket, waiting with readable() while there are none.
+            // @return What recvfrom() returned, or -1 with errno set on errors other than EAGAIN.
+            static Task<ssize_t> receive(ThreadPool& pool, const int socket, void* buffer, const size_t length,
+                sockaddr* from = nullptr, socklen_t* fromLength = nullptr);
+#endif
+
+        private:
+#ifndef _WIN32
+            static void _wait_Readable(ThreadPool& pool, const int socket, std::coroutine_handle<> handle) noexcept;
+#endif
+    };
+}
+
+#endif // LOVE_ASYNC_HPP
@@ -0,0 +1,81 @@
+#include "fixed_timestep.hpp"
+
+#include "../error/stack_trace.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace love_engine {
+    FixedTimestep::FixedTimestep(const Settings settings) : _settings(settings) {
+        // 0 would drop every tick as lag instead of running one
+        if (_settings.maxCatchUpTicks == 0) {
+            throw std::invalid_argument(StackTrace::append_Stacktrace("maxCatchUpTicks must be at least 1."));
+        }
+        if (_settings.tickDuration.count() <= 0) {
+            throw std::invalid_argument(StackTrace::append_Stacktrace("tickDuration must be positive."));
+        }
+    }
+
+    void FixedTimestep::run(
+        const std::function<bool()>& shouldExit,
+        const std::function<void()>& tick,
+        const std::function<void(std::float32_t)>& frame
+    ) noexcept {
+        const std::chrono::nanoseconds tickDuration = _settings.tickDuration;
+        _nextTick = Clock::now() + tickDuration;
+        _resetRequested = false;
+
+        while (!shouldExit()) {
+            Clock::time_point now = Clock::now();
+
+            // Prioritize ticks when behind, but never more than maxCatchUpTicks in a row
+            uint32_t ticksRun = 0;
+            while (now >= _nextTick) {
+                if (ticksRun == _settings.maxCatchUpTicks) {
+                    const uint64_t skipped = (now - _nextTick) / tickDuration + 1;
+                    _statistics.skippedTicks += skipped;
+                    _nextTick += skipped * tickDuration;
+                    break;
+                }
+
+                const std::chrono::nanoseconds lateness = now - _nextTick;
+                tick();
+                const Clock::time_point end = Clock::now();
+                const std::chrono::nanoseconds tickTime = end - now;
+
+                ++_statistics.ticks;
+                if (tickTime > tickDuration) ++_statistics.overrunTicks;
+                _statistics.lastTickTime = tickTime;
+                _statistics.maxTickTime = std::max(_statistics.maxTickTime, tickTime);
+                _statistics.totalTickTime += tickTime;
+                _statistics.lastTickLateness = lateness;
+                _statistics.maxTickLateness = std::max(_statistics.maxTickLateness, lateness);
+
+                if (_resetRequested) {
+                    _resetRequested = false;
+                    _nextTick = end + tickDuration;
+                } else _nextTick += tickDuration;
+
+                if (shouldExit()) return;
+                ++ticksRun;
+                now = end;
+            }
+
+            if (frame) {
+                const std::chrono::nanoseconds untilTick = _nextTick - Clock::now();
+                frame(1.f - std::clamp<std::float32_t>(
+                    static_cast<std::float32_t>(untilTick.count()) / static_cast<std::float32_t>(tickDuration.count()),
+                    0.f, 1.f
+                ));
+            } else _wait_Until(_nextTick);
+        }
+    }
+
+    void FixedTimestep::_wait_Until(const Clock::time_point deadline) const noexcept {
+        // Sleeping is imprecise, so sleep for the bulk of the wait and spin for the rest
+        const Clock::time_point sleepUntil = deadline - _settings.spinThreshold;
+        if (Clock::now() < sleepUntil) std::this_thread::sleep_until(sleepUntil);
+        while (Clock::now() < deadline) std::this_thread::yield();
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef LOVE_FIXED_TIMESTEP_HPP
+#define LOVE_FIXED_TIMESTEP_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdfloat>
+
+namespace love_engine {
+    class FixedTimestep {
+        public:
+            typedef std::chrono::steady_clock Clock;
+
+            typedef struct Settings_ {
+                std::chrono::nanoseconds tickDuration = std::chrono::milliseconds(50);
+                // Ticks run back to back when behind before the remaining lag is dropped. 1 disables catch-up.
+                uint32_t maxCatchUpTicks = 5;
+                // Sleep until this long before a deadline, then spin. Covers OS timer slack.
+                std::chrono::nanoseconds spinThreshold = std::chrono::milliseconds(1);
+            } Settings;
+
+            typedef struct Statistics_ {
+                uint64_t ticks = 0;
+                // Ticks whose update took longer than the tick duration.
+                uint64_t overrunTicks = 0;
+                // Ticks dropped by the catch-up clamp.
+                uint64_t skippedTicks = 0;
+                std::chrono::nanoseconds lastTickTime{0};
+                std::chrono::nanoseconds maxTickTime{0};
+                std::chrono::nanoseconds totalTickTime{0};
+                // How far past its deadline a tick started.
+                std::chrono::nanoseconds lastTickLateness{0};
+                std::chrono::nanoseconds maxTickLateness{0};
+            } Statistics;
+
+            // @throw std::invalid_argument If maxCatchUpTicks is 0 or tickDuration is not positive.
+            FixedTimestep(const Settings settings);
+            ~FixedTimestep() = default;
+
+            // Runs @p tick at a fixed rate until @p shouldExit returns true.
+            // If @p frame is set, it is called between ticks as fast as possible with the fraction of the way to the next tick.
+            // Otherwise the loop waits for the next tick deadline.
+            void run(
+                const std::function<bool()>& shouldExit,
+                const std::function<void()>& tick,
+                const std::function<void(std::float32_t)>& frame = nullptr
+            ) noexcept;
+
+            // Drops accumulated lag after the current tick, e.g. after a long load.
+            void reset() noexcept { _resetRequested = true; }
+
+            const Statistics& get_Statistics() const noexcept { return _statistics; }
+            const Settings& get_Settings() const noexcept { return _settings; }
+
+        private:
+            void _wait_Until(const Clock::time_point deadline) const noexcept;
+
+            Settings _settings;
+            Statistics _statistics;
+            Clock::time_point _nextTick;
+            bool _resetRequested = false;
+    };
+}
+
+#endif // LOVE_FIXED_TIMESTEP_HPP
@@ -0,0 +1,186 @@
+#include "metrics.hpp"
+
+#include "../data/files/file_io.hpp"
+
+#include <bit>
+#include <cinttypes>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace love_engine {
+    typedef struct Metric_Info_ {
+        std::string help;
+        std::string unit;
+    } Metric_Info;
+
+    typedef struct Metrics_Registry_ {
+        std::mutex mutex;
+        // Deques, so metrics never move
+        std::deque<Metrics::Counter> counters;
+        std::deque<Metrics::Gauge> gauges;
+        std::deque<Metrics::Histogram> histograms;
+        std::map<std::string, std::pair<Metrics::Counter*, Metric_Info>> counterNames;
+        std::map<std::string, std::pair<Metrics::Gauge*, Metric_Info>> gaugeNames;
+        std::map<std::string, std::pair<Metrics::Histogram*, Metric_Info>> histogramNames;
+        std::map<std::string, std::pair<std::function<double()>, Metric_Info>> gaugeFunctions;
+    } Metrics_Registry;
+
+    // Never destroyed, so metrics stay valid during static destruction
+    static Metrics_Registry& _get_Registry() noexcept {
+        static Metrics_Registry* registry = new Metrics_Registry();
+        return *registry;
+    }
+
+    size_t Metrics::Counter::_get_Shard() noexcept {
+        // Threads take shards in turn, which spreads them better than hashing their ids
+        static std::atomic<size_t> nextShard = 0;
+        thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+        return shard;
+    }
+
+    uint64_t Metrics::Counter::get() const noexcept {
+        uint64_t value = 0;
+        for (const Shard& shard : _shards) value += shard.value.load(std::memory_order_relaxed);
+        return value;
+    }
+
+    size_t Metrics::Histogram::get_Bucket(const uint64_t value) noexcept {
+        if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+        const size_t shift = static_cast<size_t>(std::bit_width(value)) - 1 - SUB_BUCKET_BITS;
+        const size_t subBucket = static_cast<size_t>(value >> shift) & (SUB_BUCKETS - 1);
+        return (shift + 1) * SUB_BUCKETS + subBucket;
+    }
+
+    uint64_t Metrics::Histogram::get_Bucket_Limit(const size_t bucket) noexcept {
+        if (bucket < SUB_BUCKETS) return bucket;
+        const size_t shift = bucket / SUB_BUCKETS - 1;
+        const uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+        return lower + ((uint64_t(1) << shift) - 1);
+    }
+
+    void Metrics::Histogram::record(const uint64_t value) noexcept {
+        _buckets[get_Bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t max = _max.load(std::memory_order_relaxed);
+        while ((value > max) && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+    }
+
+    uint64_t Metrics::Histogram::get_Count() const noexcept {
+        uint64_t count = 0;
+        for (const auto& bucket : _buckets) count += bucket.load(std::memory_order_relaxed);
+        return count;
+    }
+
+    uint64_t Metrics::Histogram::get_Quantile(const double quantile) const noexcept {
+        std::array<uint64_t, BUCKET_COUNT> counts;
+        uint64_t count = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] = _buckets[i].load(std::memory_order_relaxed);
+            count += counts[i];
+        }
+        if (count == 0) return 0;
+
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantile * count + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(get_Bucket_Limit(i), get_Max());
+        }
+        return get_Max();
+    }
+
+    Metrics::Counter& Metrics::get_Counter(const std::string& name, const std::string& help) noexcept {
+        Metrics_Registry& registry = _get_Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const auto found = registry.counterNames.find(name);
+        if (found != registry.counterNames.end()) return *found->second.first;
+        Counter& counter = registry.counters.emplace_back();
+        registry.counterNames.emplace(name, std::make_pair(&counter, Metric_Info{.help = help, .unit = ""}));
+        return counter;
+    }
+
+    Metrics::Gauge& Metrics::get_Gauge(const std::string& name, const std::string& help) noexcept {
+        Metrics_Registry& registry = _get_Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const auto found = registry.gaugeNames.find(name);
+        if (found != registry.gaugeNames.end()) return *found->second.first;
+        Gauge& gauge = registry.gauges.emplace_back();
+        registry.gaugeNames.emplace(name, std::make_pair(&gauge, Metric_Info{.help = help, .unit = ""}));
+        return gauge;
+    }
+
+    Metrics::Histogram& Metrics::get_Histogram(const std::string& name, const std::string& help, const std::string& unit) noexcept {
+        Metrics_Registry& registry = _get_Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const auto found = registry.histogramNames.find(name);
+        if (found != registry.histogramNames.end()) return *found->second.first;
+        Histogram& histogram = registry.histograms.emplace_back();
+        registry.histogramNames.emplace(name, std::make_pair(&histogram, Metric_Info{.help = help, .unit = unit}));
+        return histogram;
+    }
+
+    void Metrics::set_Gauge_Function(const std::string& name, const std::string& help, const std::function<double()>& sample) noexcept {
+        Metrics_Registry& registry = _get_Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.gaugeFunctions[name] = std::make_pair(sample, Metric_Info{.help = help, .unit = ""});
+    }
+
+    static void _append_Header(std::string& text, const std::string& name, const Metric_Info& info, const char*const type) noexcept {
+        if (!info.help.empty() || !info.unit.empty()) {
+            text += "# HELP " + name + " " + info.help;
+            if (!info.unit.empty()) text += (info.help.empty() ? "(" : " (") + info.unit + ")";
+            text += "\n";
+        }
+        text += "# TYPE " + name + " " + type + "\n";
+    }
+
+    std::string Metrics::get_Text() noexcept {
+        Metrics_Registry& registry = _get_Registry();
+        std::string text;
+        char line[256];
+
+        // Sample functions outside the lock, since they may use metrics themselves
+        std::map<std::string, std::pair<std::function<double()>, Metric_Info>> gaugeFunctions;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            gaugeFunctions = registry.gaugeFunctions;
+
+            for (const auto& [name, counter] : registry.counterNames) {
+                _append_Header(text, name, counter.second, "counter");
+                std::snprintf(line, sizeof(line), " %" PRIu64 "\n", counter.first->get());
+                text += name + line;
+            }
+            for (const auto& [name, gauge] : registry.gaugeNames) {
+                _append_Header(text, name, gauge.second, "gauge");
+                std::snprintf(line, sizeof(line), " %" PRId64 "\n", gauge.first->get());
+                text += name + line;
+            }
+            for (const auto& [name, histogram] : registry.histogramNames) {
+                _append_Header(text, name, histogram.second, "summary");
+                for (const double quantile : {0.5, 0.9, 0.99, 0.999}) {
+                    std::snprintf(line, sizeof(line), "{quantile=\"%g\"} %" PRIu64 "\n", quantile, histogram.first->get_Quantile(quantile));
+                    text += name + line;
+                }
+                std::snprintf(line, sizeof(line), "_sum %" PRIu64 "\n", histogram.first->get_Sum());
+                text += name + line;
+                std::snprintf(line, sizeof(line), "_count %" PRIu64 "\n", histogram.first->get_Count());
+                text += name + line;
+                std::snprintf(line, sizeof(line), "_max %" PRIu64 "\n", histogram.first->get_Max());
+                text += "# TYPE " + name + "_max gauge\n" + name + line;
+            }
+        }
+
+        for (const auto& [name, gauge] : gaugeFunctions) {
+            _append_Header(text, name, gauge.second, "gauge");
+            std::snprintf(line, sizeof(line), " %.10g\n", gauge.first());
+            text += name + line;
+        }
+        return text;
+    }
+
+    void Metrics::write_Snapshot(const std::string& filePath) {
+        FileIO::write_File_Atomic(filePath, get_Text());
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef LOVE_METRICS_HPP
+#define LOVE_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace love_engine {
+    // Process-wide registry of named counters, gauges and latency histograms, exported in the Prometheus
+    // text format. Metrics are created on first use and live until the program exits, so references to them
+    // can be kept in statics.
+    // Names may only contain [a-zA-Z0-9_:].
+    // Thread-safe.
+    class Metrics {
+        public:
+            // Monotonic count, split over cache-line sized shards so threads rarely write the same line.
+            class Counter {
+                public:
+                    Counter() = default;
+                    Counter(Counter const&) = delete;
+                    void operator=(Counter const&) = delete;
+
+                    void add(const uint64_t value = 1) noexcept {
+                        _shards[_get_Shard()].value.fetch_add(value, std::memory_order_relaxed);
+                    }
+                    uint64_t get() const noexcept;
+
+                private:
+                    static constexpr size_t SHARD_COUNT = 16;
+                    typedef struct alignas(64) Shard_ {
+                        std::atomic<uint64_t> value = 0;
+                    } Shard;
+
+                    static size_t _get_Shard() noexcept;
+
+                    std::array<Shard, SHARD_COUNT> _shards;
+            };
+
+            class Gauge {
+                public:
+                    Gauge() = default;
+                    Gauge(Gauge const&) = delete;
+                    void operator=(Gauge const&) = delete;
+
+                    void set(const int64_t value) noexcept { _value.store(value, std::memory_order_relaxed); }
+                    void add(const int64_t value) noexcept { _value.fetch_add(value, std::memory_order_relaxed); }
+                    int64_t get() const noexcept { return _value.load(std::memory_order_relaxed); }
+
+                private:
+                    std::atomic<int64_t> _value = 0;
+            };
+
+            // Log-linear buckets in the style of HDR histograms: every power of two is split into
+            // SUB_BUCKETS buckets, so any recorded value is known to within 1/SUB_BUCKETS of itself.
+            class Histogram {
+                public:
+                    static constexpr size_t SUB_BUCKET_BITS = 3;
+                    static constexpr size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+                    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+                    Histogram() = default;
+                    Histogram(Histogram const&) = delete;
+                    void operator=(Histogram const&) = delete;
+
+                    void record(const uint64_t value) noexcept;
+
+                    uint64_t get_Count() const noexcept;
+                    uint64_t get_Sum() const noexcept { return _sum.load(std::memory_order_relaxed); }
+                    uint64_t get_Max() const noexcept { return _max.load(std::memory_order_relaxed); }
+                    // @param quantile In [0, 1].
+                    // @return Upper bound of the bucket holding the quantile, or 0 if nothing was recorded.
+                    uint64_t get_Quantile(const double quantile) const noexcept;
+
+                    static size_t get_Bucket(const uint64_t value) noexcept;
+                    // @return Largest value that falls in @p bucket.
+                    static uint64_t get_Bucket_Limit(const size_t bucket) noexcept;
+
+                private:
+                    std::array<std::atomic<uint64_t>, BUCKET_COUNT> _buckets = {};
+                    std::atomic<uint64_t> _sum = 0;
+                    std::atomic<uint64_t> _max = 0;
+            };
+
+            // @param help One line describing the metric, shown by scrapers.
+            static Counter& get_Counter(const std::string& name, const std::string& help = "") noexcept;
+            static Gauge& get_Gauge(const std::string& name, const std::string& help = "") noexcept;
+            // @param unit Unit of recorded values, e.g. "nanoseconds". Shown in the help text.
+            static Histogram& get_Histogram(const std::string& name, const std::string& help = "", const std::string& unit = "") noexcept;
+            // Gauge whose value is read from @p sample on every export. Replaces an earlier function of the same name.
+            static void set_Gauge_Function(const std::string& name, const std::string& help, const std::function<double()>& sample) noexcept;
+
+            // Every metric in the Prometheus text exposition format. Histograms are exported as summaries.
+            static std::string get_Text() noexcept;
+            // Writes get_Text() atomically, so readers never see a partial snapshot.
+            // @throw std::runtime_error If a file error occurs.
+            static void write_Snapshot(const std::string& filePath);
+    };
+}
+
+#endif // LOVE_METRICS_HPP
@@ -0,0 +1,146 @@
+#include "metrics_server.hpp"
+
+#include "metrics.hpp"
+
+#include "../error/stack_trace.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace love_engine {
+#ifdef MSG_NOSIGNAL
+    // A scraper hanging up mid-response must not raise SIGPIPE
+    static constexpr int _SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    static constexpr int _SEND_FLAGS = 0;
+#endif
+    // A scraper that stops reading must not stall the server thread
+    static constexpr int _CLIENT_TIMEOUT_MS = 1000;
+
+#ifdef _WIN32
+    static void _close_Socket(const intptr_t socket) noexcept { closesocket(static_cast<SOCKET>(socket)); }
+    static int _poll_Socket(const intptr_t socket, const int timeout) noexcept {
+        WSAPOLLFD request{.fd = static_cast<SOCKET>(socket), .events = POLLRDNORM, .revents = 0};
+        return WSAPoll(&request, 1, timeout);
+    }
+    static void _set_Timeouts(const intptr_t socket, const int timeout) noexcept {
+        const DWORD milliseconds = static_cast<DWORD>(timeout);
+        setsockopt(static_cast<SOCKET>(socket), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&milliseconds), sizeof(milliseconds));
+        setsockopt(static_cast<SOCKET>(socket), SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&milliseconds), sizeof(milliseconds));
+    }
+#else
+    static void _close_Socket(const intptr_t socket) noexcept { close(static_cast<int>(socket)); }
+    static int _poll_Socket(const intptr_t socket, const int timeout) noexcept {
+        pollfd request{.fd = static_cast<int>(socket), .events = POLLIN, .revents = 0};
+        return ::poll(&request, 1, timeout);
+    }
+    static void _set_Timeouts(const intptr_t socket, const int timeout) noexcept {
+        const timeval time{.tv_sec = timeout / 1000, .tv_usec = (timeout % 1000) * 1000};
+        setsockopt(static_cast<int>(socket), SOL_SOCKET, SO_RCVTIMEO, &time, sizeof(time));
+        setsockopt(static_cast<int>(socket), SOL_SOCKET, SO_SNDTIMEO, &time, sizeof(time));
+    }
+#endif
+
+    MetricsServer::MetricsServer(const Settings& settings) : _settings(settings) {
+        if (settings.port != 0) {
+#ifdef _WIN32
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+            const SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            const bool valid = listener != INVALID_SOCKET;
+#else
+            const int listener = socket(AF_INET, SOCK_STREAM, 0);
+            const bool valid = listener >= 0;
+            const int reuse = 1;
+            if (valid) setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+            sockaddr_in address;
+            std::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_port = htons(settings.port);
+            // Loopback only, so metrics are not exposed to the network
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            if (!valid || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) || listen(listener, 8)) {
+                std::stringstream error;
+                error << "Could not listen for metrics on port " << settings.port << ": " << std::strerror(errno);
+                if (valid) _close_Socket(static_cast<intptr_t>(listener));
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+            _socket = static_cast<intptr_t>(listener);
+            _port = settings.port;
+        }
+
+        _thread = std::make_unique<Thread>("METRICS_SERVER", [this]() { _serve_Loop(); });
+    }
+
+    MetricsServer::~MetricsServer() {
+        _stopping = true;
+        _thread->join();
+        if (_socket != -1) _close_Socket(_socket);
+    }
+
+    void MetricsServer::_serve_Loop() noexcept {
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point nextSnapshot = Clock::now();
+
+        while (!_stopping) {
+            if (!_settings.snapshotPath.empty() && (Clock::now() >= nextSnapshot)) {
+                try {
+                    Metrics::write_Snapshot(_settings.snapshotPath);
+                } catch (std::runtime_error&) {} // NOTE: Retried next interval.
+                nextSnapshot = Clock::now() + _settings.snapshotInterval;
+            }
+
+            if (_socket == -1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+            if (_poll_Socket(_socket, 100) <= 0) continue;
+#ifdef _WIN32
+            const SOCKET client = accept(static_cast<SOCKET>(_socket), nullptr, nullptr);
+            if (client == INVALID_SOCKET) continue;
+#else
+            const int client = accept(static_cast<int>(_socket), nullptr, nullptr);
+            if (client < 0) continue;
+#endif
+            _answer(static_cast<intptr_t>(client));
+            _close_Socket(static_cast<intptr_t>(client));
+        }
+    }
+
+    void MetricsServer::_answer(const intptr_t client) noexcept {
+        // Every path gets the metrics, so only wait for the request line to arrive
+        char request[1024];
+        _set_Timeouts(client, _CLIENT_TIMEOUT_MS);
+        if (_poll_Socket(client, _CLIENT_TIMEOUT_MS) <= 0) return;
+        if (recv(client, request, sizeof(request), 0) <= 0) return;
+
+        const std::string body = Metrics::get_Text();
+        const std::string response = "HTTP/1.0 200 OK\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: " + std::to_string(body.length()) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+
+        size_t sent = 0;
+        while (sent < response.length()) {
+            const auto count = send(client, response.data() + sent, static_cast<int>(response.length() - sent), _SEND_FLAGS);
+            if (count <= 0) return;
+            sent += static_cast<size_t>(count);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef LOVE_METRICS_SERVER_HPP
+#define LOVE_METRICS_SERVER_HPP
+
+#include "thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace love_engine {
+    // Publishes Metrics on a background thread: answers HTTP requests on a localhost port with the text
+    // format, for Prometheus-style scrapers, and periodically writes a snapshot file.
+    // Only one request is served at a time; this is meant for a local scraper, not for the internet.
+    class MetricsServer {
+        public:
+            typedef struct Settings_ {
+                // 0 disables the endpoint
+                uint16_t port = 9464;
+                // Empty disables snapshots
+                std::string snapshotPath;
+                std::chrono::milliseconds snapshotInterval = std::chrono::seconds(10);
+            } Settings;
+
+            // @throw std::runtime_error If the port cannot be bound.
+            MetricsServer(const Settings& settings);
+            MetricsServer(MetricsServer const&) = delete;
+            void operator=(MetricsServer const&) = delete;
+            ~MetricsServer();
+
+            // @return The bound port, or 0 if the endpoint is disabled.
+            uint16_t get_Port() const noexcept { return _port; }
+
+        private:
+            void _serve_Loop() noexcept;
+            void _answer(const intptr_t client) noexcept;
+
+            Settings _settings;
+            intptr_t _socket = -1;
+            uint16_t _port = 0;
+
+            std::atomic<bool> _stopping = false;
+            // Last member, so it stops before the rest is destroyed
+            std::unique_ptr<Thread> _thread;
+    };
+}
+
+#endif // LOVE_METRICS_SERVER_HPP
@@ -0,0 +1,190 @@
+#include "profiler.hpp"
+
+#include "thread.hpp"
+
+#include "../data/files/file_io.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace love_engine {
+    std::atomic<bool> Profiler::_capturing = false;
+
+    typedef struct Profile_Event_ {
+        const char* name;
+        uint64_t begin;
+        uint64_t end;
+    } Profile_Event;
+
+    // Written only by its thread. Readers see events below count once it is loaded with acquire.
+    typedef struct Thread_Buffer_ {
+        std::string threadName;
+        uint32_t threadIndex;
+        std::unique_ptr<Profile_Event[]> events;
+        size_t capacity = 0;
+        std::atomic<size_t> count = 0;
+        std::atomic<uint64_t> dropped = 0;
+        // Capture the events belong to
+        std::atomic<uint64_t> capture = 0;
+    } Thread_Buffer;
+
+    typedef struct Profiler_State_ {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Thread_Buffer>> buffers;
+        uint32_t nextThreadIndex = 1;
+        std::atomic<uint64_t> capture = 0;
+        std::atomic<size_t> eventsPerThread = 0;
+        uint64_t captureBegin = 0;
+    } Profiler_State;
+
+    // Never destroyed, so threads can still record during static destruction
+    static Profiler_State& _get_State() noexcept {
+        static Profiler_State* state = new Profiler_State();
+        return *state;
+    }
+
+    void Profiler::begin_Capture(const size_t eventsPerThread) noexcept {
+        Profiler_State& state = _get_State();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        // Buffers only held here belong to threads that have exited
+        std::erase_if(state.buffers, [](const auto& buffer) { return buffer.use_count() == 1; });
+
+        state.eventsPerThread.store(eventsPerThread, std::memory_order_relaxed);
+        state.captureBegin = get_Time();
+        state.capture.fetch_add(1, std::memory_order_release);
+        _capturing.store(true, std::memory_order_relaxed);
+    }
+
+    void Profiler::_record(const char*const name, const uint64_t begin, const uint64_t end) noexcept {
+        Profiler_State& state = _get_State();
+        thread_local std::shared_ptr<Thread_Buffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<Thread_Buffer>();
+            buffer->threadName = Thread::get_Thread_Name(std::this_thread::get_id());
+            std::lock_guard<std::mutex> lock(state.mutex);
+            buffer->threadIndex = state.nextThreadIndex++;
+            state.buffers.push_back(buffer);
+        }
+
+        // The first zone of a new capture clears the thread's old events
+        const uint64_t capture = state.capture.load(std::memory_order_acquire);
+        if (buffer->capture.load(std::memory_order_relaxed) != capture) {
+            const size_t capacity = state.eventsPerThread.load(std::memory_order_relaxed);
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+            if (buffer->capacity != capacity) {
+                buffer->events = std::make_unique<Profile_Event[]>(capacity);
+                buffer->capacity = capacity;
+            }
+            buffer->capture.store(capture, std::memory_order_release);
+        }
+
+        const size_t index = buffer->count.load(std::memory_order_relaxed);
+        if (index >= buffer->capacity) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer->events[index] = Profile_Event{.name = name, .begin = begin, .end = end};
+        buffer->count.store(index + 1, std::memory_order_release);
+    }
+
+    // @return Buffers with events of the last capture.
+    static std::vector<std::shared_ptr<Thread_Buffer>> _get_Capture_Buffers(uint64_t& captureBegin) noexcept {
+        Profiler_State& state = _get_State();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        captureBegin = state.captureBegin;
+        const uint64_t capture = state.capture.load(std::memory_order_acquire);
+        std::vector<std::shared_ptr<Thread_Buffer>> buffers;
+        for (const auto& buffer : state.buffers) {
+            if (buffer->capture.load(std::memory_order_acquire) == capture) buffers.push_back(buffer);
+        }
+        return buffers;
+    }
+
+    static void _append_Json_String(std::string& output, const std::string& value) noexcept {
+        output += '"';
+        for (const char character : value) {
+            if ((character == '"') || (character == '\\')) output += '\\';
+            if (static_cast<unsigned char>(character) < 0x20) continue;
+            output += character;
+        }
+        output += '"';
+    }
+
+    void Profiler::write_Chrome_Trace(const std::string& filePath) {
+        uint64_t captureBegin;
+        const auto buffers = _get_Capture_Buffers(captureBegin);
+
+        std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        char line[128];
+        for (const auto& buffer : buffers) {
+            if (!first) output += ",\n";
+            first = false;
+            std::snprintf(line, sizeof(line), "{\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32 ",\"name\":\"thread_name\",\"args\":{\"name\":", buffer->threadIndex);
+            output += line;
+            _append_Json_String(output, buffer->threadName);
+            output += "}}";
+
+            const size_t count = buffer->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const Profile_Event& event = buffer->events[i];
+                // Zones that began before the capture are clipped to its start
+                const uint64_t begin = std::max(event.begin, captureBegin);
+                output += ",\n{\"ph\":\"X\",\"pid\":1,\"name\":";
+                _append_Json_String(output, event.name);
+                std::snprintf(line, sizeof(line), ",\"tid\":%" PRIu32 ",\"ts\":%.3f,\"dur\":%.3f}",
+                    buffer->threadIndex, (begin - captureBegin) / 1000.0, (event.end - begin) / 1000.0
+                );
+                output += line;
+            }
+        }
+        output += "\n]}\n";
+        FileIO::write_File(filePath, output);
+    }
+
+    std::string Profiler::get_Summary() noexcept {
+        typedef struct Zone_Total_ {
+            uint64_t count = 0;
+            uint64_t total = 0;
+            uint64_t max = 0;
+        } Zone_Total;
+
+        uint64_t captureBegin;
+        std::unordered_map<std::string, Zone_Total> totals;
+        for (const auto& buffer : _get_Capture_Buffers(captureBegin)) {
+            const size_t count = buffer->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const Profile_Event& event = buffer->events[i];
+                Zone_Total& total = totals[event.name];
+                ++total.count;
+                total.total += event.end - event.begin;
+                total.max = std::max(total.max, event.end - event.begin);
+            }
+        }
+
+        std::vector<std::pair<std::string, Zone_Total>> sorted(totals.begin(), totals.end());
+        std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.total > b.second.total; });
+
+        std::string summary;
+        char line[256];
+        for (const auto& [name, total] : sorted) {
+            std::snprintf(line, sizeof(line), "%s: %" PRIu64 " calls, %.3fms total, %.3fus mean, %.3fus max\n",
+                name.c_str(), total.count, total.total / 1e6, total.total / 1e3 / total.count, total.max / 1e3
+            );
+            summary += line;
+        }
+        return summary;
+    }
+
+    uint64_t Profiler::get_Dropped_Zones() noexcept {
+        uint64_t captureBegin, dropped = 0;
+        for (const auto& buffer : _get_Capture_Buffers(captureBegin)) dropped += buffer->dropped.load(std::memory_order_relaxed);
+        return dropped;
+    }
+}
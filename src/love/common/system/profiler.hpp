@@ -0,0 +1,66 @@
+#ifndef LOVE_PROFILER_HPP
+#define LOVE_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Compile with LOVE_DISABLE_PROFILER to remove every zone.
+#ifndef LOVE_DISABLE_PROFILER
+#define LOVE_PROFILE_CONCAT_(a, b) a##b
+#define LOVE_PROFILE_CONCAT(a, b) LOVE_PROFILE_CONCAT_(a, b)
+// Times the rest of the enclosing scope. @p name must outlive the capture, e.g. a string literal.
+#define LOVE_PROFILE_ZONE(name) const ::love_engine::Profiler::Zone LOVE_PROFILE_CONCAT(_profileZone, __LINE__)(name)
+#define LOVE_PROFILE_FUNCTION() LOVE_PROFILE_ZONE(__func__)
+#else
+#define LOVE_PROFILE_ZONE(name) ((void) 0)
+#define LOVE_PROFILE_FUNCTION() ((void) 0)
+#endif
+
+namespace love_engine {
+    // Records timed zones into per-thread buffers while a capture runs. Each thread only writes its own
+    // buffer, so recording takes no lock; outside a capture a zone costs one relaxed load.
+    // Zones nest by time, so the trace shows the hierarchy of each thread.
+    // Thread-safe.
+    class Profiler {
+        public:
+            class Zone {
+                public:
+                    Zone(const char*const name) noexcept : _name(name), _begin(is_Capturing() ? get_Time() : 0) {}
+                    Zone(Zone const&) = delete;
+                    void operator=(Zone const&) = delete;
+                    ~Zone() { if (_begin) _record(_name, _begin, get_Time()); }
+
+                private:
+                    const char*const _name;
+                    const uint64_t _begin;
+            };
+
+            // Starts a new capture, discarding the previous one.
+            // @param eventsPerThread Zones past this on one thread are dropped and counted.
+            static void begin_Capture(const size_t eventsPerThread = 1 << 18) noexcept;
+            static void end_Capture() noexcept { _capturing.store(false, std::memory_order_relaxed); }
+            static bool is_Capturing() noexcept { return _capturing.load(std::memory_order_relaxed); }
+
+            // Writes the last capture in Chrome's trace event format, for chrome://tracing or Perfetto.
+            // Call after end_Capture().
+            // @throw std::runtime_error If a file error occurs.
+            static void write_Chrome_Trace(const std::string& filePath);
+            // Call count, total and maximum time of every zone name in the last capture, slowest total first.
+            static std::string get_Summary() noexcept;
+            static uint64_t get_Dropped_Zones() noexcept;
+
+            // Nanoseconds on the steady clock
+            static uint64_t get_Time() noexcept {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+        private:
+            static void _record(const char*const name, const uint64_t begin, const uint64_t end) noexcept;
+
+            static std::atomic<bool> _capturing;
+    };
+}
+
+#endif // LOVE_PROFILER_HPP
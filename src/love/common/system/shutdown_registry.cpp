@@ -0,0 +1,203 @@
+#include "shutdown_registry.hpp"
+
+#include "thread.hpp"
+#include "../data/files/logger.hpp"
+#include "../error/stack_trace.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace love_engine {
+    void ShutdownRegistry::add(Callback callback) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (callback.name.empty()) callback.name = "exit_callback_" + std::to_string(_addedCount);
+        for (const Callback& existing : _callbacks) {
+            if (existing.name != callback.name) continue;
+            std::stringstream error;
+            error << "Exit callback \"" << callback.name << "\" was added twice.";
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        // Dependencies come first, so the callbacks can never wait on each other in a cycle
+        for (const std::string& dependency : callback.dependencies) {
+            const bool added = std::any_of(_callbacks.begin(), _callbacks.end(), [&dependency](const Callback& existing) {
+                return existing.name == dependency;
+            });
+            if (added) continue;
+            std::stringstream error;
+            error << "Exit callback \"" << callback.name << "\" depends on \"" << dependency << "\", which was not added.";
+            throw std::invalid_argument(StackTrace::append_Stacktrace(error));
+        }
+        ++_addedCount;
+        _callbacks.push_back(std::move(callback));
+    }
+
+    size_t ShutdownRegistry::run(const Logger* logger) noexcept {
+        typedef std::chrono::steady_clock Clock;
+        std::vector<Callback> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            callbacks.swap(_callbacks);
+        }
+        const size_t count = callbacks.size();
+
+        enum class State {
+            PENDING,
+            RUNNING,
+            FINISHED,
+            TIMED_OUT,
+        };
+        // NOTE: Shared with the callback threads, since timed out ones outlive this call.
+        struct Run_State {
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::vector<State> states;
+            std::vector<Clock::time_point> starts;
+            std::vector<Callback_Timing> timings;
+            std::vector<size_t> finishOrder;
+        };
+        auto state = std::make_shared<Run_State>();
+        state->states.assign(count, State::PENDING);
+        state->starts.resize(count);
+        state->timings.resize(count);
+
+        std::unordered_map<std::string, size_t> indices;
+        for (size_t i = 0; i < count; ++i) {
+            indices.emplace(callbacks[i].name, i);
+            state->timings[i].name = callbacks[i].name;
+        }
+        std::vector<std::vector<size_t>> dependencies(count);
+        for (size_t i = 0; i < count; ++i) {
+            for (const std::string& name : callbacks[i].dependencies) {
+                dependencies[i].push_back(indices.at(name));
+            }
+        }
+        std::vector<size_t> order(count);
+        for (size_t i = 0; i < count; ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&callbacks](const size_t a, const size_t b) { return callbacks[a].priority > callbacks[b].priority; });
+
+        const Clock::time_point start = Clock::now();
+        std::unique_lock<std::mutex> lock(state->mutex);
+        auto isDone = [&state](const size_t i) { return (state->states[i] == State::FINISHED) || (state->states[i] == State::TIMED_OUT); };
+        auto startCallback = [&](const size_t i) {
+            state->states[i] = State::RUNNING;
+            state->starts[i] = Clock::now();
+            Thread callbackThread("EXIT_" + callbacks[i].name, [state, i](const std::function<void()>& run) {
+                std::string error;
+                try {
+                    run();
+                } catch (const std::exception& e) {
+                    error = e.what();
+                } catch (...) {
+                    error = "Unknown exception";
+                }
+
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->states[i] != State::RUNNING) return; // Timed out
+                state->states[i] = State::FINISHED;
+                state->timings[i].duration = Clock::now() - state->starts[i];
+                state->timings[i].error = error;
+                state->finishOrder.push_back(i);
+                state->changed.notify_all();
+            }, callbacks[i].run);
+        };
+
+        while (true) {
+            // Only the highest priority with unfinished callbacks may start
+            int32_t priority = std::numeric_limits<int32_t>::min();
+            bool unfinished = false;
+            for (size_t i = 0; i < count; ++i) {
+                if (isDone(i)) continue;
+                priority = unfinished ? std::max(priority, callbacks[i].priority) : callbacks[i].priority;
+                unfinished = true;
+            }
+            if (!unfinished) break;
+
+            // Dependencies of the current priority run with it, even if their own priority is lower
+            std::vector<bool> wanted(count, false);
+            std::vector<size_t> stack;
+            for (size_t i = 0; i < count; ++i) {
+                if (!isDone(i) && (callbacks[i].priority == priority)) stack.push_back(i);
+            }
+            while (!stack.empty()) {
+                const size_t i = stack.back();
+                stack.pop_back();
+                if (wanted[i]) continue;
+                wanted[i] = true;
+                for (const size_t dependency : dependencies[i]) {
+                    if (!isDone(dependency)) stack.push_back(dependency);
+                }
+            }
+            for (const size_t i : order) {
+                if ((state->states[i] == State::PENDING) && wanted[i]
+                    && std::all_of(dependencies[i].begin(), dependencies[i].end(), isDone)) {
+                    startCallback(i);
+                }
+            }
+
+            Clock::time_point deadline = Clock::time_point::max();
+            for (size_t i = 0; i < count; ++i) {
+                if ((state->states[i] != State::RUNNING) || (callbacks[i].timeout == NO_TIMEOUT)) continue;
+                deadline = std::min(deadline, state->starts[i] + callbacks[i].timeout);
+            }
+            state->changed.wait_until(lock, deadline);
+
+            const Clock::time_point now = Clock::now();
+            for (size_t i = 0; i < count; ++i) {
+                if ((state->states[i] != State::RUNNING) || (callbacks[i].timeout == NO_TIMEOUT)) continue;
+                if (now < state->starts[i] + callbacks[i].timeout) continue;
+                state->states[i] = State::TIMED_OUT;
+                state->timings[i].duration = now - state->starts[i];
+                state->timings[i].timedOut = true;
+                state->finishOrder.push_back(i);
+                if (logger) logger->log(Log_Status::WARNING, "Exit callback \"" + callbacks[i].name + "\" timed out and is still running.");
+            }
+        }
+
+        size_t timedOut = 0;
+        std::vector<Callback_Timing> timings;
+        for (const size_t i : state->finishOrder) {
+            timings.push_back(state->timings[i]);
+            if (state->timings[i].timedOut) ++timedOut;
+        }
+        lock.unlock();
+
+        bool problems = timedOut > 0;
+        for (const Callback_Timing& timing : timings) problems |= !timing.error.empty();
+        {
+            std::lock_guard<std::mutex> registryLock(_mutex);
+            _timings = std::move(timings);
+            _totalTime = Clock::now() - start;
+        }
+        if (logger && (count > 0)) logger->log(problems ? Log_Status::WARNING : Log_Status::INFO, get_Report());
+        return timedOut;
+    }
+
+    std::vector<ShutdownRegistry::Callback_Timing> ShutdownRegistry::get_Timings() const noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _timings;
+    }
+
+    std::string ShutdownRegistry::get_Report() const noexcept {
+        auto milliseconds = [](const std::chrono::nanoseconds time) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.3fms", time.count() / 1e6);
+            return std::string(text);
+        };
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::stringstream report;
+        report << "Shutdown took " << milliseconds(_totalTime) << ":";
+        for (const Callback_Timing& timing : _timings) {
+            report << "\n\t" << timing.name << ": " << milliseconds(timing.duration);
+            if (timing.timedOut) report << " (timed out, still running)";
+            if (!timing.error.empty()) report << " (failed: " << timing.error << ")";
+        }
+        return report.str();
+    }
+}
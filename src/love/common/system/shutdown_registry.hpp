@@ -0,0 +1,71 @@
+#ifndef LOVE_SHUTDOWN_REGISTRY_HPP
+#define LOVE_SHUTDOWN_REGISTRY_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    class Logger;
+
+    // Callbacks run at shutdown. Each one runs on its own thread once the callbacks it depends on have finished,
+    // and after every callback with a higher priority, so independent callbacks overlap.
+    // A callback that outlives its timeout is logged, left running and counts as finished, so one hung callback
+    // cannot hold up the others. run() reports how many are left, and the caller must then end the process
+    // without destroying what they may still use, as LoveEngineInstance::cleanup() does.
+    // Thread-safe.
+    class ShutdownRegistry {
+        public:
+            typedef struct Callback_ {
+                // Unique. Generated if empty.
+                std::string name;
+                std::function<void()> run;
+                // Higher runs first. Dependencies are pulled forward to run with the callbacks needing them.
+                int32_t priority = 0;
+                // Names of callbacks that must finish first. They must already be added.
+                std::vector<std::string> dependencies;
+                // NO_TIMEOUT for callbacks that must finish however long they take, e.g. ones writing files.
+                std::chrono::milliseconds timeout = std::chrono::milliseconds(500);
+            } Callback;
+            static constexpr std::chrono::milliseconds NO_TIMEOUT = std::chrono::milliseconds::max();
+
+            typedef struct Callback_Timing_ {
+                std::string name;
+                std::chrono::nanoseconds duration{0};
+                bool timedOut = false;
+                // What the callback threw, if anything
+                std::string error;
+            } Callback_Timing;
+
+            ShutdownRegistry() = default;
+            ShutdownRegistry(ShutdownRegistry const&) = delete;
+            void operator=(ShutdownRegistry const&) = delete;
+            ~ShutdownRegistry() = default;
+
+            // @throw std::runtime_error If a callback with the same name was already added.
+            // @throw std::invalid_argument If a dependency was not added yet.
+            void add(Callback callback);
+
+            // Runs and removes every added callback, blocking until all have finished or timed out.
+            // @param logger If set, receives every timeout as it happens and every callback's duration.
+            // @return Callbacks still running because they timed out.
+            size_t run(const Logger* logger = nullptr) noexcept;
+
+            // In the order the callbacks finished, from the last run().
+            std::vector<Callback_Timing> get_Timings() const noexcept;
+            // Total time and one line per callback, as logged by run().
+            std::string get_Report() const noexcept;
+
+        private:
+            mutable std::mutex _mutex;
+            std::vector<Callback> _callbacks;
+            std::vector<Callback_Timing> _timings;
+            std::chrono::nanoseconds _totalTime{0};
+            size_t _addedCount = 0;
+    };
+}
+
+#endif // LOVE_SHUTDOWN_REGISTRY_HPP
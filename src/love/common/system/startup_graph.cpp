@@ -0,0 +1,176 @@
+#include "startup_graph.hpp"
+
+#include "thread.hpp"
+#include "thread_pool.hpp"
+#include "../data/files/logger.hpp"
+#include "../error/stack_trace.hpp"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace love_engine {
+    void StartupGraph::add_Step(const Step& step) {
+        for (const Step& existing : _steps) {
+            if (existing.name != step.name) continue;
+            std::stringstream error;
+            error << "Startup step \"" << step.name << "\" was added twice.";
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+        _steps.push_back(step);
+    }
+
+    void StartupGraph::run(const size_t threadCount, const Logger* logger) {
+        typedef std::chrono::steady_clock Clock;
+        const size_t count = _steps.size();
+
+        std::unordered_map<std::string, size_t> indices;
+        for (size_t i = 0; i < count; ++i) indices.emplace(_steps[i].name, i);
+        std::vector<size_t> remaining(count, 0);
+        std::vector<std::vector<size_t>> dependents(count);
+        for (size_t i = 0; i < count; ++i) {
+            for (const std::string& dependency : _steps[i].dependencies) {
+                const auto found = indices.find(dependency);
+                if (found == indices.end()) {
+                    std::stringstream error;
+                    error << "Startup step \"" << _steps[i].name << "\" depends on unknown step \"" << dependency << "\".";
+                    throw std::runtime_error(StackTrace::append_Stacktrace(error));
+                }
+                dependents[found->second].push_back(i);
+                ++remaining[i];
+            }
+        }
+
+        // Steps a topological order never reaches are part of a cycle
+        {
+            std::vector<size_t> left = remaining;
+            std::vector<size_t> ready;
+            for (size_t i = 0; i < count; ++i) if (left[i] == 0) ready.push_back(i);
+            size_t ordered = 0;
+            while (!ready.empty()) {
+                const size_t step = ready.back();
+                ready.pop_back();
+                ++ordered;
+                for (const size_t dependent : dependents[step]) if (--left[dependent] == 0) ready.push_back(dependent);
+            }
+            if (ordered != count) {
+                std::stringstream error;
+                error << "Startup steps have circular dependencies:";
+                for (size_t i = 0; i < count; ++i) if (left[i] != 0) error << " \"" << _steps[i].name << "\"";
+                throw std::runtime_error(StackTrace::append_Stacktrace(error));
+            }
+        }
+
+        _timings.assign(count, Step_Timing{});
+        for (size_t i = 0; i < count; ++i) _timings[i].name = _steps[i].name;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<size_t> mainQueue;
+        std::vector<bool> failed(count, false);
+        size_t finished = 0;
+        std::string firstError;
+
+        bool needsPool = false;
+        for (const Step& step : _steps) needsPool |= !step.mainThread;
+        std::unique_ptr<ThreadPool> pool;
+        if (needsPool && (threadCount > 0)) pool = std::make_unique<ThreadPool>("STARTUP", std::min(threadCount, count));
+
+        const Clock::time_point start = Clock::now();
+        std::function<void(size_t)> schedule;
+        auto execute = [&](const size_t step) {
+            bool skipped;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                skipped = failed[step];
+            }
+
+            Step_Timing& timing = _timings[step];
+            const Clock::time_point stepStart = Clock::now();
+            timing.start = stepStart - start;
+            std::string error;
+            if (!skipped) {
+                try {
+                    _steps[step].run();
+                } catch (const std::exception& e) {
+                    error = e.what();
+                } catch (...) {
+                    error = "Unknown exception";
+                }
+            }
+            timing.duration = Clock::now() - stepStart;
+            // After running, since a step may name its thread
+            timing.threadName = Thread::get_Thread_Name(std::this_thread::get_id());
+
+            std::vector<size_t> ready;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error.empty()) {
+                    failed[step] = true;
+                    if (firstError.empty()) firstError = "Startup step \"" + _steps[step].name + "\" failed: " + error;
+                }
+                timing.failed = failed[step];
+                for (const size_t dependent : dependents[step]) {
+                    if (failed[step]) failed[dependent] = true;
+                    if (--remaining[dependent] == 0) ready.push_back(dependent);
+                }
+                ++finished;
+            }
+            for (const size_t next : ready) schedule(next);
+            changed.notify_all();
+        };
+        schedule = [&](const size_t step) {
+            if (_steps[step].mainThread || !pool) {
+                std::lock_guard<std::mutex> lock(mutex);
+                mainQueue.push_back(step);
+            } else {
+                pool->submit([&execute, step]() { execute(step); });
+            }
+        };
+
+        for (size_t i = 0; i < count; ++i) if (remaining[i] == 0) schedule(i);
+        while (true) {
+            size_t step;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return !mainQueue.empty() || (finished == count); });
+                if (mainQueue.empty()) break;
+                step = mainQueue.front();
+                mainQueue.pop_front();
+            }
+            execute(step);
+        }
+        // NOTE: Workers may still be returning from execute(), so the pool is joined before its captures go away.
+        pool.reset();
+        _totalTime = Clock::now() - start;
+
+        if (logger) logger->log(get_Report());
+        if (!firstError.empty()) {
+            std::stringstream error;
+            error << firstError;
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+    }
+
+    std::string StartupGraph::get_Report() const noexcept {
+        auto milliseconds = [](const std::chrono::nanoseconds time) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.3fms", time.count() / 1e6);
+            return std::string(text);
+        };
+
+        std::stringstream report;
+        report << "Startup took " << milliseconds(_totalTime) << ":";
+        for (const Step_Timing& timing : _timings) {
+            report << "\n\t" << timing.name << ": " << milliseconds(timing.duration) << " at +" << milliseconds(timing.start)
+                << " on " << timing.threadName;
+            if (timing.failed) report << " (failed)";
+        }
+        return report.str();
+    }
+}
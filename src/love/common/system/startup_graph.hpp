@@ -0,0 +1,60 @@
+#ifndef LOVE_STARTUP_GRAPH_HPP
+#define LOVE_STARTUP_GRAPH_HPP
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    class Logger;
+
+    // Startup steps that declare which steps they depend on. Each step runs once its dependencies have finished,
+    // and independent steps run at the same time on a temporary pool. Steps that must run on the calling thread,
+    // e.g. ones that set up per-thread state, are marked mainThread.
+    class StartupGraph {
+        public:
+            typedef struct Step_ {
+                std::string name;
+                std::vector<std::string> dependencies;
+                std::function<void()> run;
+                bool mainThread = false;
+            } Step;
+
+            typedef struct Step_Timing_ {
+                std::string name;
+                std::string threadName;
+                // Since run() was called
+                std::chrono::nanoseconds start{0};
+                std::chrono::nanoseconds duration{0};
+                // Set if the step threw or a dependency failed
+                bool failed = false;
+            } Step_Timing;
+
+            StartupGraph() = default;
+            ~StartupGraph() = default;
+
+            // @throw std::runtime_error If a step with the same name was already added.
+            void add_Step(const Step& step);
+
+            // Runs every step and blocks until they have finished. Steps depending on a failed step are skipped.
+            // @param threadCount Pool threads besides the calling thread. 0 runs everything on the calling thread.
+            // @param logger If set, receives a line per step with its timing.
+            // @throw std::runtime_error If a dependency is unknown or circular, before anything runs, or naming the
+            // first step that threw, after every other step has finished.
+            void run(const size_t threadCount = 4, const Logger* logger = nullptr);
+
+            // In the order the steps were added.
+            const std::vector<Step_Timing>& get_Timings() const noexcept { return _timings; }
+            std::chrono::nanoseconds get_Total_Time() const noexcept { return _totalTime; }
+            // Total time and one line per step, as logged by run().
+            std::string get_Report() const noexcept;
+
+        private:
+            std::vector<Step> _steps;
+            std::vector<Step_Timing> _timings;
+            std::chrono::nanoseconds _totalTime{0};
+    };
+}
+
+#endif // LOVE_STARTUP_GRAPH_HPP
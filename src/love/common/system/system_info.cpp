@@ -1,9 +1,20 @@
 #include "system_info.hpp"
 
+#include "thread.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <thread>
+#include <tuple>
 
 #ifdef _WIN32
   #ifndef _WIN32_DCOM
@@ -28,6 +39,81 @@ namespace love_engine {
     std::vector<SystemInfo::VideoCardInfo> _video_Cards;
     SystemInfo::BaseBoardInfo _baseBoard;
     std::string _physicalMemory;
+    SystemInfo::CPU_Topology _CPUTopology;
+    SystemInfo::Memory_Info _memoryInfo;
+
+    enum class Probe_State {
+        NOT_STARTED,
+        RUNNING,
+        DONE,
+    };
+    std::mutex _probeMutex;
+    std::condition_variable _probeDone;
+    Probe_State _probeState = Probe_State::NOT_STARTED;
+    std::atomic<bool> _probed = false;
+
+#ifdef __linux__
+    static std::string _read_Line(const std::string& path) noexcept {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        while (!line.empty() && ((line.back() == '\n') || (line.back() == ' '))) line.pop_back();
+        return line;
+    }
+
+    static uint64_t _read_Number(const std::string& path, const uint64_t fallback = 0) noexcept {
+        const std::string line = _read_Line(path);
+        if (line.empty() || (line[0] < '0') || (line[0] > '9')) return fallback;
+        return std::strtoull(line.c_str(), nullptr, 10);
+    }
+
+    // "0-3,8,10-11"
+    static std::vector<uint32_t> _parse_CPU_List(const std::string& list) noexcept {
+        std::vector<uint32_t> cpus;
+        std::stringstream ranges(list);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            if (range.empty()) continue;
+            const size_t dash = range.find('-');
+            const uint32_t first = static_cast<uint32_t>(std::strtoul(range.c_str(), nullptr, 10));
+            const uint32_t last = (dash == std::string::npos) ? first : static_cast<uint32_t>(std::strtoul(range.c_str() + dash + 1, nullptr, 10));
+            for (uint32_t cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    // "32K", "1024K", "8M"
+    static uint64_t _parse_Size(const std::string& size) noexcept {
+        char* unit;
+        const uint64_t value = std::strtoull(size.c_str(), &unit, 10);
+        switch (*unit) {
+            case 'K': return value * 1024;
+            case 'M': return value * 1024 * 1024;
+            case 'G': return value * 1024 * 1024 * 1024;
+            default: return value;
+        }
+    }
+
+    // "Key: value" lines, as in /proc/cpuinfo and /proc/meminfo. Only the first block of /proc/cpuinfo is read.
+    static std::map<std::string, std::string> _read_Fields(const std::string& path) noexcept {
+        std::map<std::string, std::string> fields;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty()) {
+                if (!fields.empty()) break;
+                continue;
+            }
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            std::string key = line.substr(0, colon);
+            while (!key.empty() && ((key.back() == ' ') || (key.back() == '\t'))) key.pop_back();
+            const size_t value = line.find_first_not_of(" \t", colon + 1);
+            fields.emplace(key, (value == std::string::npos) ? "" : line.substr(value));
+        }
+        return fields;
+    }
+#endif
 
     void SystemInfo::_find_OS() noexcept {
 #ifdef _WIN32
@@ -53,12 +139,22 @@ namespace love_engine {
             _OS.assign(buffer.str());
         } else _OS.assign("Not found");
 #elif defined(__unix__)
-        std::stringstream buffer;
         struct utsname unameData;
-        std::uname(&unameData);
-        std::stringstream buffer(unameData.sysname);
-        buffer << " ";
-        buffer << unameData.release;
+        uname(&unameData);
+        std::stringstream buffer;
+#ifdef __linux__
+        std::ifstream release("/etc/os-release");
+        std::string line;
+        while (std::getline(release, line)) {
+            if (!line.starts_with("PRETTY_NAME=")) continue;
+            std::string name = line.substr(sizeof("PRETTY_NAME=") - 1);
+            if ((name.length() >= 2) && (name.front() == '"') && (name.back() == '"')) name = name.substr(1, name.length() - 2);
+            buffer << name << " (";
+            break;
+        }
+#endif
+        buffer << unameData.sysname << " " << unameData.release;
+        if (buffer.str().find('(') != std::string::npos) buffer << ")";
         _OS.assign(buffer.str());
 #endif
     }
@@ -71,7 +167,8 @@ namespace love_engine {
             L"szName"
         );
 #elif defined(__unix__)
-        // TODO
+        struct utsname unameData;
+        if (!uname(&unameData)) _systemName = unameData.nodename;
 #endif
     }
     
@@ -102,16 +199,21 @@ namespace love_engine {
         if (sysctlbyname("hw.cpufrequency", &freq, &size, NULL, 0) < 0) {
             // Error
         }
-#elif defined(__unix__)
-        // TODO Use /proc/cpuinfo
-        FILE *cpuinfo = std::fopen("/proc/cpuinfo", "rb");
-        char *arg = 0;
-        size_t size = 0;
-        while(std::getdelim(&arg, &size, 0, cpuinfo) != -1) { // TODO Search for requested information
-            std::puts(arg);
+#elif defined(__linux__)
+        std::map<std::string, std::string> cpuInfo = _read_Fields("/proc/cpuinfo");
+        _CPU.name = cpuInfo.contains("model name") ? cpuInfo["model name"] : "Not found";
+        if (cpuInfo.contains("cpu family")) {
+            std::stringstream buffer;
+            buffer << "Family " << cpuInfo["cpu family"] << " Model " << cpuInfo["model"] << " Stepping " << cpuInfo["stepping"] << " " << cpuInfo["vendor_id"];
+            _CPU.description = buffer.str();
+        } else if (cpuInfo.contains("CPU implementer")) {
+            _CPU.description = "Implementer " + cpuInfo["CPU implementer"] + " Part " + cpuInfo["CPU part"];
         }
-        std::free(arg);
-        std::fclose(cpuinfo);
+
+        uint64_t maxFrequencyKHz = 0;
+        for (const Logical_CPU& cpu : _CPUTopology.logicalCpus) maxFrequencyKHz = std::max(maxFrequencyKHz, cpu.maxFrequencyKHz);
+        if (maxFrequencyKHz != 0) _CPU.speed = std::to_string(maxFrequencyKHz / 1000) + "MHz";
+        else if (cpuInfo.contains("cpu MHz")) _CPU.speed = std::to_string(std::strtoul(cpuInfo["cpu MHz"].c_str(), nullptr, 10)) + "MHz";
 #endif
         _CPU.threads = std::to_string(std::thread::hardware_concurrency());
     }
@@ -175,8 +277,11 @@ namespace love_engine {
             L"HARDWARE\\DESCRIPTION\\System\\BIOS",
             L"SystemProductName"
         );
-#elif defined(__unix__)
-        // TODO https://stackoverflow.com/questions/52762707 Use /sys/devices/virtual/dmi/id/board_xxx where xxx is things like name and vendor.
+#elif defined(__linux__)
+        _baseBoard.name = _read_Line("/sys/devices/virtual/dmi/id/board_name");
+        _baseBoard.biosVendor = _read_Line("/sys/devices/virtual/dmi/id/bios_vendor");
+        _baseBoard.biosVersion = _read_Line("/sys/devices/virtual/dmi/id/bios_version");
+        _baseBoard.systemName = _read_Line("/sys/devices/virtual/dmi/id/product_name");
 #endif
     }
     
@@ -186,12 +291,110 @@ namespace love_engine {
         memory.dwLength = sizeof(memory);
         GlobalMemoryStatusEx(&memory);
         _physicalMemory = std::to_string(memory.ullTotalPhys / (1024 * 1024)) + "MB";
+        _memoryInfo.total = memory.ullTotalPhys;
+        _memoryInfo.available = memory.ullAvailPhys;
+        _memoryInfo.swapTotal = memory.ullTotalPageFile - memory.ullTotalPhys;
+#elif defined(__linux__)
+        std::map<std::string, std::string> memInfo = _read_Fields("/proc/meminfo");
+        // Values are in kB
+        _memoryInfo.total = std::strtoull(memInfo["MemTotal"].c_str(), nullptr, 10) * 1024;
+        _memoryInfo.available = std::strtoull(memInfo["MemAvailable"].c_str(), nullptr, 10) * 1024;
+        _memoryInfo.swapTotal = std::strtoull(memInfo["SwapTotal"].c_str(), nullptr, 10) * 1024;
+        _memoryInfo.hugePageSize = std::strtoull(memInfo["Hugepagesize"].c_str(), nullptr, 10) * 1024;
+        _physicalMemory = std::to_string(_memoryInfo.total / (1024 * 1024)) + "MB";
 #elif defined(__unix__)
         struct sysinfo systemInfo;
         sysinfo(&systemInfo);
-        _physicalMemory = std::to_string(systemInfo.totalram / (1024 * 1024)) + "MB"; // TODO Check if this works on Mac, and make sure it doesn't overflow
+        _memoryInfo.total = static_cast<uint64_t>(systemInfo.totalram) * systemInfo.mem_unit;
+        _memoryInfo.available = static_cast<uint64_t>(systemInfo.freeram) * systemInfo.mem_unit;
+        _memoryInfo.swapTotal = static_cast<uint64_t>(systemInfo.totalswap) * systemInfo.mem_unit;
+        _physicalMemory = std::to_string(_memoryInfo.total / (1024 * 1024)) + "MB";
 #endif
     }
+
+    void SystemInfo::_find_CPU_Topology() noexcept {
+        CPU_Topology& topology = _CPUTopology;
+#ifdef __linux__
+        const std::string cpuRoot = "/sys/devices/system/cpu/";
+        std::vector<uint32_t> online = _parse_CPU_List(_read_Line(cpuRoot + "online"));
+        if (online.empty()) {
+            for (uint32_t cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) online.push_back(cpu);
+        }
+
+        std::set<std::tuple<uint32_t, std::string, std::vector<uint32_t>>> seenCaches;
+        for (const uint32_t id : online) {
+            const std::string cpuPath = cpuRoot + "cpu" + std::to_string(id) + "/";
+            Logical_CPU cpu;
+            cpu.id = id;
+            cpu.core = static_cast<uint32_t>(_read_Number(cpuPath + "topology/core_id", id));
+            // -1 on some virtual machines
+            cpu.package = static_cast<uint32_t>(_read_Number(cpuPath + "topology/physical_package_id", 0));
+            cpu.minFrequencyKHz = _read_Number(cpuPath + "cpufreq/cpuinfo_min_freq");
+            cpu.maxFrequencyKHz = _read_Number(cpuPath + "cpufreq/cpuinfo_max_freq");
+            topology.logicalCpus.push_back(cpu);
+
+            std::error_code error;
+            for (uint32_t index = 0; std::filesystem::exists(cpuPath + "cache/index" + std::to_string(index), error); ++index) {
+                const std::string cachePath = cpuPath + "cache/index" + std::to_string(index) + "/";
+                Cache_Info cache;
+                cache.level = static_cast<uint32_t>(_read_Number(cachePath + "level"));
+                cache.type = _read_Line(cachePath + "type");
+                cache.size = _parse_Size(_read_Line(cachePath + "size"));
+                cache.lineSize = static_cast<uint32_t>(_read_Number(cachePath + "coherency_line_size"));
+                cache.cpus = _parse_CPU_List(_read_Line(cachePath + "shared_cpu_list"));
+                if (cache.cpus.empty()) cache.cpus.push_back(id);
+                if (seenCaches.emplace(cache.level, cache.type, cache.cpus).second) topology.caches.push_back(std::move(cache));
+            }
+        }
+
+        const std::string nodeRoot = "/sys/devices/system/node/";
+        for (const uint32_t id : _parse_CPU_List(_read_Line(nodeRoot + "online"))) {
+            const std::string nodePath = nodeRoot + "node" + std::to_string(id) + "/";
+            NUMA_Node node;
+            node.id = id;
+            node.cpus = _parse_CPU_List(_read_Line(nodePath + "cpulist"));
+            // "Node 0 MemTotal:       32658244 kB"
+            std::ifstream memInfo(nodePath + "meminfo");
+            std::string line;
+            while (std::getline(memInfo, line)) {
+                const size_t field = line.find("MemTotal:");
+                if (field == std::string::npos) continue;
+                node.memory = std::strtoull(line.c_str() + field + sizeof("MemTotal:") - 1, nullptr, 10) * 1024;
+                break;
+            }
+            for (Logical_CPU& cpu : topology.logicalCpus) {
+                if (std::find(node.cpus.begin(), node.cpus.end(), cpu.id) != node.cpus.end()) cpu.node = id;
+            }
+            topology.nodes.push_back(std::move(node));
+        }
+#else
+        for (uint32_t id = 0; id < std::max(1u, std::thread::hardware_concurrency()); ++id) {
+            topology.logicalCpus.push_back(Logical_CPU{
+                .id = id,
+                .core = id,
+                .package = 0,
+                .node = 0,
+                .minFrequencyKHz = 0,
+                .maxFrequencyKHz = 0,
+            });
+        }
+#endif
+
+        if (topology.nodes.empty()) {
+            NUMA_Node node{.id = 0, .cpus = {}, .memory = _memoryInfo.total};
+            for (const Logical_CPU& cpu : topology.logicalCpus) node.cpus.push_back(cpu.id);
+            topology.nodes.push_back(std::move(node));
+        }
+        std::set<std::pair<uint32_t, uint32_t>> cores;
+        std::set<uint32_t> packages;
+        for (const Logical_CPU& cpu : topology.logicalCpus) {
+            cores.emplace(cpu.package, cpu.core);
+            packages.insert(cpu.package);
+        }
+        topology.physicalCores = cores.size();
+        topology.packages = packages.size();
+        std::stable_sort(topology.caches.begin(), topology.caches.end(), [](const Cache_Info& a, const Cache_Info& b) { return a.level < b.level; });
+    }
     // sysconf and fscanf on hwmon (Linux)
     // Linux: https://stackoverflow.com/questions/23716135/
     
@@ -199,29 +402,34 @@ namespace love_engine {
 
     void SystemInfo::_set_Consolidated_System_Info() noexcept {
         std::stringstream buffer;
-        buffer << "OS: " << get_OS();
-        buffer << "\nSystem Name: " << get_System_Name();
-        buffer << "\nPhysical Memory: " << get_Physical_Memory();
-
-        get_CPU();
+        buffer << "OS: " << _OS;
+        buffer << "\nSystem Name: " << _systemName;
+        buffer << "\nPhysical Memory: " << _physicalMemory << " (" << (_memoryInfo.available / (1024 * 1024)) << "MB available)";
         buffer << "\nCPU:";
         buffer << "\n\tName: " << _CPU.name;
         buffer << "\n\tDescription: " << _CPU.description;
         buffer << "\n\tThreads: " << _CPU.threads;
         buffer << "\n\tMax Speed: " << _CPU.speed;
+        buffer << "\n\tTopology: " << _CPUTopology.logicalCpus.size() << " logical CPUs, " << _CPUTopology.physicalCores
+            << " cores, " << _CPUTopology.packages << " packages, " << _CPUTopology.nodes.size() << " NUMA nodes";
+        // Identical caches of different cores are listed once with a count
+        std::map<std::tuple<uint32_t, std::string, uint64_t>, size_t> caches;
+        for (const Cache_Info& cache : _CPUTopology.caches) ++caches[{cache.level, cache.type, cache.size}];
+        for (const auto& [cache, count] : caches) {
+            buffer << "\n\tL" << std::get<0>(cache) << " " << std::get<1>(cache) << ": " << count << " x " << (std::get<2>(cache) / 1024) << "KB";
+        }
 
         buffer << "\nVideo Cards:";
-        if (get_Video_Cards().empty()) {
+        if (_video_Cards.empty()) {
             buffer << "\n\tNo video cards found.";
         } else {
-            for (auto gpu : get_Video_Cards()) {
+            for (auto gpu : _video_Cards) {
                 buffer << "\n\t" << gpu.name;
                 buffer << "\n\t\tDriver Version: " << gpu.driverVersion;
                 buffer << "\n\t\tMemory: " << gpu.memory;
             }
         }
 
-        get_Base_Board();
         buffer << "\nBase Board:";
         buffer << "\n\tName: " << _baseBoard.name;
         buffer << "\n\tBIOS Vendor: " << _baseBoard.biosVendor;
@@ -231,32 +439,84 @@ namespace love_engine {
         _consolidated_System_Info.assign(buffer.str());
     }
 
+    void SystemInfo::_probe() noexcept {
+        // Memory first, for single node topologies, then topology, for the CPU's speed
+        _find_Physical_Memory();
+        _find_CPU_Topology();
+        _find_CPU();
+        _find_OS();
+        _find_System_Name();
+        _find_Video_Cards();
+        _find_Base_Board();
+        _set_Consolidated_System_Info();
+
+        {
+            std::lock_guard<std::mutex> lock(_probeMutex);
+            _probeState = Probe_State::DONE;
+        }
+        _probed.store(true, std::memory_order_release);
+        _probeDone.notify_all();
+    }
+
+    void SystemInfo::_wait_For_Probe() noexcept {
+        if (_probed.load(std::memory_order_acquire)) return;
+        std::unique_lock<std::mutex> lock(_probeMutex);
+        if (_probeState == Probe_State::NOT_STARTED) {
+            _probeState = Probe_State::RUNNING;
+            lock.unlock();
+            _probe();
+            return;
+        }
+        _probeDone.wait(lock, []() { return _probeState == Probe_State::DONE; });
+    }
+
+    void SystemInfo::start_Probe() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(_probeMutex);
+            if (_probeState != Probe_State::NOT_STARTED) return;
+            _probeState = Probe_State::RUNNING;
+        }
+        Thread probeThread("SYSTEM_INFO_PROBE", []() { _probe(); });
+    }
+
+    const char* SystemInfo::get_Consolidated_System_Info_If_Ready() noexcept {
+        return _probed.load(std::memory_order_acquire) ? _consolidated_System_Info.c_str() : nullptr;
+    }
+
     std::string SystemInfo::get_Consolidated_System_Info() noexcept {
-        if (_consolidated_System_Info.empty()) _set_Consolidated_System_Info();
+        _wait_For_Probe();
         return _consolidated_System_Info;
     }
     std::string SystemInfo::get_OS() noexcept {
-        if (_OS.empty()) _find_OS();
+        _wait_For_Probe();
         return _OS;
     }
     std::string SystemInfo::get_System_Name() noexcept {
-        if (_systemName.empty()) _find_System_Name();
+        _wait_For_Probe();
         return _systemName;
     }
     SystemInfo::CPU_Info SystemInfo::get_CPU() noexcept {
-        if (_CPU.name.empty()) _find_CPU();
+        _wait_For_Probe();
         return _CPU;
     }
     std::vector<SystemInfo::VideoCardInfo> SystemInfo::get_Video_Cards() noexcept {
-        if (_video_Cards.empty()) _find_Video_Cards();
+        _wait_For_Probe();
         return _video_Cards;
     }
     SystemInfo::BaseBoardInfo SystemInfo::get_Base_Board() noexcept {
-        if (_baseBoard.name.empty()) _find_Base_Board();
+        _wait_For_Probe();
         return _baseBoard;
     }
     std::string SystemInfo::get_Physical_Memory() noexcept {
-        if (_physicalMemory.empty()) _find_Physical_Memory();
+        _wait_For_Probe();
         return _physicalMemory;
     }
+    const SystemInfo::CPU_Topology& SystemInfo::get_CPU_Topology() noexcept {
+        _wait_For_Probe();
+        return _CPUTopology;
+    }
+    const SystemInfo::Memory_Info& SystemInfo::get_Memory_Info() noexcept {
+        _wait_For_Probe();
+        return _memoryInfo;
+    }
 }
@@ -1,11 +1,16 @@
 #ifndef LOVE_DEVICE_INFO_HPP
 #define LOVE_DEVICE_INFO_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace love_engine {
 
+    // Probes the OS and hardware once and caches the results. Probing reads many files on Linux, so start_Probe()
+    // runs it in the background at startup. Getters wait for a probe in progress, or probe on the calling thread
+    // if none was started.
+    // Thread-safe.
     class SystemInfo {
         public:
             typedef struct CPU_Info_ {
@@ -26,6 +31,56 @@ namespace love_engine {
                 std::string systemName;
             } BaseBoardInfo;
 
+            typedef struct Cache_Info_ {
+                uint32_t level = 0;
+                // "Data", "Instruction" or "Unified"
+                std::string type;
+                // Bytes
+                uint64_t size = 0;
+                uint32_t lineSize = 0;
+                // Logical CPUs sharing the cache
+                std::vector<uint32_t> cpus;
+            } Cache_Info;
+            typedef struct Logical_CPU_ {
+                uint32_t id = 0;
+                // Unique within a package. Logical CPUs sharing a package and core are SMT siblings.
+                uint32_t core = 0;
+                uint32_t package = 0;
+                uint32_t node = 0;
+                // 0 if unknown
+                uint64_t minFrequencyKHz = 0;
+                uint64_t maxFrequencyKHz = 0;
+            } Logical_CPU;
+            typedef struct NUMA_Node_ {
+                uint32_t id = 0;
+                std::vector<uint32_t> cpus;
+                // Bytes
+                uint64_t memory = 0;
+            } NUMA_Node;
+            // Outside Linux, every logical CPU is reported as its own core in one package and node.
+            typedef struct CPU_Topology_ {
+                // Online logical CPUs, sorted by id
+                std::vector<Logical_CPU> logicalCpus;
+                size_t physicalCores = 0;
+                size_t packages = 0;
+                // Every cache once, sorted by level
+                std::vector<Cache_Info> caches;
+                std::vector<NUMA_Node> nodes;
+            } CPU_Topology;
+            // Bytes, 0 if unknown
+            typedef struct Memory_Info_ {
+                uint64_t total = 0;
+                uint64_t available = 0;
+                uint64_t swapTotal = 0;
+                uint64_t hugePageSize = 0;
+            } Memory_Info;
+
+            // Starts probing on a background thread. Does nothing if probing already started.
+            static void start_Probe() noexcept;
+            // Async-signal-safe, for crash handlers.
+            // @return nullptr until probing has finished.
+            static const char* get_Consolidated_System_Info_If_Ready() noexcept;
+
             static std::string get_Consolidated_System_Info() noexcept;
             static std::string get_OS() noexcept;
             static std::string get_System_Name() noexcept;
@@ -33,8 +88,13 @@ namespace love_engine {
             static std::vector<VideoCardInfo> get_Video_Cards() noexcept;
             static BaseBoardInfo get_Base_Board() noexcept;
             static std::string get_Physical_Memory() noexcept;
+            // Never changes once probed.
+            static const CPU_Topology& get_CPU_Topology() noexcept;
+            static const Memory_Info& get_Memory_Info() noexcept;
 
         private:
+            static void _probe() noexcept;
+            static void _wait_For_Probe() noexcept;
             static void _set_Consolidated_System_Info() noexcept;
             static void _find_OS() noexcept;
             static void _find_System_Name() noexcept;
@@ -42,6 +102,7 @@ namespace love_engine {
             static void _find_Video_Cards() noexcept;
             static void _find_Base_Board() noexcept;
             static void _find_Physical_Memory() noexcept;
+            static void _find_CPU_Topology() noexcept;
     };
 
 }
@@ -0,0 +1,147 @@
+#ifndef LOVE_TASK_HPP
+#define LOVE_TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace love_engine {
+    template<class T>
+    class Task;
+
+    class TaskPromiseBase {
+        public:
+            // Resumes whoever awaited the task, or frees a detached task's frame
+            struct Final_Awaiter {
+                bool await_ready() const noexcept { return false; }
+                template<class Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                    TaskPromiseBase& promise = handle.promise();
+                    if (promise.continuation) return promise.continuation;
+                    if (promise.detached) handle.destroy();
+                    return std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            Final_Awaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+            bool detached = false;
+    };
+
+    template<class T>
+    class TaskPromise : public TaskPromiseBase {
+        public:
+            Task<T> get_return_object() noexcept;
+            template<class U>
+            void return_value(U&& value) { result.emplace(std::forward<U>(value)); }
+
+            std::optional<T> result;
+    };
+
+    template<>
+    class TaskPromise<void> : public TaskPromiseBase {
+        public:
+            Task<void> get_return_object() noexcept;
+            void return_void() const noexcept {}
+    };
+
+    // Coroutine returning T. Starts when first awaited, and resumes the awaiting coroutine on whichever thread it
+    // finished on. Use Async::resume_On() or ServerInstance::next_Tick() to choose the thread.
+    // Exceptions thrown by the coroutine are rethrown from co_await and get().
+    // NOTE: A task must be awaited, detached or waited for; destroying one that never ran just frees it.
+    template<class T = void>
+    class Task {
+        public:
+            typedef TaskPromise<T> promise_type;
+
+            Task() noexcept = default;
+            explicit Task(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+            Task(Task&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+            Task& operator=(Task&& other) noexcept {
+                if (this != &other) {
+                    if (_handle) _handle.destroy();
+                    _handle = std::exchange(other._handle, nullptr);
+                }
+                return *this;
+            }
+            Task(Task const&) = delete;
+            void operator=(Task const&) = delete;
+            ~Task() {
+                if (_handle) _handle.destroy();
+            }
+
+            auto operator co_await() noexcept {
+                struct Awaiter : Start_Awaiter {
+                    T await_resume() { return Task::_get_Result(this->handle); }
+                };
+                return Awaiter{{_handle}};
+            }
+
+            // Starts the task without anyone awaiting it. Its frame is freed when it finishes, and exceptions
+            // it throws are dropped.
+            void detach() && noexcept {
+                if (!_handle) return;
+                std::coroutine_handle<promise_type> handle = std::exchange(_handle, nullptr);
+                handle.promise().detached = true;
+                handle.resume();
+            }
+
+            // Runs the task and blocks the calling thread until it finishes.
+            // NOTE: Must not be called from a thread the task needs to finish, e.g. the tick thread for a task
+            // that awaits the next tick.
+            // @throw Whatever the coroutine threw.
+            T get() {
+                std::promise<void> finished;
+                std::future<void> finishedFuture = finished.get_future();
+                _wait(_handle, finished).detach();
+                finishedFuture.get();
+                return _get_Result(_handle);
+            }
+
+            bool is_Done() const noexcept { return !_handle || _handle.done(); }
+
+        private:
+            // Starts the task and resumes the awaiting coroutine when it finishes
+            struct Start_Awaiter {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() const noexcept { return !handle || handle.done(); }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+                void await_resume() const noexcept {}
+            };
+
+            static Task<void> _wait(std::coroutine_handle<promise_type> handle, std::promise<void>& finished) {
+                co_await Start_Awaiter{handle};
+                finished.set_value();
+            }
+
+            static T _get_Result(std::coroutine_handle<promise_type> handle) {
+                if (handle.promise().exception) std::rethrow_exception(handle.promise().exception);
+                if constexpr (!std::is_void_v<T>) return std::move(*handle.promise().result);
+            }
+
+            std::coroutine_handle<promise_type> _handle;
+    };
+
+    template<class T>
+    Task<T> TaskPromise<T>::get_return_object() noexcept {
+        return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+        return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+    }
+}
+
+#endif // LOVE_TASK_HPP
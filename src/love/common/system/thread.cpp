@@ -1,13 +1,17 @@
 #include "thread.hpp"
 
-#include <chrono>
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <unordered_map>
 
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
 namespace love_engine {
     std::mutex _threadsMutex;
-    volatile size_t _openThreads = 1; // NOTE: Setting to "1" accounts for main thread.
+    std::atomic<size_t> _openThreads = 1; // NOTE: Setting to "1" accounts for main thread.
     std::unordered_map<std::thread::id, std::string> _threadNames;
 
     std::string Thread::get_Thread_Name(const std::thread::id& id) noexcept {
@@ -21,6 +25,10 @@ namespace love_engine {
         _threadsMutex.lock();
         _threadNames[id] = name;
         _threadsMutex.unlock();
+#ifdef __linux__
+        // Shown by debuggers and read by the crash signal handler, which cannot lock _threadsMutex
+        if (id == std::this_thread::get_id()) pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
     }
 
     void Thread::unregister_Thread(const std::thread::id& id) noexcept {
@@ -30,16 +38,8 @@ namespace love_engine {
         --_openThreads;
     }
 
-    void Thread::wait_For_Threads() noexcept {
-        unregister_Thread(std::this_thread::get_id());
-
-        constexpr int MS_PER_TRY = 100;
-        constexpr int MAX_TRIES = 5000 / MS_PER_TRY; // 5 seconds, 50 tries
-        int tries = 0;
-        do {
-            std::this_thread::sleep_for(std::chrono::milliseconds(MS_PER_TRY));
-        }
-        while ((_openThreads > 0) && (++tries <= MAX_TRIES));
+    size_t Thread::get_Open_Thread_Count() noexcept {
+        return _openThreads.load();
     }
 
     void Thread::_add_To_Thread_Count() noexcept {
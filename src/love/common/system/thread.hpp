@@ -1,6 +1,8 @@
 #ifndef LOVE_THREADS_HPP
 #define LOVE_THREADS_HPP
 
+#include "../error/crash.hpp"
+
 #include <functional>
 #include <string>
 #include <thread>
@@ -24,7 +26,7 @@ namespace love_engine {
             Thread(Thread const&) = delete;
             void operator=(Thread const&) = delete;
             ~Thread() {
-                _thread.detach();
+                if (_thread.joinable()) _thread.detach();
             }
 
             std::thread::id get_id() const noexcept { return _thread.get_id(); }
@@ -42,19 +44,22 @@ namespace love_engine {
                 register_Thread(id, name);
             }
 
+            // Registering the calling thread also sets its native name, truncated to what the OS allows.
             // NOTE: Recommended to not use this functions unless native threads are absolutely necessary.
             static void register_Thread(const std::thread::id& id, const std::string& name) noexcept;
             // NOTE: Recommended to not use this functions unless native threads are absolutely necessary.
             static void unregister_Thread(const std::thread::id& id) noexcept;
 
-            // NOTE: Should only be called by main thread.
-            static void wait_For_Threads() noexcept;
+            // Includes the main thread.
+            static size_t get_Open_Thread_Count() noexcept;
 
         private:
             template<class F, class... Args>
             static void _handle_Thread(const std::string name, F&& f, Args&&... args) {
                 register_Thread(std::this_thread::get_id(), name);
+                Crash::add_Signal_Stack();
                 f(args...);
+                Crash::remove_Signal_Stack();
                 unregister_Thread(std::this_thread::get_id());
             }
 
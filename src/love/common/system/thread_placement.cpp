@@ -0,0 +1,196 @@
+#include "thread_placement.hpp"
+
+#include "system_info.hpp"
+
+#include <algorithm>
+#include <map>
+#include <new>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace love_engine {
+    typedef struct Core_ {
+        uint32_t node;
+        // Logical CPUs, the first one preferred
+        std::vector<uint32_t> cpus;
+    } Core;
+
+    typedef struct Plan_ {
+        ThreadPlacement::Assignment tick;
+        ThreadPlacement::Assignment network;
+        std::vector<ThreadPlacement::Assignment> workers;
+        size_t physicalCores = 0;
+    } Plan;
+
+    // @return Whether the process may run on @p cpu.
+    static bool _is_Allowed([[maybe_unused]] const uint32_t cpu) noexcept {
+#if defined(__linux__)
+        // Read before anything is pinned, since every pin makes the plan first. Includes cgroup cpuset limits.
+        static const std::pair<bool, cpu_set_t> allowed = []() {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            return std::pair<bool, cpu_set_t>(sched_getaffinity(0, sizeof(set), &set) == 0, set);
+        }();
+        return !allowed.first || ((cpu < CPU_SETSIZE) && CPU_ISSET(cpu, &allowed.second));
+#elif defined(_WIN32)
+        static const std::pair<bool, DWORD_PTR> allowed = []() {
+            DWORD_PTR processMask = 0, systemMask = 0;
+            return std::pair<bool, DWORD_PTR>(GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask) != 0, processMask);
+        }();
+        return !allowed.first || ((cpu < sizeof(DWORD_PTR) * 8) && (allowed.second & (static_cast<DWORD_PTR>(1) << cpu)));
+#else
+        return true;
+#endif
+    }
+
+    static Plan _make_Plan() noexcept {
+        const SystemInfo::CPU_Topology& topology = SystemInfo::get_CPU_Topology();
+        std::map<std::tuple<uint32_t, uint32_t, uint32_t>, Core> coreMap;
+        for (const SystemInfo::Logical_CPU& cpu : topology.logicalCpus) {
+            if (!_is_Allowed(cpu.id)) continue;
+            Core& core = coreMap[{cpu.node, cpu.package, cpu.core}];
+            core.node = cpu.node;
+            core.cpus.push_back(cpu.id);
+        }
+        std::vector<Core> cores;
+        for (auto& [key, core] : coreMap) cores.push_back(std::move(core));
+
+        Plan plan;
+        plan.physicalCores = cores.size();
+        if (cores.size() < 3) return plan;
+
+        // Core 0 handles most interrupts and housekeeping, so it is only used when there are few cores
+        const size_t tickCore = (cores.size() >= 4) ? 1 : 0;
+        plan.tick = ThreadPlacement::Assignment{.cpus = {cores[tickCore].cpus[0]}, .node = cores[tickCore].node};
+        plan.network = ThreadPlacement::Assignment{.cpus = {cores[tickCore + 1].cpus[0]}, .node = cores[tickCore + 1].node};
+
+        // The reserved cores' siblings stay idle. Workers fill one thread per core before any sibling.
+        std::vector<Core> workerCores;
+        for (size_t i = 0; i < cores.size(); ++i) {
+            if ((i != tickCore) && (i != tickCore + 1)) workerCores.push_back(cores[i]);
+        }
+        std::stable_partition(workerCores.begin(), workerCores.end(), [&plan](const Core& core) { return core.node == plan.tick.node; });
+        for (size_t thread = 0; !workerCores.empty(); ++thread) {
+            bool added = false;
+            for (const Core& core : workerCores) {
+                if (thread >= core.cpus.size()) continue;
+                plan.workers.push_back(ThreadPlacement::Assignment{.cpus = {core.cpus[thread]}, .node = core.node});
+                added = true;
+            }
+            if (!added) break;
+        }
+        return plan;
+    }
+
+    static const Plan& _get_Plan() noexcept {
+        static const Plan plan = _make_Plan();
+        return plan;
+    }
+
+    ThreadPlacement::Assignment ThreadPlacement::get_Assignment(const Role role, const size_t index) noexcept {
+        const Plan& plan = _get_Plan();
+        switch (role) {
+            case Role::TICK: return plan.tick;
+            case Role::NETWORK_IO: return plan.network;
+            case Role::WORKER: return (index < plan.workers.size()) ? plan.workers[index] : Assignment{};
+        }
+        return Assignment{};
+    }
+
+    size_t ThreadPlacement::get_Worker_Count() noexcept {
+        return _get_Plan().workers.size();
+    }
+
+    bool ThreadPlacement::pin_Current_Thread(const Role role, const size_t index) noexcept {
+        return pin_Current_Thread(get_Assignment(role, index));
+    }
+
+    bool ThreadPlacement::pin_Current_Thread(const Assignment& assignment) noexcept {
+        if (assignment.cpus.empty()) return false;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (const uint32_t cpu : assignment.cpus) CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) return false;
+
+        if (SystemInfo::get_CPU_Topology().nodes.size() > 1) {
+            unsigned long nodeMask[16] = {};
+            if (assignment.node < sizeof(nodeMask) * 8) {
+                nodeMask[assignment.node / (sizeof(unsigned long) * 8)] |= 1ul << (assignment.node % (sizeof(unsigned long) * 8));
+                syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask, sizeof(nodeMask) * 8);
+            }
+        }
+        return true;
+#elif defined(_WIN32)
+        DWORD_PTR mask = 0;
+        for (const uint32_t cpu : assignment.cpus) {
+            if (cpu >= sizeof(DWORD_PTR) * 8) return false; // NOTE: Other processor groups are not handled.
+            mask |= static_cast<DWORD_PTR>(1) << cpu;
+        }
+        return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+        return false;
+#endif
+    }
+
+    uint32_t ThreadPlacement::get_Current_Node() noexcept {
+#ifdef __linux__
+        unsigned int cpu = 0, node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return node;
+#endif
+        return 0;
+    }
+
+    void* ThreadPlacement::allocate_Local(const size_t size) noexcept {
+#ifdef __linux__
+        void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) return nullptr;
+        const uint32_t node = get_Current_Node();
+        unsigned long nodeMask[16] = {};
+        if ((SystemInfo::get_CPU_Topology().nodes.size() > 1) && (node < sizeof(nodeMask) * 8)) {
+            nodeMask[node / (sizeof(unsigned long) * 8)] |= 1ul << (node % (sizeof(unsigned long) * 8));
+            // Preferred rather than bound, so a full node falls back instead of failing
+            syscall(SYS_mbind, memory, size, MPOL_PREFERRED, nodeMask, sizeof(nodeMask) * 8, 0);
+        }
+        return memory;
+#else
+        return ::operator new(size, std::align_val_t(4096), std::nothrow);
+#endif
+    }
+
+    void ThreadPlacement::free_Local(void* memory, [[maybe_unused]] const size_t size) noexcept {
+        if (memory == nullptr) return;
+#ifdef __linux__
+        munmap(memory, size);
+#else
+        ::operator delete(memory, std::align_val_t(4096));
+#endif
+    }
+
+    std::string ThreadPlacement::get_Description() noexcept {
+        const Plan& plan = _get_Plan();
+        std::stringstream buffer;
+        if (plan.tick.cpus.empty()) {
+            buffer << "Unpinned (" << plan.physicalCores << " physical cores)";
+            return buffer.str();
+        }
+        buffer << "Tick: CPU " << plan.tick.cpus[0] << " (node " << plan.tick.node << ")";
+        buffer << "\nNetwork I/O: CPU " << plan.network.cpus[0] << " (node " << plan.network.node << ")";
+        buffer << "\nWorkers:";
+        for (const Assignment& worker : plan.workers) buffer << " " << worker.cpus[0];
+        return buffer.str();
+    }
+}
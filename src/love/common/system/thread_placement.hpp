@@ -0,0 +1,54 @@
+#ifndef LOVE_THREAD_PLACEMENT_HPP
+#define LOVE_THREAD_PLACEMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    // Places threads on CPUs using SystemInfo::get_CPU_Topology(), so latency-critical threads do not migrate
+    // between cores or sockets.
+    // Latency-critical roles get a physical core each, with its SMT siblings left idle. The tick thread and the
+    // network I/O thread never share a core. Workers get the remaining cores, on the tick thread's NUMA node first,
+    // and use SMT siblings only after every core has one worker.
+    // Only CPUs in the process's affinity mask are used, so cpusets and container limits are respected.
+    // Pinning does nothing on platforms without thread affinity, or with fewer than 3 physical cores.
+    class ThreadPlacement {
+        public:
+            enum class Role {
+                TICK,
+                NETWORK_IO,
+                WORKER,
+            };
+
+            typedef struct Assignment_ {
+                // Empty if the thread should not be pinned
+                std::vector<uint32_t> cpus;
+                uint32_t node = 0;
+            } Assignment;
+
+            // @param index Worker index. Workers beyond get_Worker_Count() are not pinned, so no two share a CPU.
+            static Assignment get_Assignment(const Role role, const size_t index = 0) noexcept;
+            // @return Number of workers with a CPU of their own, or 0 if nothing is pinned.
+            static size_t get_Worker_Count() noexcept;
+
+            // Pins the calling thread and makes the kernel prefer its node for the pages it touches first.
+            // @return Whether the thread was pinned.
+            static bool pin_Current_Thread(const Role role, const size_t index = 0) noexcept;
+            static bool pin_Current_Thread(const Assignment& assignment) noexcept;
+
+            // @return NUMA node of the CPU the calling thread is running on.
+            static uint32_t get_Current_Node() noexcept;
+
+            // Page-aligned memory bound to the calling thread's NUMA node. Falls back to the heap where binding is
+            // unsupported. Release with free_Local() and the same size.
+            static void* allocate_Local(const size_t size) noexcept;
+            static void free_Local(void* memory, const size_t size) noexcept;
+
+            // One line per role, for logs and tools.
+            static std::string get_Description() noexcept;
+    };
+}
+
+#endif // LOVE_THREAD_PLACEMENT_HPP
@@ -0,0 +1,105 @@
+#include "thread_pool.hpp"
+
+#include "thread_placement.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace love_engine {
+    ThreadPool::ThreadPool(const std::string& name, const size_t threadCount, const bool pinWorkers) {
+        size_t count = std::max<size_t>(threadCount, 1);
+        // More workers than CPUs set aside for them would share those CPUs with the tick thread
+        if (pinWorkers && (ThreadPlacement::get_Worker_Count() > 0)) count = std::min(count, ThreadPlacement::get_Worker_Count());
+        _workers.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            _workers.push_back(std::make_unique<Thread>(
+                name + "_" + std::to_string(i),
+                [this, i, pinWorkers]() {
+                    if (pinWorkers) ThreadPlacement::pin_Current_Thread(ThreadPlacement::Role::WORKER, i);
+                    _worker_Loop();
+                }
+            ));
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _taskAvailable.notify_all();
+        for (auto& worker : _workers) worker->join();
+    }
+
+    void ThreadPool::submit(std::function<void()> task) noexcept {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+            ++_activeTasks;
+        }
+        _taskAvailable.notify_one();
+    }
+
+    void ThreadPool::wait_For_Idle() noexcept {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this]() { return _activeTasks == 0; });
+    }
+
+    void ThreadPool::parallel_For(const size_t begin, const size_t end, size_t chunkSize, const std::function<void(size_t, size_t)>& f) noexcept {
+        if (end <= begin) return;
+        const size_t count = end - begin;
+        if (chunkSize == 0) chunkSize = std::max<size_t>(1, count / (_workers.size() * 4));
+        const size_t chunks = (count + chunkSize - 1) / chunkSize;
+        if (chunks == 1) {
+            f(begin, end);
+            return;
+        }
+
+        // NOTE: Shared so helpers that start after the loop finished still touch valid memory.
+        struct Loop_State {
+            std::atomic<size_t> nextChunk = 0;
+            std::atomic<size_t> doneChunks = 0;
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        auto state = std::make_shared<Loop_State>();
+
+        // Returns once no chunks are left to claim
+        auto runChunks = [state, begin, end, chunkSize, chunks, &f]() {
+            size_t chunk;
+            while ((chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks) {
+                const size_t chunkBegin = begin + chunk * chunkSize;
+                f(chunkBegin, std::min(chunkBegin + chunkSize, end));
+                if (state->doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->done.notify_all();
+                }
+            }
+        };
+
+        const size_t helpers = std::min(chunks, _workers.size()) - 1;
+        for (size_t i = 0; i < helpers; ++i) submit(runChunks);
+        runChunks();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&state, chunks]() { return state->doneChunks.load(std::memory_order_acquire) == chunks; });
+    }
+
+    void ThreadPool::_worker_Loop() noexcept {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _taskAvailable.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                if (_tasks.empty()) return; // Stopping
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+
+            task();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_activeTasks == 0) _idle.notify_all();
+        }
+    }
+}
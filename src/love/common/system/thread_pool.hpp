@@ -0,0 +1,50 @@
+#ifndef LOVE_THREAD_POOL_HPP
+#define LOVE_THREAD_POOL_HPP
+
+#include "thread.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    class ThreadPool {
+        public:
+            // @param name Prefix of the registered worker thread names, e.g. "WORKER" -> "WORKER_0".
+            // @param pinWorkers Pins worker i to ThreadPlacement's worker i. Only one pool should be pinned. A pinned
+            // pool has at most ThreadPlacement::get_Worker_Count() workers, unless nothing is pinned.
+            ThreadPool(const std::string& name, const size_t threadCount = std::thread::hardware_concurrency(), const bool pinWorkers = false);
+            ThreadPool(ThreadPool const&) = delete;
+            void operator=(ThreadPool const&) = delete;
+            ~ThreadPool();
+
+            void submit(std::function<void()> task) noexcept;
+            // Blocks until every submitted task has finished.
+            void wait_For_Idle() noexcept;
+
+            // Splits [begin, end) into chunks of @p chunkSize and runs @p f(chunkBegin, chunkEnd) on them.
+            // The calling thread works on chunks too, so this is safe to call from inside a worker.
+            // @param chunkSize 0 picks a chunk size that gives every worker a few chunks.
+            void parallel_For(const size_t begin, const size_t end, size_t chunkSize, const std::function<void(size_t, size_t)>& f) noexcept;
+
+            size_t get_Thread_Count() const noexcept { return _workers.size(); }
+
+        private:
+            void _worker_Loop() noexcept;
+
+            std::vector<std::unique_ptr<Thread>> _workers;
+            std::deque<std::function<void()>> _tasks;
+            std::mutex _mutex;
+            std::condition_variable _taskAvailable;
+            std::condition_variable _idle;
+            size_t _activeTasks = 0;
+            bool _stopping = false;
+    };
+}
+
+#endif // LOVE_THREAD_POOL_HPP
@@ -0,0 +1,32 @@
+#ifndef LOVE_COMMAND_HPP
+#define LOVE_COMMAND_HPP
+
+#include <love/common/data/bkv/bkv_builder.hpp>
+
+#include <string>
+
+namespace love_engine {
+    class ServerInstance;
+
+    // Input from the network or console, executed by the tick thread at a fixed point in the tick.
+    // Create commands through CommandQueue::push().
+    class Command {
+        public:
+            virtual ~Command() = default;
+
+            virtual void execute(ServerInstance& server) noexcept = 0;
+
+            // Name the command type is registered under with CommandQueue::register_Command_Type().
+            virtual std::string get_Type() const noexcept = 0;
+            // Writes the fields needed to reconstruct the command.
+            virtual void serialize(BKV_Builder& builder) const = 0;
+
+        private:
+            friend class CommandQueue;
+
+            Command* _next = nullptr;
+            bool _heapAllocated = false;
+    };
+}
+
+#endif // LOVE_COMMAND_HPP
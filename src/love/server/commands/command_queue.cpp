@@ -0,0 +1,134 @@
+#include "command_queue.hpp"
+
+#include <love/common/data/bkv/bkv_builder.hpp>
+#include <love/common/data/files/logger.hpp>
+#include <love/common/error/stack_trace.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace love_engine {
+    std::mutex _commandTypesMutex;
+    std::unordered_map<std::string, CommandQueue::Deserializer> _commandTypes;
+
+    CommandQueue::CommandQueue(const size_t arenaSize) {
+        for (Arena& arena : _arenas) {
+            arena.buffer = std::make_unique<std::byte[]>(arenaSize);
+            arena.capacity = arenaSize;
+        }
+    }
+
+    CommandQueue::~CommandQueue() {
+        Command* command = _head.exchange(nullptr, std::memory_order_acquire);
+        while (command != nullptr) {
+            Command* next = command->_next;
+            _destroy(command);
+            command = next;
+        }
+    }
+
+    void* CommandQueue::Arena::allocate(const size_t size, const size_t alignment) noexcept {
+        // Reserve the worst case padding so no compare-exchange loop is needed
+        const size_t reserved = size + alignment - 1;
+        const size_t head = offset.fetch_add(reserved, std::memory_order_relaxed);
+        if (head + reserved > capacity) return nullptr;
+
+        const uintptr_t address = reinterpret_cast<uintptr_t>(buffer.get() + head);
+        return reinterpret_cast<void*>((address + alignment - 1) & ~(alignment - 1));
+    }
+
+    CommandQueue::Arena& CommandQueue::_pin_Arena() noexcept {
+        // NOTE: Sequentially consistent so either execute_Commands() sees the writer, or the writer sees the swap.
+        while (true) {
+            const size_t index = _currentArena.load();
+            _arenas[index].writers.fetch_add(1);
+            if (_currentArena.load() == index) return _arenas[index];
+            _arenas[index].writers.fetch_sub(1);
+        }
+    }
+
+    void CommandQueue::_push(Command* command) noexcept {
+        command->_next = _head.load(std::memory_order_relaxed);
+        while (!_head.compare_exchange_weak(command->_next, command, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void CommandQueue::_destroy(Command* command) noexcept {
+        if (command->_heapAllocated) delete command;
+        else command->~Command();
+    }
+
+    size_t CommandQueue::execute_Commands(ServerInstance& server) noexcept {
+        // Swap arenas, then wait for producers still writing into the old one
+        const size_t previousArena = _currentArena.load();
+        _currentArena.store(previousArena ^ 1);
+        while (_arenas[previousArena].writers.load() != 0) std::this_thread::yield();
+
+        // The list is newest first, reverse it to execute in push order
+        Command* command = _head.exchange(nullptr, std::memory_order_acquire);
+        Command* ordered = nullptr;
+        while (command != nullptr) {
+            Command* next = command->_next;
+            command->_next = ordered;
+            ordered = command;
+            command = next;
+        }
+
+        size_t executed = 0;
+        while (ordered != nullptr) {
+            Command* next = ordered->_next;
+            if (_listener) {
+                try {
+                    _listener(*ordered);
+                } catch (const std::exception& e) {
+                    if (_logger) _logger->log(Log_Status::ERROR, std::string("Command listener failed: ") + e.what());
+                } catch (...) {
+                    if (_logger) _logger->log(Log_Status::ERROR, "Command listener failed.");
+                }
+            }
+            ordered->execute(server);
+            _destroy(ordered);
+            ordered = next;
+            ++executed;
+        }
+
+        // Every command allocated from the old arena has been executed
+        _arenas[previousArena].offset.store(0, std::memory_order_relaxed);
+        return executed;
+    }
+
+    BKV CommandQueue::serialize_Command(const Command& command) {
+        BKV_Builder builder;
+        builder.add_String("type", command.get_Type());
+        builder.open_Compound("data");
+        command.serialize(builder);
+        builder.close_Compound();
+        return builder.build();
+    }
+
+    void CommandQueue::push_Record(const BKV& record) {
+        const std::string type = record.get_String("type");
+
+        Deserializer deserializer;
+        {
+            std::lock_guard<std::mutex> lock(_commandTypesMutex);
+            auto entry = _commandTypes.find(type);
+            if (entry != _commandTypes.end()) deserializer = entry->second;
+        }
+        if (!deserializer) {
+            std::stringstream error;
+            error << "Command type \"" << type << "\" is not registered.";
+            throw std::invalid_argument(StackTrace::append_Stacktrace(error));
+        }
+
+        deserializer(record.get_Compound("data"), *this);
+    }
+
+    void CommandQueue::register_Command_Type(const std::string& type, const Deserializer& deserializer) noexcept {
+        std::lock_guard<std::mutex> lock(_commandTypesMutex);
+        _commandTypes[type] = deserializer;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef LOVE_COMMAND_QUEUE_HPP
+#define LOVE_COMMAND_QUEUE_HPP
+
+#include "command.hpp"
+
+#include <love/common/data/bkv/bkv.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace love_engine {
+    class Logger;
+
+    // Lock-free multi-producer, single-consumer command queue.
+    // Any thread may push(); only the tick thread calls execute_Commands().
+    // Commands are allocated from one of two arenas that swap every tick, falling back to the heap when full.
+    class CommandQueue {
+        public:
+            typedef std::function<void(const BKV& data, CommandQueue& queue)> Deserializer;
+
+            // @param arenaSize Bytes of command storage per tick.
+            CommandQueue(const size_t arenaSize = 1024 * 1024);
+            CommandQueue(CommandQueue const&) = delete;
+            void operator=(CommandQueue const&) = delete;
+            ~CommandQueue();
+
+            template<class T, class... Args>
+            void push(Args&&... args) {
+                static_assert(std::is_base_of_v<Command, T>, "T must derive from Command.");
+                // Unpins even if the constructor throws, so execute_Commands() never waits on a dead writer
+                Arena_Pin pin(*this);
+                void* memory = pin.arena.allocate(sizeof(T), alignof(T));
+                Command* command;
+                if (memory != nullptr) command = new (memory) T(std::forward<Args>(args)...);
+                else {
+                    command = new T(std::forward<Args>(args)...);
+                    command->_heapAllocated = true;
+                }
+                _push(command);
+            }
+
+            // Reconstructs a command written by serialize_Command() and pushes it.
+            // @throw std::invalid_argument If the record is malformed or its type is not registered.
+            void push_Record(const BKV& record);
+
+            // Executes every command pushed so far, in push order.
+            // @return Number of commands executed.
+            size_t execute_Commands(ServerInstance& server) noexcept;
+
+            // Called with each command right before it is executed. Exceptions it throws are logged and the
+            // command still executes.
+            void set_Command_Listener(const std::function<void(const Command&)>& listener) noexcept { _listener = listener; }
+            void set_Logger(const Logger* logger) noexcept { _logger = logger; }
+
+            static BKV serialize_Command(const Command& command);
+            static void register_Command_Type(const std::string& type, const Deserializer& deserializer) noexcept;
+
+        private:
+            struct Arena {
+                std::unique_ptr<std::byte[]> buffer;
+                size_t capacity = 0;
+                std::atomic<size_t> offset = 0;
+                // Producers currently allocating from or pushing out of this arena
+                std::atomic<size_t> writers = 0;
+
+                // @return nullptr If the arena is full.
+                void* allocate(const size_t size, const size_t alignment) noexcept;
+            };
+
+            // Holds the current arena's writer count up for its lifetime
+            struct Arena_Pin {
+                Arena& arena;
+
+                Arena_Pin(CommandQueue& queue) noexcept : arena(queue._pin_Arena()) {}
+                Arena_Pin(Arena_Pin const&) = delete;
+                void operator=(Arena_Pin const&) = delete;
+                ~Arena_Pin() { arena.writers.fetch_sub(1, std::memory_order_release); }
+            };
+
+            // Increments the writer count of the current arena. Caller must decrement it.
+            Arena& _pin_Arena() noexcept;
+            void _push(Command* command) noexcept;
+            static void _destroy(Command* command) noexcept;
+
+            Arena _arenas[2];
+            std::atomic<size_t> _currentArena = 0;
+            std::atomic<Command*> _head = nullptr;
+            std::function<void(const Command&)> _listener;
+            const Logger* _logger = nullptr;
+    };
+}
+
+#endif // LOVE_COMMAND_QUEUE_HPP
@@ -0,0 +1,172 @@
+#include "command_recorder.hpp"
+
+#include "command_queue.hpp"
+#include "../server_instance.hpp"
+
+#include <love/common/data/files/file_compression.hpp>
+#include <love/common/error/stack_trace.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace love_engine {
+    CommandRecorder::CommandRecorder(const std::string& filePath, const Settings settings)
+    : _settings(settings), _filePath(filePath), _writer("COMMAND_RECORDER", 1) {
+        FileIO::ensure_Parent_Directory_Exists(filePath);
+        _file = std::fopen(filePath.c_str(), "wb");
+        if (!_file || (std::fwrite(MAGIC, 1, sizeof(MAGIC) - 1, _file) != sizeof(MAGIC) - 1)) {
+            std::stringstream error;
+            error << "Could not open command recording \"" << filePath << "\": " << std::strerror(errno);
+            if (_file) std::fclose(_file);
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+    }
+
+    CommandRecorder::~CommandRecorder() {
+        _submit_Frame();
+        _writer.wait_For_Idle();
+        std::fclose(_file);
+    }
+
+    void CommandRecorder::record_Command(const Command& command) {
+        if (_stopped) return;
+        const BKV record = CommandQueue::serialize_Command(command);
+        const uint32_t size = static_cast<uint32_t>(record.size());
+
+        const size_t head = _data.size();
+        _data.resize(head + 1 + sizeof(size) + size);
+        _data[head] = static_cast<uint8_t>(Record_Kind::COMMAND);
+        std::memcpy(_data.data() + head + 1, &size, sizeof(size));
+        std::memcpy(_data.data() + head + 1 + sizeof(size), record.data(), size);
+        _recordedBytes += 1 + sizeof(size) + size;
+    }
+
+    void CommandRecorder::record_Tick() noexcept {
+        if (_stopped) return;
+        _data.push_back(static_cast<uint8_t>(Record_Kind::TICK));
+        ++_recordedBytes;
+        ++_ticks;
+        ++_ticksSinceFlush;
+
+        // Frames end on tick boundaries, so a recording cut at any frame replays whole ticks
+        if ((_settings.maxBytes != 0) && (_recordedBytes >= _settings.maxBytes)) {
+            _submit_Frame();
+            _stopped = true;
+        } else if ((_data.size() >= _settings.flushBytes) || (_ticksSinceFlush >= _settings.flushTicks)) _submit_Frame();
+    }
+
+    void CommandRecorder::flush() {
+        _submit_Frame();
+        _writer.wait_For_Idle();
+
+        std::lock_guard<std::mutex> lock(_errorMutex);
+        if (!_writeError.empty()) {
+            _stopped = true;
+            throw std::runtime_error(StackTrace::append_Stacktrace(_writeError));
+        }
+    }
+
+    void CommandRecorder::_submit_Frame() noexcept {
+        _ticksSinceFlush = 0;
+        if (_data.empty()) return;
+
+        // Compressed off the tick thread. The single writer keeps frames in order.
+        _writer.submit([this, data = std::move(_data)]() {
+            {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                if (!_writeError.empty()) return;
+            }
+            try {
+                const std::vector<uint8_t> compressed = FileCompression::compress(data.data(), data.size());
+                const uint32_t header[2] = {static_cast<uint32_t>(compressed.size()), static_cast<uint32_t>(data.size())};
+                if ((std::fwrite(header, 1, sizeof(header), _file) != sizeof(header))
+                    || (std::fwrite(compressed.data(), 1, compressed.size(), _file) != compressed.size())) {
+                    std::stringstream error;
+                    error << "Could not write to command recording \"" << _filePath << "\": " << std::strerror(errno);
+                    throw std::runtime_error(error.str());
+                }
+                FileIO::sync_File(_file, _filePath);
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                _writeError = e.what();
+            }
+        });
+        _data.clear();
+        // Frames stay well under 4 GiB, which the u32 header needs
+        _data.reserve(std::min<size_t>(_settings.flushBytes, 64 * 1024 * 1024));
+    }
+
+    CommandRecorder::Replay_Result CommandRecorder::replay(ServerInstance& server, const std::string& filePath) {
+        const FileIO::FileContent content = FileIO::read_File_Content(filePath);
+        const uint8_t*const file = content.data();
+        const size_t fileSize = content.size();
+
+        if ((fileSize < sizeof(MAGIC) - 1) || (std::memcmp(file, MAGIC, sizeof(MAGIC) - 1) != 0)) {
+            std::stringstream error;
+            error << "File is not a command recording: " << filePath;
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+
+        Replay_Result result;
+        size_t frameHead = sizeof(MAGIC) - 1;
+        while (frameHead < fileSize) {
+            uint32_t header[2];
+            if (frameHead + sizeof(header) > fileSize) {
+                result.truncated = true;
+                break;
+            }
+            std::memcpy(header, file + frameHead, sizeof(header));
+            frameHead += sizeof(header);
+            if (frameHead + header[0] > fileSize) {
+                result.truncated = true;
+                break;
+            }
+            const std::vector<uint8_t> frame = FileCompression::decompress(file + frameHead, header[0], header[1]);
+            frameHead += header[0];
+
+            const uint8_t*const data = frame.data();
+            const size_t size = frame.size();
+            size_t head = 0;
+            while (head < size) {
+                switch (static_cast<Record_Kind>(data[head++])) {
+                    case Record_Kind::TICK: {
+                        const auto start = std::chrono::steady_clock::now();
+                        server.tick();
+                        const std::chrono::nanoseconds tickTime = std::chrono::steady_clock::now() - start;
+
+                        ++result.ticks;
+                        result.totalTickTime += tickTime;
+                        result.maxTickTime = std::max(result.maxTickTime, tickTime);
+                        break;
+                    }
+
+                    case Record_Kind::COMMAND: {
+                        uint32_t recordSize = 0;
+                        if (head + sizeof(recordSize) <= size) std::memcpy(&recordSize, data + head, sizeof(recordSize));
+                        head += sizeof(recordSize);
+                        if (head + recordSize > size) {
+                            std::stringstream error;
+                            error << "Command recording is truncated: " << filePath;
+                            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+                        }
+
+                        server.get_Command_Queue().push_Record(BKV(data + head, recordSize));
+                        head += recordSize;
+                        ++result.commands;
+                        break;
+                    }
+
+                    default: {
+                        std::stringstream error;
+                        error << "Unknown record in frame at byte " << (frameHead - header[0]) << " of command recording: " << filePath;
+                        throw std::runtime_error(StackTrace::append_Stacktrace(error));
+                    }
+                }
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef LOVE_COMMAND_RECORDER_HPP
+#define LOVE_COMMAND_RECORDER_HPP
+
+#include "command.hpp"
+
+#include <love/common/system/thread_pool.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    class ServerInstance;
+
+    // Records every executed command and tick boundary so a session can be replayed with CommandRecorder::replay().
+    // Records are streamed to the file as they build up, so a crash loses at most the last flush interval.
+    // Recordings are "LOVEREC2" followed by frames of [compressed size: u32][size: u32][.xz stream], each holding
+    // records of [kind: u8] and, for commands, [size: u32][BKV command record].
+    class CommandRecorder {
+        public:
+            typedef struct Settings_ {
+                // Buffered records are compressed and appended on the next tick after either limit is reached.
+                size_t flushBytes = 1024 * 1024;
+                uint64_t flushTicks = 200;
+                // Recording stops once this many uncompressed bytes were recorded. 0 for no limit.
+                uint64_t maxBytes = 512ull * 1024 * 1024;
+            } Settings;
+
+            typedef struct Replay_Result_ {
+                uint64_t ticks = 0;
+                uint64_t commands = 0;
+                std::chrono::nanoseconds totalTickTime{0};
+                std::chrono::nanoseconds maxTickTime{0};
+                // Set if the last frame was cut off, e.g. by a crash while it was written.
+                bool truncated = false;
+            } Replay_Result;
+
+            // Truncates @p filePath and starts a recording in it.
+            // @throw std::runtime_error If the file cannot be opened.
+            CommandRecorder(const std::string& filePath) : CommandRecorder(filePath, Settings{}) {}
+            // @throw std::runtime_error If the file cannot be opened.
+            CommandRecorder(const std::string& filePath, const Settings settings);
+            CommandRecorder(CommandRecorder const&) = delete;
+            void operator=(CommandRecorder const&) = delete;
+            // Flushes. Write errors are dropped; call flush() first to see them.
+            ~CommandRecorder();
+
+            // Called by ServerInstance on the tick thread.
+            void record_Command(const Command& command);
+            // Called by ServerInstance on the tick thread after a tick's commands were executed.
+            void record_Tick() noexcept;
+
+            // Writes everything recorded so far and blocks until it is on disk.
+            // NOTE: Must not race record_Command() or record_Tick(), i.e. call it on the tick thread or after
+            // the server stopped.
+            // @throw std::runtime_error If a frame could not be written. Recording stops after a write error.
+            void flush();
+
+            uint64_t get_Recorded_Ticks() const noexcept { return _ticks; }
+            uint64_t get_Recorded_Bytes() const noexcept { return _recordedBytes; }
+            // Set once maxBytes was reached or a write failed. Nothing more is recorded.
+            bool is_Stopped() const noexcept { return _stopped; }
+
+            // Re-runs a recording on @p server as fast as possible, without waiting for tick deadlines.
+            // The command types in the recording must be registered with CommandQueue::register_Command_Type().
+            // @throw std::runtime_error If a file error occurs or the recording is malformed.
+            // @throw std::invalid_argument If a recorded command type is not registered.
+            static Replay_Result replay(ServerInstance& server, const std::string& filePath);
+
+        private:
+            enum class Record_Kind : uint8_t {
+                TICK = 1,
+                COMMAND,
+            };
+            static constexpr char MAGIC[] = "LOVEREC2";
+
+            // Hands the buffered records to the writer thread
+            void _submit_Frame() noexcept;
+
+            Settings _settings;
+            std::string _filePath;
+            FILE* _file = nullptr;
+            std::vector<uint8_t> _data;
+            uint64_t _ticks = 0;
+            uint64_t _ticksSinceFlush = 0;
+            uint64_t _recordedBytes = 0;
+            bool _stopped = false;
+            // Set by the writer thread
+            std::mutex _errorMutex;
+            std::string _writeError;
+            // Last, so it is joined before the members its tasks use are destroyed
+            ThreadPool _writer;
+    };
+}
+
+#endif // LOVE_COMMAND_RECORDER_HPP
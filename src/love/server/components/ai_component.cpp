@@ -0,0 +1,202 @@
+#include "ai_component.hpp"
+
+#include "component.hpp"
+
+#include <love/common/error/stack_trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace love_engine {
+    AiComponent::AiComponent(const Settings settings, const Update_Function& update, const Decision_Function& decide)
+    : _settings(settings), _update(update), _decide(decide) {
+        // Agents beyond the last distance use the last interval
+        if (_settings.lodIntervals.size() != _settings.lodDistances.size() + 1) {
+            std::stringstream error;
+            error << "lodIntervals needs " << (_settings.lodDistances.size() + 1) << " entries for " << _settings.lodDistances.size()
+                << " lodDistances, but has " << _settings.lodIntervals.size() << ".";
+            throw std::invalid_argument(StackTrace::append_Stacktrace(error));
+        }
+    }
+
+    AiComponent::Agent_Id AiComponent::add_Agent(const Point position) noexcept {
+        Agent_Id agent;
+        if (!_freeAgents.empty()) {
+            agent = _freeAgents.back();
+            _freeAgents.pop_back();
+        } else {
+            agent = static_cast<Agent_Id>(_agents.size());
+            _agents.emplace_back();
+            _paths.emplace_back();
+        }
+
+        Agent& data = _agents[agent];
+        const uint32_t generation = data.generation + 1;
+        data = Agent{};
+        data.generation = generation;
+        data.position = position;
+        data.lastUpdateTick = _tick;
+        data.lod = _find_LOD(position);
+        data.active = true;
+        _paths[agent].clear();
+        return agent;
+    }
+
+    void AiComponent::remove_Agent(const Agent_Id agent) noexcept {
+        // Freeing a slot twice would hand it to two agents
+        if (!_agents[agent].active) return;
+        // Queued decisions and late path results check these before touching the agent
+        _agents[agent].active = false;
+        _agents[agent].pathRequestId = 0;
+        _paths[agent].clear();
+        _freeAgents.push_back(agent);
+    }
+
+    void AiComponent::deliver_Path(Path_Result&& result) noexcept {
+        std::lock_guard<std::mutex> lock(_pathResultsMutex);
+        _pathResults.push_back(std::move(result));
+    }
+
+    SystemScheduler::System AiComponent::get_System() noexcept {
+        return SystemScheduler::System{
+            .name = "ai",
+            .reads = {},
+            .writes = {Component::get_Id<AiComponent>()},
+            .update = [this](ThreadPool& pool) { update(pool); },
+        };
+    }
+
+    uint32_t AiComponent::_find_LOD(const Point& position) const noexcept {
+        if (_players.empty()) return static_cast<uint32_t>(_settings.lodDistances.size());
+
+        float nearest = INFINITY;
+        for (const Point& player : _players) {
+            const float dx = player.x - position.x, dy = player.y - position.y, dz = player.z - position.z;
+            nearest = std::min(nearest, dx * dx + dy * dy + dz * dz);
+        }
+
+        uint32_t lod = 0;
+        while ((lod < _settings.lodDistances.size()) && (nearest >= _settings.lodDistances[lod] * _settings.lodDistances[lod])) ++lod;
+        return lod;
+    }
+
+    void AiComponent::_apply_Path_Results() noexcept {
+        std::vector<Path_Result> results;
+        {
+            std::lock_guard<std::mutex> lock(_pathResultsMutex);
+            results.swap(_pathResults);
+        }
+
+        for (Path_Result& result : results) {
+            // Drop results for removed agents and superseded requests
+            if ((result.agent >= _agents.size()) || (_agents[result.agent].pathRequestId != result.requestId)) continue;
+            _paths[result.agent] = std::move(result.waypoints);
+            ++_tickStatistics.pathResults;
+        }
+    }
+
+    void AiComponent::update(ThreadPool& pool) noexcept {
+        _tickStatistics = Tick_Statistics{};
+        ++_tick;
+        _apply_Path_Results();
+
+        // Update due agents in batches. Requests are collected per batch and merged in batch order.
+        const size_t batchSize = std::max<size_t>(_settings.batchSize, 1);
+        const size_t batches = (_agents.size() + batchSize - 1) / batchSize;
+        std::vector<std::vector<Update_Context>> batchRequests(batches);
+        std::atomic<size_t> updatedAgents = 0;
+
+        pool.parallel_For(0, _agents.size(), batchSize, [&](size_t begin, size_t end) {
+            std::vector<Update_Context>& requests = batchRequests[begin / batchSize];
+            size_t updated = 0;
+            for (size_t i = begin; i < end; ++i) {
+                Agent& agent = _agents[i];
+                if (!agent.active) continue;
+
+                // Offset by the agent ID so agents sharing a level of detail spread over ticks
+                const uint32_t interval = std::max<uint32_t>(_settings.lodIntervals[agent.lod], 1);
+                if ((_tick + i) % interval != 0) continue;
+
+                Update_Context context{
+                    .agent = static_cast<Agent_Id>(i),
+                    .lod = agent.lod,
+                    .ticksSinceUpdate = _tick - agent.lastUpdateTick,
+                };
+                _update(*this, context);
+                agent.lastUpdateTick = _tick;
+                agent.lod = _find_LOD(agent.position);
+                ++updated;
+
+                if (context.requestDecision || context.requestPath) requests.push_back(context);
+            }
+            updatedAgents.fetch_add(updated, std::memory_order_relaxed);
+        });
+        _tickStatistics.updatedAgents = updatedAgents.load();
+
+        std::vector<Path_Request> pathRequests;
+        for (const auto& requests : batchRequests) {
+            for (const Update_Context& context : requests) {
+                Agent& agent = _agents[context.agent];
+                if (context.requestDecision && !agent.decisionQueued) {
+                    agent.decisionQueued = true;
+                    _pendingDecisions.push_back(Pending_Decision{.agent = context.agent, .generation = agent.generation});
+                }
+                if (context.requestPath) {
+                    agent.pathRequestId = _nextPathRequestId++;
+                    pathRequests.push_back(Path_Request{
+                        .agent = context.agent,
+                        .requestId = agent.pathRequestId,
+                        .start = agent.position,
+                        .goal = context.pathGoal,
+                    });
+                }
+            }
+        }
+
+        _tickStatistics.pathRequests = pathRequests.size();
+        if (!pathRequests.empty()) {
+            if (_pathResolver) _pathResolver(std::move(pathRequests));
+            else {
+                for (const Path_Request& request : pathRequests) {
+                    deliver_Path(Path_Result{.agent = request.agent, .requestId = request.requestId, .waypoints = {request.goal}});
+                }
+            }
+        }
+
+        _run_Decisions(pool);
+        _tickStatistics.pendingDecisions = _pendingDecisions.size();
+    }
+
+    void AiComponent::_run_Decisions(ThreadPool& pool) noexcept {
+        if (_pendingDecisions.empty()) return;
+
+        // Workers claim decisions in queue order until the budget runs out. Claimed decisions always finish.
+        const auto deadline = std::chrono::steady_clock::now() + _settings.decisionBudget;
+        const size_t pending = _pendingDecisions.size();
+        std::atomic<size_t> nextDecision = 0;
+
+        const size_t workers = std::min(pool.get_Thread_Count(), pending);
+        pool.parallel_For(0, workers, 1, [&](size_t, size_t) {
+            while (std::chrono::steady_clock::now() < deadline) {
+                const size_t index = nextDecision.fetch_add(1, std::memory_order_relaxed);
+                if (index >= pending) return;
+
+                // Skip decisions queued for a removed agent, even if its slot was reused since
+                const Pending_Decision& decision = _pendingDecisions[index];
+                const Agent& agent = _agents[decision.agent];
+                if (agent.active && (agent.generation == decision.generation)) _decide(*this, decision.agent);
+            }
+        });
+
+        const size_t decided = std::min(nextDecision.load(), pending);
+        for (size_t i = 0; i < decided; ++i) {
+            Agent& agent = _agents[_pendingDecisions[i].agent];
+            if (agent.generation == _pendingDecisions[i].generation) agent.decisionQueued = false;
+        }
+        _pendingDecisions.erase(_pendingDecisions.begin(), _pendingDecisions.begin() + decided);
+        _tickStatistics.decisions = decided;
+    }
+}
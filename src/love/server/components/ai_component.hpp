@@ -0,0 +1,145 @@
+#ifndef LOVE_AI_COMPONENT_HPP
+#define LOVE_AI_COMPONENT_HPP
+
+#include "../systems/system_scheduler.hpp"
+
+#include <love/common/system/thread_pool.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace love_engine {
+    // Updates agents in parallel batches. Agents far from every player update less often (level of detail),
+    // expensive decisions are queued and run against a per-tick time budget, and path requests are handed
+    // to a resolver and answered asynchronously.
+    class AiComponent {
+        public:
+            typedef uint32_t Agent_Id;
+
+            typedef struct Point_ {
+                float x = 0.f;
+                float y = 0.f;
+                float z = 0.f;
+            } Point;
+
+            typedef struct Update_Context_ {
+                Agent_Id agent;
+                // Index into Settings::lodIntervals
+                uint32_t lod;
+                uint64_t ticksSinceUpdate;
+                // Set to queue a time-sliced decision for the agent.
+                bool requestDecision = false;
+                // Set, along with pathGoal, to request a path from the agent's position.
+                bool requestPath = false;
+                Point pathGoal;
+            } Update_Context;
+
+            typedef struct Path_Request_ {
+                Agent_Id agent;
+                uint64_t requestId;
+                Point start;
+                Point goal;
+            } Path_Request;
+
+            typedef struct Path_Result_ {
+                Agent_Id agent;
+                uint64_t requestId;
+                // Empty if no path was found
+                std::vector<Point> waypoints;
+            } Path_Result;
+
+            // Runs on worker threads. Must only modify its own agent.
+            typedef std::function<void(AiComponent& ai, Update_Context& context)> Update_Function;
+            // Runs on worker threads. Must only modify its own agent.
+            typedef std::function<void(AiComponent& ai, const Agent_Id agent)> Decision_Function;
+            // Receives the tick's path requests. Results must be handed back through deliver_Path().
+            typedef std::function<void(std::vector<Path_Request>&& requests)> Path_Resolver;
+
+            typedef struct Settings_ {
+                // Upper distance to the nearest player of each level of detail, ascending.
+                std::vector<float> lodDistances = {32.f, 96.f, 256.f};
+                // Ticks between updates per level of detail. One more entry than lodDistances.
+                std::vector<uint32_t> lodIntervals = {1, 4, 16, 64};
+                std::chrono::microseconds decisionBudget{2000};
+                size_t batchSize = 256;
+            } Settings;
+
+            typedef struct Tick_Statistics_ {
+                size_t updatedAgents = 0;
+                size_t decisions = 0;
+                size_t pendingDecisions = 0;
+                size_t pathRequests = 0;
+                size_t pathResults = 0;
+            } Tick_Statistics;
+
+            // @throw std::invalid_argument If lodIntervals does not have one more entry than lodDistances.
+            AiComponent(const Settings settings, const Update_Function& update, const Decision_Function& decide);
+            ~AiComponent() = default;
+
+            Agent_Id add_Agent(const Point position) noexcept;
+            // Ignored if the agent was already removed.
+            void remove_Agent(const Agent_Id agent) noexcept;
+
+            void set_Position(const Agent_Id agent, const Point position) noexcept { _agents[agent].position = position; }
+            const Point& get_Position(const Agent_Id agent) const noexcept { return _agents[agent].position; }
+            // Latest path delivered for the agent's newest request.
+            const std::vector<Point>& get_Path(const Agent_Id agent) const noexcept { return _paths[agent]; }
+
+            void set_Player_Positions(const std::vector<Point>& players) noexcept { _players = players; }
+            // Without a resolver, paths are a straight line to the goal.
+            void set_Path_Resolver(const Path_Resolver& resolver) noexcept { _pathResolver = resolver; }
+            // Safe to call from any thread.
+            void deliver_Path(Path_Result&& result) noexcept;
+
+            void update(ThreadPool& pool) noexcept;
+
+            // System that updates this component once per tick.
+            SystemScheduler::System get_System() noexcept;
+
+            const Tick_Statistics& get_Tick_Statistics() const noexcept { return _tickStatistics; }
+
+        private:
+            typedef struct Agent_ {
+                Point position;
+                uint64_t lastUpdateTick = 0;
+                uint64_t pathRequestId = 0;
+                uint32_t lod = 0;
+                // Bumped whenever the slot is reused, so work queued for a removed agent is dropped
+                uint32_t generation = 0;
+                bool active = false;
+                bool decisionQueued = false;
+            } Agent;
+
+            typedef struct Pending_Decision_ {
+                Agent_Id agent;
+                uint32_t generation;
+            } Pending_Decision;
+
+            uint32_t _find_LOD(const Point& position) const noexcept;
+            void _apply_Path_Results() noexcept;
+            void _run_Decisions(ThreadPool& pool) noexcept;
+
+            Settings _settings;
+            Update_Function _update;
+            Decision_Function _decide;
+            Path_Resolver _pathResolver;
+            Tick_Statistics _tickStatistics;
+            uint64_t _tick = 0;
+            uint64_t _nextPathRequestId = 1;
+
+            std::vector<Agent> _agents;
+            std::vector<std::vector<Point>> _paths;
+            std::vector<Agent_Id> _freeAgents;
+            std::vector<Point> _players;
+            std::deque<Pending_Decision> _pendingDecisions;
+
+            std::mutex _pathResultsMutex;
+            std::vector<Path_Result> _pathResults;
+    };
+}
+
+#endif // LOVE_AI_COMPONENT_HPP
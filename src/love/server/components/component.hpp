@@ -0,0 +1,24 @@
+#ifndef LOVE_COMPONENT_HPP
+#define LOVE_COMPONENT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace love_engine {
+    typedef uint32_t Component_Id;
+
+    class Component {
+        public:
+            // Unique, process-wide ID of component type @p T, assigned on first use.
+            template<class T>
+            static Component_Id get_Id() noexcept {
+                static const Component_Id id = _nextId.fetch_add(1, std::memory_order_relaxed);
+                return id;
+            }
+
+        private:
+            static inline std::atomic<Component_Id> _nextId = 0;
+    };
+}
+
+#endif // LOVE_COMPONENT_HPP
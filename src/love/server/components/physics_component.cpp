@@ -0,0 +1,347 @@
+#include "physics_component.hpp"
+
+#include "component.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+#if defined(__AVX__) || defined(__SSE2__)
+  #include <immintrin.h>
+#endif
+
+namespace love_engine {
+    constexpr uint32_t _NO_ISLAND = UINT32_MAX;
+    constexpr int _CELL_BITS = 21;
+    constexpr int64_t _CELL_OFFSET = int64_t(1) << (_CELL_BITS - 1);
+    constexpr uint64_t _CELL_MASK = (uint64_t(1) << _CELL_BITS) - 1;
+    // Half of the 26 neighbours, so every pair of neighbouring cells is visited once
+    constexpr int _FORWARD_NEIGHBOURS[13][3] = {
+        {1, 0, 0}, {-1, 1, 0}, {0, 1, 0}, {1, 1, 0},
+        {-1, -1, 1}, {0, -1, 1}, {1, -1, 1},
+        {-1, 0, 1}, {0, 0, 1}, {1, 0, 1},
+        {-1, 1, 1}, {0, 1, 1}, {1, 1, 1},
+    };
+
+    uint32_t PhysicsComponent::add_Body(
+        const float x, const float y, const float z,
+        const float velocityX, const float velocityY, const float velocityZ,
+        const float radius, const float mass
+    ) noexcept {
+        const uint32_t index = static_cast<uint32_t>(_positionX.size());
+        _positionX.push_back(x);
+        _positionY.push_back(y);
+        _positionZ.push_back(z);
+        _velocityX.push_back(velocityX);
+        _velocityY.push_back(velocityY);
+        _velocityZ.push_back(velocityZ);
+        _radius.push_back(radius);
+        _inverseMass.push_back((mass > 0.f) ? (1.f / mass) : 0.f);
+
+        _bodyCell.push_back(0);
+        _bodyCellSlot.push_back(0);
+        _insert_Into_Cell(index, _get_Cell_Key(index));
+        return index;
+    }
+
+    void PhysicsComponent::remove_Body(const uint32_t index) noexcept {
+        const uint32_t last = static_cast<uint32_t>(_positionX.size() - 1);
+        _remove_From_Cell(index);
+        if (index != last) {
+            _positionX[index] = _positionX[last];
+            _positionY[index] = _positionY[last];
+            _positionZ[index] = _positionZ[last];
+            _velocityX[index] = _velocityX[last];
+            _velocityY[index] = _velocityY[last];
+            _velocityZ[index] = _velocityZ[last];
+            _radius[index] = _radius[last];
+            _inverseMass[index] = _inverseMass[last];
+            _bodyCell[index] = _bodyCell[last];
+            _bodyCellSlot[index] = _bodyCellSlot[last];
+            _cells[_bodyCell[index]][_bodyCellSlot[index]] = index;
+        }
+        _positionX.pop_back();
+        _positionY.pop_back();
+        _positionZ.pop_back();
+        _velocityX.pop_back();
+        _velocityY.pop_back();
+        _velocityZ.pop_back();
+        _radius.pop_back();
+        _inverseMass.pop_back();
+        _bodyCell.pop_back();
+        _bodyCellSlot.pop_back();
+    }
+
+    SystemScheduler::System PhysicsComponent::get_System(const float dt) noexcept {
+        return SystemScheduler::System{
+            .name = "physics",
+            .reads = {},
+            .writes = {Component::get_Id<PhysicsComponent>()},
+            .update = [this, dt](ThreadPool& pool) { step(pool, dt); },
+        };
+    }
+
+    void PhysicsComponent::step(ThreadPool& pool, const float dt) noexcept {
+        _stepStatistics = Step_Statistics{};
+        const size_t bodies = _positionX.size();
+        if (bodies == 0) return;
+
+        // Chunks are multiples of 8 so only the last chunk has a scalar tail
+        pool.parallel_For(0, bodies, 4096, [this, dt](size_t begin, size_t end) { _integrate(begin, end, dt); });
+        _update_Broadphase(pool);
+        _find_Pairs(pool);
+        _build_Islands();
+
+        std::atomic<size_t> contacts = 0;
+        pool.parallel_For(0, _islandPairStart.size() - 1, 0, [this, &contacts](size_t begin, size_t end) {
+            size_t chunkContacts = 0;
+            for (size_t island = begin; island < end; ++island) {
+                for (uint32_t i = _islandPairStart[island]; i < _islandPairStart[island + 1]; ++i) {
+                    if (_resolve_Contact(_islandPairs[i].a, _islandPairs[i].b)) ++chunkContacts;
+                }
+            }
+            contacts.fetch_add(chunkContacts, std::memory_order_relaxed);
+        });
+        _stepStatistics.contacts = contacts.load();
+    }
+
+    void PhysicsComponent::_integrate(const size_t begin, const size_t end, const float dt) noexcept {
+        float *const px = _positionX.data(), *const py = _positionY.data(), *const pz = _positionZ.data();
+        float *const vx = _velocityX.data(), *const vy = _velocityY.data(), *const vz = _velocityZ.data();
+        const float *const inverseMass = _inverseMass.data();
+        const float gx = _settings.gravityX * dt, gy = _settings.gravityY * dt, gz = _settings.gravityZ * dt;
+
+        size_t i = begin;
+#if defined(__AVX__)
+        const __m256 dt8 = _mm256_set1_ps(dt), zero8 = _mm256_setzero_ps();
+        const __m256 gx8 = _mm256_set1_ps(gx), gy8 = _mm256_set1_ps(gy), gz8 = _mm256_set1_ps(gz);
+        for (; i + 8 <= end; i += 8) {
+            // Static bodies (inverse mass 0) get no gravity
+            const __m256 dynamic = _mm256_cmp_ps(_mm256_loadu_ps(inverseMass + i), zero8, _CMP_GT_OQ);
+            const __m256 nvx = _mm256_add_ps(_mm256_loadu_ps(vx + i), _mm256_and_ps(dynamic, gx8));
+            const __m256 nvy = _mm256_add_ps(_mm256_loadu_ps(vy + i), _mm256_and_ps(dynamic, gy8));
+            const __m256 nvz = _mm256_add_ps(_mm256_loadu_ps(vz + i), _mm256_and_ps(dynamic, gz8));
+            _mm256_storeu_ps(vx + i, nvx);
+            _mm256_storeu_ps(vy + i, nvy);
+            _mm256_storeu_ps(vz + i, nvz);
+            _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(nvx, dt8)));
+            _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(nvy, dt8)));
+            _mm256_storeu_ps(pz + i, _mm256_add_ps(_mm256_loadu_ps(pz + i), _mm256_mul_ps(nvz, dt8)));
+        }
+#elif defined(__SSE2__)
+        const __m128 dt4 = _mm_set1_ps(dt), zero4 = _mm_setzero_ps();
+        const __m128 gx4 = _mm_set1_ps(gx), gy4 = _mm_set1_ps(gy), gz4 = _mm_set1_ps(gz);
+        for (; i + 4 <= end; i += 4) {
+            // Static bodies (inverse mass 0) get no gravity
+            const __m128 dynamic = _mm_cmpgt_ps(_mm_loadu_ps(inverseMass + i), zero4);
+            const __m128 nvx = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_and_ps(dynamic, gx4));
+            const __m128 nvy = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_and_ps(dynamic, gy4));
+            const __m128 nvz = _mm_add_ps(_mm_loadu_ps(vz + i), _mm_and_ps(dynamic, gz4));
+            _mm_storeu_ps(vx + i, nvx);
+            _mm_storeu_ps(vy + i, nvy);
+            _mm_storeu_ps(vz + i, nvz);
+            _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(nvx, dt4)));
+            _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(nvy, dt4)));
+            _mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(nvz, dt4)));
+        }
+#endif
+        for (; i < end; ++i) {
+            if (inverseMass[i] > 0.f) {
+                vx[i] += gx;
+                vy[i] += gy;
+                vz[i] += gz;
+            }
+            px[i] += vx[i] * dt;
+            py[i] += vy[i] * dt;
+            pz[i] += vz[i] * dt;
+        }
+    }
+
+    PhysicsComponent::Cell_Key PhysicsComponent::_get_Cell_Key(const uint32_t body) const noexcept {
+        const int64_t x = static_cast<int64_t>(std::floor(_positionX[body] * _inverseCellSize)) + _CELL_OFFSET;
+        const int64_t y = static_cast<int64_t>(std::floor(_positionY[body] * _inverseCellSize)) + _CELL_OFFSET;
+        const int64_t z = static_cast<int64_t>(std::floor(_positionZ[body] * _inverseCellSize)) + _CELL_OFFSET;
+        return (static_cast<uint64_t>(x) & _CELL_MASK)
+            | ((static_cast<uint64_t>(y) & _CELL_MASK) << _CELL_BITS)
+            | ((static_cast<uint64_t>(z) & _CELL_MASK) << (_CELL_BITS * 2));
+    }
+
+    PhysicsComponent::Cell_Key PhysicsComponent::_offset_Cell_Key(const Cell_Key key, const int dx, const int dy, const int dz) noexcept {
+        const uint64_t x = (key + dx) & _CELL_MASK;
+        const uint64_t y = ((key >> _CELL_BITS) + dy) & _CELL_MASK;
+        const uint64_t z = ((key >> (_CELL_BITS * 2)) + dz) & _CELL_MASK;
+        return x | (y << _CELL_BITS) | (z << (_CELL_BITS * 2));
+    }
+
+    void PhysicsComponent::_insert_Into_Cell(const uint32_t body, const Cell_Key key) noexcept {
+        std::vector<uint32_t>& cell = _cells[key];
+        _bodyCell[body] = key;
+        _bodyCellSlot[body] = static_cast<uint32_t>(cell.size());
+        cell.push_back(body);
+    }
+
+    void PhysicsComponent::_remove_From_Cell(const uint32_t body) noexcept {
+        auto entry = _cells.find(_bodyCell[body]);
+        std::vector<uint32_t>& cell = entry->second;
+        const uint32_t moved = cell.back();
+        cell[_bodyCellSlot[body]] = moved;
+        _bodyCellSlot[moved] = _bodyCellSlot[body];
+        cell.pop_back();
+        if (cell.empty()) _cells.erase(entry);
+    }
+
+    void PhysicsComponent::_update_Broadphase(ThreadPool& pool) noexcept {
+        const size_t bodies = _positionX.size();
+        _nextBodyCell.resize(bodies);
+        pool.parallel_For(0, bodies, 4096, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) _nextBodyCell[i] = _get_Cell_Key(static_cast<uint32_t>(i));
+        });
+
+        // Only bodies that crossed a cell boundary touch the grid
+        for (uint32_t i = 0; i < bodies; ++i) {
+            if (_nextBodyCell[i] != _bodyCell[i]) {
+                _remove_From_Cell(i);
+                _insert_Into_Cell(i, _nextBodyCell[i]);
+                ++_stepStatistics.cellChanges;
+            }
+        }
+    }
+
+    void PhysicsComponent::_find_Pairs(ThreadPool& pool) noexcept {
+        std::vector<const std::pair<const Cell_Key, std::vector<uint32_t>>*> cells;
+        cells.reserve(_cells.size());
+        for (const auto& cell : _cells) cells.push_back(&cell);
+
+        // One pair list per chunk, concatenated in chunk order so results do not depend on scheduling
+        constexpr size_t CELLS_PER_CHUNK = 256;
+        std::vector<std::vector<Pair>> chunkPairs((cells.size() + CELLS_PER_CHUNK - 1) / CELLS_PER_CHUNK);
+
+        auto overlapping = [this](const uint32_t a, const uint32_t b) {
+            const float dx = _positionX[b] - _positionX[a];
+            const float dy = _positionY[b] - _positionY[a];
+            const float dz = _positionZ[b] - _positionZ[a];
+            const float radii = _radius[a] + _radius[b];
+            return (dx * dx + dy * dy + dz * dz) < (radii * radii);
+        };
+
+        pool.parallel_For(0, cells.size(), CELLS_PER_CHUNK, [&](size_t begin, size_t end) {
+            std::vector<Pair>& pairs = chunkPairs[begin / CELLS_PER_CHUNK];
+            for (size_t c = begin; c < end; ++c) {
+                const std::vector<uint32_t>& bodies = cells[c]->second;
+                for (size_t i = 0; i < bodies.size(); ++i) {
+                    for (size_t j = i + 1; j < bodies.size(); ++j) {
+                        if (overlapping(bodies[i], bodies[j])) pairs.push_back(Pair{bodies[i], bodies[j]});
+                    }
+                }
+
+                for (const auto& offset : _FORWARD_NEIGHBOURS) {
+                    auto neighbour = _cells.find(_offset_Cell_Key(cells[c]->first, offset[0], offset[1], offset[2]));
+                    if (neighbour == _cells.end()) continue;
+                    for (uint32_t a : bodies) {
+                        for (uint32_t b : neighbour->second) {
+                            if (overlapping(a, b)) pairs.push_back(Pair{a, b});
+                        }
+                    }
+                }
+            }
+        });
+
+        _pairs.clear();
+        for (const auto& pairs : chunkPairs) _pairs.insert(_pairs.end(), pairs.begin(), pairs.end());
+        _stepStatistics.pairs = _pairs.size();
+    }
+
+    uint32_t PhysicsComponent::_find_Root(uint32_t body) noexcept {
+        while (_islandParent[body] != body) {
+            _islandParent[body] = _islandParent[_islandParent[body]]; // Path halving
+            body = _islandParent[body];
+        }
+        return body;
+    }
+
+    void PhysicsComponent::_build_Islands() noexcept {
+        const size_t bodies = _positionX.size();
+        _islandParent.resize(bodies);
+        std::iota(_islandParent.begin(), _islandParent.end(), 0);
+        _islandIndex.assign(bodies, _NO_ISLAND);
+
+        // Static bodies do not join islands, so a floor does not merge everything resting on it into one island
+        for (const Pair& pair : _pairs) {
+            if ((_inverseMass[pair.a] == 0.f) || (_inverseMass[pair.b] == 0.f)) continue;
+            const uint32_t rootA = _find_Root(pair.a), rootB = _find_Root(pair.b);
+            if (rootA != rootB) _islandParent[rootB] = rootA;
+        }
+
+        // Count pairs per island, numbering islands by first appearance
+        _islandPairStart.assign(1, 0);
+        std::vector<uint32_t> pairIsland(_pairs.size());
+        for (size_t i = 0; i < _pairs.size(); ++i) {
+            const uint32_t dynamicBody = (_inverseMass[_pairs[i].a] != 0.f) ? _pairs[i].a : _pairs[i].b;
+            const uint32_t root = _find_Root(dynamicBody);
+            if (_islandIndex[root] == _NO_ISLAND) {
+                _islandIndex[root] = static_cast<uint32_t>(_islandPairStart.size() - 1);
+                _islandPairStart.push_back(0);
+            }
+            pairIsland[i] = _islandIndex[root];
+            ++_islandPairStart[pairIsland[i] + 1];
+        }
+        for (size_t i = 1; i < _islandPairStart.size(); ++i) _islandPairStart[i] += _islandPairStart[i - 1];
+
+        // Scatter pairs into island order, keeping their relative order
+        _islandPairs.resize(_pairs.size());
+        std::vector<uint32_t> cursor(_islandPairStart.begin(), _islandPairStart.end() - 1);
+        for (size_t i = 0; i < _pairs.size(); ++i) _islandPairs[cursor[pairIsland[i]]++] = _pairs[i];
+        _stepStatistics.islands = _islandPairStart.size() - 1;
+    }
+
+    bool PhysicsComponent::_resolve_Contact(const uint32_t a, const uint32_t b) noexcept {
+        const float inverseMassA = _inverseMass[a], inverseMassB = _inverseMass[b];
+        const float inverseMassSum = inverseMassA + inverseMassB;
+        if (inverseMassSum == 0.f) return false;
+
+        float nx = _positionX[b] - _positionX[a];
+        float ny = _positionY[b] - _positionY[a];
+        float nz = _positionZ[b] - _positionZ[a];
+        const float radii = _radius[a] + _radius[b];
+        const float distanceSquared = nx * nx + ny * ny + nz * nz;
+        if (distanceSquared >= radii * radii) return false;
+
+        // Pick an arbitrary normal for coincident centers
+        const float distance = std::sqrt(distanceSquared);
+        if (distance > 0.f) {
+            nx /= distance;
+            ny /= distance;
+            nz /= distance;
+        } else {
+            nx = 0.f;
+            ny = 1.f;
+            nz = 0.f;
+        }
+
+        // Push apart in proportion to inverse mass, and apply an impulse if the bodies are approaching
+        // NOTE: Static bodies are shared between islands, so they must never be written to.
+        const float correction = (radii - distance) / inverseMassSum;
+        const float approach =
+            (_velocityX[b] - _velocityX[a]) * nx +
+            (_velocityY[b] - _velocityY[a]) * ny +
+            (_velocityZ[b] - _velocityZ[a]) * nz;
+        const float impulse = (approach < 0.f) ? (-(1.f + _settings.restitution) * approach / inverseMassSum) : 0.f;
+        if (inverseMassA > 0.f) {
+            _positionX[a] -= nx * correction * inverseMassA;
+            _positionY[a] -= ny * correction * inverseMassA;
+            _positionZ[a] -= nz * correction * inverseMassA;
+            _velocityX[a] -= nx * impulse * inverseMassA;
+            _velocityY[a] -= ny * impulse * inverseMassA;
+            _velocityZ[a] -= nz * impulse * inverseMassA;
+        }
+        if (inverseMassB > 0.f) {
+            _positionX[b] += nx * correction * inverseMassB;
+            _positionY[b] += ny * correction * inverseMassB;
+            _positionZ[b] += nz * correction * inverseMassB;
+            _velocityX[b] += nx * impulse * inverseMassB;
+            _velocityY[b] += ny * impulse * inverseMassB;
+            _velocityZ[b] += nz * impulse * inverseMassB;
+        }
+        return true;
+    }
+}
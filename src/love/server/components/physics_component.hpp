@@ -0,0 +1,104 @@
+#ifndef LOVE_PHYSICS_COMPONENT_HPP
+#define LOVE_PHYSICS_COMPONENT_HPP
+
+#include "../systems/system_scheduler.hpp"
+
+#include <love/common/system/thread_pool.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace love_engine {
+    // Sphere bodies stored as structure of arrays.
+    // A step integrates velocities (AVX/SSE when available), updates a uniform grid broadphase for bodies
+    // that changed cells, groups touching bodies into islands and resolves contacts per island in parallel.
+    class PhysicsComponent {
+        public:
+            typedef struct Settings_ {
+                float gravityX = 0.f;
+                float gravityY = -9.81f;
+                float gravityZ = 0.f;
+                // Must be at least twice the largest body radius.
+                float cellSize = 2.f;
+                float restitution = 0.2f;
+            } Settings;
+
+            typedef struct Step_Statistics_ {
+                size_t cellChanges = 0;
+                size_t pairs = 0;
+                size_t contacts = 0;
+                size_t islands = 0;
+            } Step_Statistics;
+
+            PhysicsComponent(const Settings settings) : _settings(settings), _inverseCellSize(1.f / settings.cellSize) {}
+            ~PhysicsComponent() = default;
+
+            // @param mass 0 for a static body.
+            // @return Index of the body. Indices change when bodies are removed.
+            uint32_t add_Body(
+                const float x, const float y, const float z,
+                const float velocityX, const float velocityY, const float velocityZ,
+                const float radius, const float mass
+            ) noexcept;
+            // Moves the last body into @p index.
+            void remove_Body(const uint32_t index) noexcept;
+
+            void step(ThreadPool& pool, const float dt) noexcept;
+
+            // System that steps this component once per tick.
+            SystemScheduler::System get_System(const float dt) noexcept;
+
+            size_t get_Body_Count() const noexcept { return _positionX.size(); }
+            const std::vector<float>& get_Position_X() const noexcept { return _positionX; }
+            const std::vector<float>& get_Position_Y() const noexcept { return _positionY; }
+            const std::vector<float>& get_Position_Z() const noexcept { return _positionZ; }
+            const std::vector<float>& get_Velocity_X() const noexcept { return _velocityX; }
+            const std::vector<float>& get_Velocity_Y() const noexcept { return _velocityY; }
+            const std::vector<float>& get_Velocity_Z() const noexcept { return _velocityZ; }
+            const Step_Statistics& get_Step_Statistics() const noexcept { return _stepStatistics; }
+
+        private:
+            typedef uint64_t Cell_Key;
+            typedef struct Pair_ {
+                uint32_t a;
+                uint32_t b;
+            } Pair;
+
+            void _integrate(const size_t begin, const size_t end, const float dt) noexcept;
+            Cell_Key _get_Cell_Key(const uint32_t body) const noexcept;
+            static Cell_Key _offset_Cell_Key(const Cell_Key key, const int dx, const int dy, const int dz) noexcept;
+            void _insert_Into_Cell(const uint32_t body, const Cell_Key key) noexcept;
+            void _remove_From_Cell(const uint32_t body) noexcept;
+            void _update_Broadphase(ThreadPool& pool) noexcept;
+            void _find_Pairs(ThreadPool& pool) noexcept;
+            void _build_Islands() noexcept;
+            uint32_t _find_Root(uint32_t body) noexcept;
+            // @return Whether the bodies were touching.
+            bool _resolve_Contact(const uint32_t a, const uint32_t b) noexcept;
+
+            Settings _settings;
+            float _inverseCellSize;
+            Step_Statistics _stepStatistics;
+
+            std::vector<float> _positionX, _positionY, _positionZ;
+            std::vector<float> _velocityX, _velocityY, _velocityZ;
+            std::vector<float> _radius;
+            std::vector<float> _inverseMass;
+
+            // Broadphase
+            std::unordered_map<Cell_Key, std::vector<uint32_t>> _cells;
+            std::vector<Cell_Key> _bodyCell;
+            std::vector<uint32_t> _bodyCellSlot;
+            std::vector<Cell_Key> _nextBodyCell;
+            std::vector<Pair> _pairs;
+
+            // Islands
+            std::vector<uint32_t> _islandParent;
+            std::vector<uint32_t> _islandIndex;
+            std::vector<uint32_t> _islandPairStart;
+            std::vector<Pair> _islandPairs;
+    };
+}
+
+#endif // LOVE_PHYSICS_COMPONENT_HPP
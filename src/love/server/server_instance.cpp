@@ -1,5 +1,55 @@
 #include "server_instance.hpp"
 
+#include <love/common/memory/frame_arena.hpp>
+#include <love/common/system/metrics.hpp>
+#include <love/common/system/profiler.hpp>
+#include <love/common/system/thread_placement.hpp>
+
 namespace love_engine {
-    
+
+    void ServerInstance::run() noexcept {
+        if (_settings.pinThreads) ThreadPlacement::pin_Current_Thread(ThreadPlacement::Role::TICK);
+        _timestep.run(
+            [this]() { return _stopRequested.load(); },
+            [this]() { tick(); }
+        );
+    }
+
+    void ServerInstance::set_Command_Recorder(CommandRecorder* recorder) noexcept {
+        _recorder = recorder;
+        if (recorder) _commandQueue.set_Command_Listener([recorder](const Command& command) { recorder->record_Command(command); });
+        else _commandQueue.set_Command_Listener(nullptr);
+    }
+
+    void ServerInstance::tick() noexcept {
+        LOVE_PROFILE_ZONE("ServerInstance::tick");
+        static Metrics::Histogram& tickTime = Metrics::get_Histogram("love_server_tick_nanoseconds", "Time to run one server tick", "nanoseconds");
+        const uint64_t startTime = Profiler::get_Time();
+        FrameArena::begin_Frame();
+        if (_fileWatcher) {
+            LOVE_PROFILE_ZONE("FileWatcher::dispatch");
+            _fileWatcher->dispatch();
+        }
+        {
+            LOVE_PROFILE_ZONE("CommandQueue::execute_Commands");
+            _commandQueue.execute_Commands(*this);
+        }
+        if (_recorder) _recorder->record_Tick();
+        {
+            LOVE_PROFILE_ZONE("ServerInstance::resume_Tick_Waiters");
+            // Copied into the frame arena rather than swapped out, so _tickWaiters keeps its capacity and a warm
+            // tick resumes waiters without touching the heap
+            std::pmr::vector<std::coroutine_handle<>> waiters(FrameArena::get_Resource());
+            {
+                std::lock_guard<std::mutex> lock(_tickWaitersMutex);
+                waiters.assign(_tickWaiters.begin(), _tickWaiters.end());
+                _tickWaiters.clear();
+            }
+            // Coroutines awaiting next_Tick() again are resumed on the following tick
+            for (std::coroutine_handle<> waiter : waiters) waiter.resume();
+        }
+        _scheduler.run();
+        tickTime.record(Profiler::get_Time() - startTime);
+    }
+
 }
@@ -0,0 +1,95 @@
+#ifndef LOVE_SERVER_INSTANCE_HPP
+#define LOVE_SERVER_INSTANCE_HPP
+
+#include "commands/command_queue.hpp"
+#include "commands/command_recorder.hpp"
+#include "systems/system_scheduler.hpp"
+
+#include <love/common/data/files/file_watcher.hpp>
+#include <love/common/system/fixed_timestep.hpp>
+#include <love/common/system/task.hpp>
+#include <love/common/system/thread_pool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <mutex>
+#include <stdfloat>
+#include <thread>
+#include <vector>
+
+namespace love_engine {
+
+    class ServerInstance {
+        public:
+            typedef struct Settings_ {
+                std::float32_t msPerTick = 50.f;
+                // Ticks run back to back when behind before the remaining lag is dropped. Must be at least 1.
+                uint32_t maxCatchUpTicks = 5;
+                size_t workerThreads = std::thread::hardware_concurrency();
+                // Pins the thread calling run() and the workers with ThreadPlacement.
+                bool pinThreads = false;
+            } Settings;
+            // @throw std::invalid_argument If maxCatchUpTicks is 0 or msPerTick is not positive.
+            ServerInstance(const Settings settings)
+            : _settings(settings), _timestep(FixedTimestep::Settings{
+                .tickDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::duration<std::float32_t, std::milli>(settings.msPerTick)
+                ),
+                .maxCatchUpTicks = settings.maxCatchUpTicks,
+            }), _workerPool("SERVER_WORKER", settings.workerThreads, settings.pinThreads), _scheduler(_workerPool) {}
+            ~ServerInstance() = default;
+
+            // Ticks at a fixed rate until stop() is called.
+            void run() noexcept;
+            // Safe to call from any thread.
+            inline void stop() noexcept { _stopRequested = true; }
+
+            // Starts a new frame for FrameArena, delivers file changes, executes queued commands, resumes
+            // coroutines waiting for the tick, then runs every registered system once.
+            void tick() noexcept;
+
+            // co_await next_Tick() continues the coroutine on the tick thread during the next tick, before systems
+            // run. Safe to await from any thread.
+            // NOTE: Coroutines still waiting when the server is destroyed are never resumed.
+            auto next_Tick() noexcept {
+                struct Awaiter {
+                    ServerInstance& server;
+
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<> handle) noexcept {
+                        std::lock_guard<std::mutex> lock(server._tickWaitersMutex);
+                        server._tickWaiters.push_back(handle);
+                    }
+                    void await_resume() const noexcept {}
+                };
+                return Awaiter{*this};
+            }
+
+            // Records every executed command and tick. Pass nullptr to stop recording.
+            void set_Command_Recorder(CommandRecorder* recorder) noexcept;
+            // Dispatches the watcher's changes at the start of every tick, so subscribers can reload files
+            // without racing systems. Pass nullptr to stop.
+            inline void set_File_Watcher(FileWatcher* watcher) noexcept { _fileWatcher = watcher; }
+
+            inline CommandQueue& get_Command_Queue() noexcept { return _commandQueue; }
+            inline SystemScheduler& get_Scheduler() noexcept { return _scheduler; }
+            inline ThreadPool& get_Worker_Pool() noexcept { return _workerPool; }
+            inline const FixedTimestep::Statistics& get_Tick_Statistics() const noexcept { return _timestep.get_Statistics(); }
+
+        private:
+            Settings _settings;
+            FixedTimestep _timestep;
+            ThreadPool _workerPool;
+            SystemScheduler _scheduler;
+            CommandQueue _commandQueue;
+            CommandRecorder* _recorder = nullptr;
+            FileWatcher* _fileWatcher = nullptr;
+            std::atomic<bool> _stopRequested = false;
+            std::mutex _tickWaitersMutex;
+            std::vector<std::coroutine_handle<>> _tickWaiters;
+    };
+
+}
+
+#endif // LOVE_SERVER_INSTANCE_HPP
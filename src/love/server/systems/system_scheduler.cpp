@@ -0,0 +1,79 @@
+#include "system_scheduler.hpp"
+
+#include <love/common/system/profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace love_engine {
+    void SystemScheduler::add_System(const System& system) noexcept {
+        _systems.push_back(system);
+        _graphDirty = true;
+    }
+
+    void SystemScheduler::remove_System(const std::string& name) noexcept {
+        std::erase_if(_systems, [&name](const System& system) { return system.name == name; });
+        _graphDirty = true;
+    }
+
+    bool SystemScheduler::_conflicts(const System& a, const System& b) noexcept {
+        auto intersects = [](const std::vector<Component_Id>& x, const std::vector<Component_Id>& y) {
+            for (Component_Id id : x) {
+                if (std::find(y.begin(), y.end(), id) != y.end()) return true;
+            }
+            return false;
+        };
+        return intersects(a.writes, b.writes) || intersects(a.writes, b.reads) || intersects(a.reads, b.writes);
+    }
+
+    void SystemScheduler::_build_Graph() noexcept {
+        _graph.assign(_systems.size(), Node{});
+        for (size_t i = 0; i < _systems.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (_conflicts(_systems[j], _systems[i])) {
+                    _graph[j].dependents.push_back(i);
+                    ++_graph[i].dependencyCount;
+                }
+            }
+        }
+        _graphDirty = false;
+    }
+
+    void SystemScheduler::run() noexcept {
+        if (_systems.empty()) return;
+        if (_graphDirty) _build_Graph();
+
+        // Per-run countdown of unfinished dependencies
+        std::unique_ptr<std::atomic<size_t>[]> remaining(new std::atomic<size_t>[_systems.size()]);
+        for (size_t i = 0; i < _systems.size(); ++i) remaining[i].store(_graph[i].dependencyCount, std::memory_order_relaxed);
+
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+        size_t doneSystems = 0;
+
+        std::function<void(size_t)> runSystem = [&](size_t index) {
+            {
+                // Named after the system, so the trace shows which one a tick spent its time in
+                LOVE_PROFILE_ZONE(_systems[index].name.c_str());
+                _systems[index].update(_pool);
+            }
+            for (size_t dependent : _graph[index].dependents) {
+                if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    _pool.submit([&runSystem, dependent]() { runSystem(dependent); });
+                }
+            }
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (++doneSystems == _systems.size()) doneCondition.notify_all();
+        };
+
+        for (size_t i = 0; i < _systems.size(); ++i) {
+            if (_graph[i].dependencyCount == 0) _pool.submit([&runSystem, i]() { runSystem(i); });
+        }
+
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCondition.wait(lock, [&]() { return doneSystems == _systems.size(); });
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef LOVE_SYSTEM_SCHEDULER_HPP
+#define LOVE_SYSTEM_SCHEDULER_HPP
+
+#include "../components/component.hpp"
+
+#include <love/common/system/thread_pool.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace love_engine {
+    class SystemScheduler {
+        public:
+            typedef struct System_ {
+                std::string name;
+                // Components the system only reads. Systems that only read the same component run concurrently.
+                std::vector<Component_Id> reads;
+                // Components the system writes. Conflicts with any other system touching them.
+                std::vector<Component_Id> writes;
+                // Use the pool for ThreadPool::parallel_For inside the system.
+                std::function<void(ThreadPool& pool)> update;
+            } System;
+
+            SystemScheduler(ThreadPool& pool) : _pool(pool) {}
+            ~SystemScheduler() = default;
+
+            // Systems that conflict run in the order they were added.
+            void add_System(const System& system) noexcept;
+            void remove_System(const std::string& name) noexcept;
+
+            // Runs every system once, blocking until all are done.
+            void run() noexcept;
+
+        private:
+            typedef struct Node_ {
+                std::vector<size_t> dependents;
+                size_t dependencyCount = 0;
+            } Node;
+
+            static bool _conflicts(const System& a, const System& b) noexcept;
+            void _build_Graph() noexcept;
+
+            ThreadPool& _pool;
+            std::vector<System> _systems;
+            std::vector<Node> _graph;
+            bool _graphDirty = true;
+    };
+}
+
+#endif // LOVE_SYSTEM_SCHEDULER_HPP
@@ -0,0 +1,489 @@
+#include "pathfinder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+namespace love_engine {
+    constexpr uint32_t _UNREACHED = UINT32_MAX;
+    constexpr uint32_t _NO_PARENT = UINT32_MAX;
+    constexpr int32_t _NEIGHBOURS[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+    typedef std::pair<uint32_t, uint32_t> _Open_Entry; // (estimated total cost, index)
+
+    static uint64_t _get_Tile_Key(const Pathfinder::Tile tile) noexcept {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(tile.x)) << 32) | static_cast<uint32_t>(tile.z);
+    }
+
+    static uint32_t _get_Distance(const Pathfinder::Tile a, const Pathfinder::Tile b) noexcept {
+        // Every step costs at least 2 (two tiles of cost 1), which keeps the heuristic admissible
+        return 2 * static_cast<uint32_t>(std::abs(a.x - b.x) + std::abs(a.z - b.z));
+    }
+
+    // Per-thread search state. Stamps avoid clearing the arrays between searches.
+    struct Pathfinder::Search_Scratch {
+        Rect rect{0, 0, 0, 0};
+        std::vector<uint32_t> cost;
+        std::vector<uint32_t> parent;
+        std::vector<uint32_t> stamp;
+        uint32_t generation = 0;
+        std::vector<_Open_Entry> open;
+
+        void reset(const size_t size) noexcept {
+            if (stamp.size() < size) {
+                cost.resize(size);
+                parent.resize(size);
+                stamp.resize(size, 0);
+            }
+            if (++generation == 0) {
+                std::fill(stamp.begin(), stamp.end(), 0);
+                generation = 1;
+            }
+            open.clear();
+        }
+
+        uint32_t get_Index(const Tile tile) const noexcept {
+            return static_cast<uint32_t>((tile.z - rect.z0) * (rect.x1 - rect.x0) + (tile.x - rect.x0));
+        }
+        Tile get_Tile(const uint32_t index) const noexcept {
+            const int32_t width = rect.x1 - rect.x0;
+            return Tile{rect.x0 + static_cast<int32_t>(index) % width, rect.z0 + static_cast<int32_t>(index) / width};
+        }
+        bool contains(const Tile tile) const noexcept {
+            return (tile.x >= rect.x0) && (tile.x < rect.x1) && (tile.z >= rect.z0) && (tile.z < rect.z1);
+        }
+        bool is_Reached(const uint32_t index) const noexcept { return stamp[index] == generation; }
+        uint32_t get_Cost(const Tile tile) const noexcept {
+            if (!contains(tile)) return _UNREACHED;
+            const uint32_t index = get_Index(tile);
+            return is_Reached(index) ? cost[index] : _UNREACHED;
+        }
+    };
+
+    Pathfinder::Pathfinder(const World& world, ThreadPool& pool, const Settings settings)
+    : _world(world), _pool(pool), _settings(settings) {
+        if (_settings.clusterSize == 0) _settings.clusterSize = 16;
+        if (_settings.requestsPerTask == 0) _settings.requestsPerTask = 1;
+        update();
+    }
+
+    Pathfinder::~Pathfinder() {
+        while (_tasksInFlight.load() != 0) std::this_thread::yield();
+    }
+
+    void Pathfinder::update() noexcept {
+        const bool resized = (_world.get_Width() != _width) || (_world.get_Depth() != _depth);
+        if (!resized && (_world.get_Version() == _builtVersion)) return;
+
+        std::vector<World::Chunk_Change> changes;
+        const bool incremental = !resized && (_builtVersion != UINT64_MAX) && _world.get_Changed_Chunks(_builtVersion, changes);
+
+        std::unique_lock<std::shared_mutex> lock(_graphMutex);
+        if (!incremental) _build();
+        else {
+            // Only the clusters overlapping changed chunks are rebuilt, so streaming costs O(chunks changed)
+            const uint32_t chunkSize = _world.get_Chunk_Size(), clusterSize = _settings.clusterSize;
+            std::vector<bool> marked(_clusterNodes.size(), false);
+            std::vector<uint32_t> changed;
+            for (const World::Chunk_Change& change : changes) {
+                _world.copy_Chunk_Tile_Costs(change.chunkX, change.chunkZ, _tileCosts.data());
+
+                const uint32_t x0 = static_cast<uint32_t>(change.chunkX) * chunkSize, z0 = static_cast<uint32_t>(change.chunkZ) * chunkSize;
+                if ((x0 >= _width) || (z0 >= _depth)) continue;
+                const uint32_t x1 = std::min(x0 + chunkSize, _width), z1 = std::min(z0 + chunkSize, _depth);
+                for (uint32_t cz = z0 / clusterSize; cz <= (z1 - 1) / clusterSize; ++cz) {
+                    for (uint32_t cx = x0 / clusterSize; cx <= (x1 - 1) / clusterSize; ++cx) {
+                        const uint32_t cluster = cz * _clustersX + cx;
+                        if (marked[cluster]) continue;
+                        marked[cluster] = true;
+                        changed.push_back(cluster);
+                    }
+                }
+            }
+            _builtVersion = _world.get_Version();
+            _rebuild_Clusters(changed);
+        }
+        std::lock_guard<std::mutex> cacheLock(_cacheMutex);
+        _cache.clear();
+    }
+
+    Pathfinder::Statistics Pathfinder::get_Statistics() const noexcept {
+        return Statistics{
+            .queries = _queries.load(),
+            .cacheHits = _cacheHits.load(),
+            .failedQueries = _failedQueries.load(),
+        };
+    }
+
+    uint8_t Pathfinder::_get_Cost(const Tile tile) const noexcept {
+        if ((tile.x < 0) || (tile.z < 0) || (static_cast<uint32_t>(tile.x) >= _width) || (static_cast<uint32_t>(tile.z) >= _depth)) return 0;
+        return _tileCosts[static_cast<size_t>(tile.z) * _width + tile.x];
+    }
+
+    uint32_t Pathfinder::_get_Cluster(const Tile tile) const noexcept {
+        return (static_cast<uint32_t>(tile.z) / _settings.clusterSize) * _clustersX + (static_cast<uint32_t>(tile.x) / _settings.clusterSize);
+    }
+
+    Pathfinder::Rect Pathfinder::_get_Cluster_Rect(const uint32_t cluster) const noexcept {
+        const int32_t size = static_cast<int32_t>(_settings.clusterSize);
+        const int32_t x0 = static_cast<int32_t>(cluster % _clustersX) * size;
+        const int32_t z0 = static_cast<int32_t>(cluster / _clustersX) * size;
+        return Rect{x0, z0, std::min(x0 + size, static_cast<int32_t>(_width)), std::min(z0 + size, static_cast<int32_t>(_depth))};
+    }
+
+    uint32_t Pathfinder::_get_Node(const Tile tile) noexcept {
+        const uint32_t next = _freeNodes.empty() ? static_cast<uint32_t>(_nodes.size()) : _freeNodes.back();
+        auto [entry, inserted] = _tileNodes.try_emplace(_get_Tile_Key(tile), next);
+        if (inserted) {
+            if (_freeNodes.empty()) _nodes.emplace_back();
+            else _freeNodes.pop_back();
+            _nodes[next] = Node{.tile = tile, .cluster = _get_Cluster(tile), .edges = {}};
+            _clusterNodes[_nodes[next].cluster].push_back(next);
+        }
+        return entry->second;
+    }
+
+    void Pathfinder::_add_Entrances(const Tile start, const Tile step, const Tile across, const uint32_t length) noexcept {
+        auto addEntrance = [this, start, step, across](const uint32_t i) {
+            const Tile a{start.x + step.x * static_cast<int32_t>(i), start.z + step.z * static_cast<int32_t>(i)};
+            const Tile b{a.x + across.x, a.z + across.z};
+            const uint32_t nodeA = _get_Node(a), nodeB = _get_Node(b);
+            const uint32_t cost = _get_Cost(a) + _get_Cost(b);
+            _nodes[nodeA].edges.push_back(Edge{.to = nodeB, .cost = cost, .path = {b}});
+            _nodes[nodeB].edges.push_back(Edge{.to = nodeA, .cost = cost, .path = {a}});
+        };
+
+        // Split the border into open segments. Short segments get one entrance in the middle, long ones one at each end.
+        constexpr uint32_t LONG_SEGMENT = 6;
+        uint32_t segmentStart = 0;
+        for (uint32_t i = 0; i <= length; ++i) {
+            const Tile a{start.x + step.x * static_cast<int32_t>(i), start.z + step.z * static_cast<int32_t>(i)};
+            const bool open = (i < length) && (_get_Cost(a) != 0) && (_get_Cost(Tile{a.x + across.x, a.z + across.z}) != 0);
+            if (open) continue;
+
+            const uint32_t segmentLength = i - segmentStart;
+            if (segmentLength >= LONG_SEGMENT) {
+                addEntrance(segmentStart);
+                addEntrance(i - 1);
+            } else if (segmentLength > 0) addEntrance(segmentStart + segmentLength / 2);
+            segmentStart = i + 1;
+        }
+    }
+
+    void Pathfinder::_build() noexcept {
+        _width = _world.get_Width();
+        _depth = _world.get_Depth();
+        _builtVersion = _world.get_Version();
+        _tileCosts.resize(static_cast<size_t>(_width) * _depth);
+        _world.copy_Tile_Costs(_tileCosts.data());
+
+        const uint32_t size = _settings.clusterSize;
+        _clustersX = (_width + size - 1) / size;
+        _clustersZ = (_depth + size - 1) / size;
+        _nodes.clear();
+        _freeNodes.clear();
+        _tileNodes.clear();
+        _clusterNodes.assign(static_cast<size_t>(_clustersX) * _clustersZ, {});
+
+        // Entrances between horizontally and vertically neighbouring clusters
+        std::vector<uint32_t> clusters(_clusterNodes.size());
+        for (uint32_t cluster = 0; cluster < clusters.size(); ++cluster) {
+            _add_Cluster_Entrances(cluster, true, true);
+            clusters[cluster] = cluster;
+        }
+        _connect_Clusters(clusters);
+    }
+
+    void Pathfinder::_add_Cluster_Entrances(const uint32_t cluster, const bool right, const bool bottom) noexcept {
+        const uint32_t cx = cluster % _clustersX, cz = cluster / _clustersX;
+        const Rect rect = _get_Cluster_Rect(cluster);
+        if (right && (cx + 1 < _clustersX)) {
+            _add_Entrances(Tile{rect.x1 - 1, rect.z0}, Tile{0, 1}, Tile{1, 0}, static_cast<uint32_t>(rect.z1 - rect.z0));
+        }
+        if (bottom && (cz + 1 < _clustersZ)) {
+            _add_Entrances(Tile{rect.x0, rect.z1 - 1}, Tile{1, 0}, Tile{0, 1}, static_cast<uint32_t>(rect.x1 - rect.x0));
+        }
+    }
+
+    void Pathfinder::_rebuild_Clusters(const std::vector<uint32_t>& changed) noexcept {
+        if (changed.empty()) return;
+        std::vector<bool> isChanged(_clusterNodes.size(), false);
+        for (const uint32_t cluster : changed) isChanged[cluster] = true;
+
+        // The changed clusters and their neighbours lose the entrances on the changed clusters' borders
+        std::vector<uint32_t> affected;
+        std::vector<bool> isAffected(_clusterNodes.size(), false);
+        auto affect = [&](const uint32_t cluster) {
+            if (isAffected[cluster]) return;
+            isAffected[cluster] = true;
+            affected.push_back(cluster);
+        };
+        for (const uint32_t cluster : changed) {
+            const uint32_t cx = cluster % _clustersX, cz = cluster / _clustersX;
+            affect(cluster);
+            if (cx > 0) affect(cluster - 1);
+            if (cx + 1 < _clustersX) affect(cluster + 1);
+            if (cz > 0) affect(cluster - _clustersX);
+            if (cz + 1 < _clustersZ) affect(cluster + _clustersX);
+        }
+
+        // Drop every path inside affected clusters and every entrance crossing a changed border.
+        // Nodes left without an entrance are freed.
+        for (const uint32_t cluster : affected) {
+            std::vector<uint32_t>& nodes = _clusterNodes[cluster];
+            for (const uint32_t node : nodes) {
+                std::vector<Edge>& edges = _nodes[node].edges;
+                std::erase_if(edges, [this, cluster, &isChanged](const Edge& edge) {
+                    const uint32_t other = _nodes[edge.to].cluster;
+                    return (other == cluster) || isChanged[cluster] || isChanged[other];
+                });
+            }
+            std::erase_if(nodes, [this](const uint32_t node) {
+                if (!_nodes[node].edges.empty()) return false;
+                _tileNodes.erase(_get_Tile_Key(_nodes[node].tile));
+                _freeNodes.push_back(node);
+                return true;
+            });
+        }
+
+        // Each border is added once: by the changed cluster on its left or top, else by the changed one below or right
+        for (const uint32_t cluster : affected) {
+            const uint32_t cx = cluster % _clustersX, cz = cluster / _clustersX;
+            const bool right = (cx + 1 < _clustersX) && (isChanged[cluster] || isChanged[cluster + 1]);
+            const bool bottom = (cz + 1 < _clustersZ) && (isChanged[cluster] || isChanged[cluster + _clustersX]);
+            _add_Cluster_Entrances(cluster, right, bottom);
+        }
+        _connect_Clusters(affected);
+    }
+
+    void Pathfinder::_connect_Clusters(const std::vector<uint32_t>& clusters) noexcept {
+        // Paths between entrances of the same cluster. Clusters only touch their own nodes, so they build in parallel.
+        _pool.parallel_For(0, clusters.size(), 0, [this, &clusters](size_t begin, size_t end) {
+            Search_Scratch scratch;
+            std::vector<Tile> path;
+            for (size_t i = begin; i < end; ++i) {
+                const uint32_t cluster = clusters[i];
+                const Rect rect = _get_Cluster_Rect(cluster);
+                const std::vector<uint32_t>& nodes = _clusterNodes[cluster];
+                for (const uint32_t from : nodes) {
+                    _search(_nodes[from].tile, nullptr, rect, scratch);
+                    for (const uint32_t to : nodes) {
+                        if (to == from) continue;
+                        const uint32_t cost = scratch.get_Cost(_nodes[to].tile);
+                        if (cost == _UNREACHED) continue;
+
+                        path.clear();
+                        _append_Path_To(_nodes[to].tile, scratch, path);
+                        _nodes[from].edges.push_back(Edge{.to = to, .cost = cost, .path = path});
+                    }
+                }
+            }
+        });
+    }
+
+    void Pathfinder::_search(const Tile start, const Tile* goal, const Rect& rect, Search_Scratch& scratch) const noexcept {
+        scratch.rect = rect;
+        scratch.reset(static_cast<size_t>(rect.x1 - rect.x0) * (rect.z1 - rect.z0));
+        if (!scratch.contains(start) || (_get_Cost(start) == 0)) return;
+        if ((goal != nullptr) && !scratch.contains(*goal)) goal = nullptr;
+
+        auto heuristic = [goal](const Tile tile) { return (goal != nullptr) ? _get_Distance(tile, *goal) : 0u; };
+        auto push = [&scratch](const uint32_t estimate, const uint32_t index) {
+            scratch.open.emplace_back(estimate, index);
+            std::push_heap(scratch.open.begin(), scratch.open.end(), std::greater<_Open_Entry>());
+        };
+
+        const uint32_t startIndex = scratch.get_Index(start);
+        scratch.cost[startIndex] = 0;
+        scratch.parent[startIndex] = _NO_PARENT;
+        scratch.stamp[startIndex] = scratch.generation;
+        push(heuristic(start), startIndex);
+
+        while (!scratch.open.empty()) {
+            std::pop_heap(scratch.open.begin(), scratch.open.end(), std::greater<_Open_Entry>());
+            const auto [estimate, index] = scratch.open.back();
+            scratch.open.pop_back();
+
+            const Tile tile = scratch.get_Tile(index);
+            const uint32_t cost = scratch.cost[index];
+            if (estimate != cost + heuristic(tile)) continue; // Stale entry
+            if ((goal != nullptr) && (tile == *goal)) return;
+
+            const uint32_t tileCost = _get_Cost(tile);
+            for (const auto& offset : _NEIGHBOURS) {
+                const Tile next{tile.x + offset[0], tile.z + offset[1]};
+                if (!scratch.contains(next)) continue;
+                const uint32_t nextTileCost = _get_Cost(next);
+                if (nextTileCost == 0) continue;
+
+                const uint32_t nextIndex = scratch.get_Index(next);
+                const uint32_t nextCost = cost + tileCost + nextTileCost;
+                if (scratch.is_Reached(nextIndex) && (scratch.cost[nextIndex] <= nextCost)) continue;
+
+                scratch.cost[nextIndex] = nextCost;
+                scratch.parent[nextIndex] = index;
+                scratch.stamp[nextIndex] = scratch.generation;
+                push(nextCost + heuristic(next), nextIndex);
+            }
+        }
+    }
+
+    void Pathfinder::_append_Path_To(const Tile to, const Search_Scratch& scratch, std::vector<Tile>& path) noexcept {
+        const size_t head = path.size();
+        for (uint32_t index = scratch.get_Index(to); scratch.parent[index] != _NO_PARENT; index = scratch.parent[index]) {
+            path.push_back(scratch.get_Tile(index));
+        }
+        std::reverse(path.begin() + head, path.end());
+    }
+
+    void Pathfinder::_append_Path_From(const Tile from, const Search_Scratch& scratch, std::vector<Tile>& path) noexcept {
+        for (uint32_t index = scratch.parent[scratch.get_Index(from)]; index != _NO_PARENT; index = scratch.parent[index]) {
+            path.push_back(scratch.get_Tile(index));
+        }
+    }
+
+    std::vector<uint32_t> Pathfinder::_search_Abstract(
+        const uint32_t startCluster, const uint32_t goalCluster, const Tile goal,
+        const Search_Scratch& fromStart, const Search_Scratch& fromGoal
+    ) const noexcept {
+        // Node _nodes.size() stands for the goal tile, reachable from the goal cluster's entrances
+        const uint32_t goalNode = static_cast<uint32_t>(_nodes.size());
+        thread_local Search_Scratch scratch;
+        scratch.rect = Rect{0, 0, static_cast<int32_t>(goalNode + 1), 1};
+        scratch.reset(goalNode + 1);
+
+        auto push = [](const uint32_t estimate, const uint32_t index) {
+            scratch.open.emplace_back(estimate, index);
+            std::push_heap(scratch.open.begin(), scratch.open.end(), std::greater<_Open_Entry>());
+        };
+        auto relax = [&push](const uint32_t node, const uint32_t cost, const uint32_t parent, const uint32_t estimate) {
+            if (scratch.is_Reached(node) && (scratch.cost[node] <= cost)) return;
+            scratch.cost[node] = cost;
+            scratch.parent[node] = parent;
+            scratch.stamp[node] = scratch.generation;
+            push(cost + estimate, node);
+        };
+
+        for (const uint32_t node : _clusterNodes[startCluster]) {
+            const uint32_t cost = fromStart.get_Cost(_nodes[node].tile);
+            if (cost != _UNREACHED) relax(node, cost, _NO_PARENT, _get_Distance(_nodes[node].tile, goal));
+        }
+
+        while (!scratch.open.empty()) {
+            std::pop_heap(scratch.open.begin(), scratch.open.end(), std::greater<_Open_Entry>());
+            const auto [estimate, node] = scratch.open.back();
+            scratch.open.pop_back();
+
+            const uint32_t cost = scratch.cost[node];
+            if (node == goalNode) {
+                if (estimate != cost) continue;
+                std::vector<uint32_t> nodes;
+                for (uint32_t current = scratch.parent[goalNode]; current != _NO_PARENT; current = scratch.parent[current]) nodes.push_back(current);
+                std::reverse(nodes.begin(), nodes.end());
+                return nodes;
+            }
+            if (estimate != cost + _get_Distance(_nodes[node].tile, goal)) continue; // Stale entry
+
+            for (const Edge& edge : _nodes[node].edges) relax(edge.to, cost + edge.cost, node, _get_Distance(_nodes[edge.to].tile, goal));
+            if (_nodes[node].cluster == goalCluster) {
+                const uint32_t goalCost = fromGoal.get_Cost(_nodes[node].tile);
+                if (goalCost != _UNREACHED) relax(goalNode, cost + goalCost, node, 0);
+            }
+        }
+        return {};
+    }
+
+    void Pathfinder::_append_Abstract_Path(const std::vector<uint32_t>& nodes, std::vector<Tile>& path) const noexcept {
+        for (size_t i = 0; i + 1 < nodes.size(); ++i) {
+            for (const Edge& edge : _nodes[nodes[i]].edges) {
+                if (edge.to != nodes[i + 1]) continue;
+                path.insert(path.end(), edge.path.begin(), edge.path.end());
+                break;
+            }
+        }
+    }
+
+    std::vector<Pathfinder::Tile> Pathfinder::find_Path(const Tile start, const Tile goal) noexcept {
+        ++_queries;
+        std::shared_lock<std::shared_mutex> lock(_graphMutex);
+        if ((_get_Cost(start) == 0) || (_get_Cost(goal) == 0)) {
+            ++_failedQueries;
+            return {};
+        }
+        if (start == goal) return {goal};
+
+        thread_local Search_Scratch fromStart, fromGoal;
+        std::vector<Tile> path;
+        const uint32_t startCluster = _get_Cluster(start), goalCluster = _get_Cluster(goal);
+
+        // Stay inside the cluster when possible
+        _search(start, (startCluster == goalCluster) ? &goal : nullptr, _get_Cluster_Rect(startCluster), fromStart);
+        if ((startCluster == goalCluster) && (fromStart.get_Cost(goal) != _UNREACHED)) {
+            _append_Path_To(goal, fromStart, path);
+            return path;
+        }
+        _search(goal, nullptr, _get_Cluster_Rect(goalCluster), fromGoal);
+
+        const uint64_t cacheKey = (static_cast<uint64_t>(startCluster) << 32) | goalCluster;
+        std::vector<uint32_t> nodes;
+        {
+            std::lock_guard<std::mutex> cacheLock(_cacheMutex);
+            auto entry = _cache.find(cacheKey);
+            if (entry != _cache.end()) nodes = entry->second;
+        }
+
+        // A cached route is only usable if the start and goal reach its ends within their clusters
+        if (!nodes.empty() && (fromStart.get_Cost(_nodes[nodes.front()].tile) != _UNREACHED) && (fromGoal.get_Cost(_nodes[nodes.back()].tile) != _UNREACHED)) {
+            ++_cacheHits;
+        } else {
+            nodes = _search_Abstract(startCluster, goalCluster, goal, fromStart, fromGoal);
+            if (nodes.empty()) {
+                ++_failedQueries;
+                return {};
+            }
+
+            std::lock_guard<std::mutex> cacheLock(_cacheMutex);
+            if (_cache.size() >= _settings.cacheCapacity) _cache.erase(_cache.begin());
+            _cache[cacheKey] = nodes;
+        }
+
+        _append_Path_To(_nodes[nodes.front()].tile, fromStart, path);
+        _append_Abstract_Path(nodes, path);
+        _append_Path_From(_nodes[nodes.back()].tile, fromGoal, path);
+        return path;
+    }
+
+    void Pathfinder::resolve(std::vector<AiComponent::Path_Request>&& requests, const std::function<void(AiComponent::Path_Result&&)>& deliver) noexcept {
+        auto shared = std::make_shared<std::vector<AiComponent::Path_Request>>(std::move(requests));
+        const size_t perTask = _settings.requestsPerTask;
+        for (size_t begin = 0; begin < shared->size(); begin += perTask) {
+            const size_t end = std::min(begin + perTask, shared->size());
+            ++_tasksInFlight;
+            _pool.submit([this, shared, begin, end, deliver]() {
+                for (size_t i = begin; i < end; ++i) {
+                    const AiComponent::Path_Request& request = (*shared)[i];
+                    const std::vector<Tile> tiles = find_Path(
+                        Tile{static_cast<int32_t>(std::floor(request.start.x)), static_cast<int32_t>(std::floor(request.start.z))},
+                        Tile{static_cast<int32_t>(std::floor(request.goal.x)), static_cast<int32_t>(std::floor(request.goal.z))}
+                    );
+
+                    AiComponent::Path_Result result{.agent = request.agent, .requestId = request.requestId, .waypoints = {}};
+                    result.waypoints.reserve(tiles.size());
+                    for (const Tile& tile : tiles) {
+                        result.waypoints.push_back(AiComponent::Point{tile.x + 0.5f, request.start.y, tile.z + 0.5f});
+                    }
+                    deliver(std::move(result));
+                }
+                --_tasksInFlight;
+            });
+        }
+    }
+
+    void Pathfinder::attach(AiComponent& ai) noexcept {
+        ai.set_Path_Resolver([this, &ai](std::vector<AiComponent::Path_Request>&& requests) {
+            resolve(std::move(requests), [&ai](AiComponent::Path_Result&& result) { ai.deliver_Path(std::move(result)); });
+        });
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef LOVE_PATHFINDER_HPP
+#define LOVE_PATHFINDER_HPP
+
+#include "world.hpp"
+#include "../components/ai_component.hpp"
+
+#include <love/common/system/thread_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace love_engine {
+    // Hierarchical A* (HPA*) over a World's tiles.
+    // The world is split into square clusters connected through entrances on their borders. Queries search the
+    // graph of entrances and then expand each abstract step into tiles, so long paths only touch a few clusters.
+    // Abstract paths are cached per (start cluster, goal cluster) pair.
+    // Moving between neighbouring tiles costs the sum of both tile costs. Tiles of unloaded chunks are impassable.
+    class Pathfinder {
+        public:
+            typedef struct Settings_ {
+                uint32_t clusterSize = 16;
+                size_t cacheCapacity = 16384;
+                // Requests handed to one worker task by resolve()
+                size_t requestsPerTask = 16;
+            } Settings;
+
+            typedef struct Tile_ {
+                int32_t x;
+                int32_t z;
+                bool operator==(const Tile_&) const = default;
+            } Tile;
+
+            typedef struct Statistics_ {
+                uint64_t queries = 0;
+                uint64_t cacheHits = 0;
+                uint64_t failedQueries = 0;
+            } Statistics;
+
+            Pathfinder(const World& world, ThreadPool& pool, const Settings settings);
+            Pathfinder(Pathfinder const&) = delete;
+            void operator=(Pathfinder const&) = delete;
+            // Waits for queries started by resolve().
+            ~Pathfinder();
+
+            // Rebuilds the clusters overlapping chunks changed since the last update, and their neighbours.
+            // Blocks until running queries finish.
+            void update() noexcept;
+
+            // Safe to call from any thread.
+            // @return Tiles after @p start up to and including @p goal, or empty if there is no path.
+            std::vector<Tile> find_Path(const Tile start, const Tile goal) noexcept;
+
+            // Resolves @p requests on the worker pool and passes each result to @p deliver from a worker thread.
+            void resolve(std::vector<AiComponent::Path_Request>&& requests, const std::function<void(AiComponent::Path_Result&&)>& deliver) noexcept;
+            // Makes this pathfinder answer the AI component's path requests.
+            void attach(AiComponent& ai) noexcept;
+
+            Statistics get_Statistics() const noexcept;
+
+        private:
+            typedef struct Edge_ {
+                uint32_t to;
+                uint32_t cost;
+                // Tiles after the source node up to and including the destination node
+                std::vector<Tile> path;
+            } Edge;
+            typedef struct Node_ {
+                Tile tile;
+                uint32_t cluster;
+                std::vector<Edge> edges;
+            } Node;
+            typedef struct Rect_ {
+                int32_t x0, z0, x1, z1; // End exclusive
+            } Rect;
+            struct Search_Scratch;
+
+            void _build() noexcept;
+            // Replaces the entrances on every border of @p changed and the paths inside them and their neighbours.
+            // Tile costs must already be updated.
+            void _rebuild_Clusters(const std::vector<uint32_t>& changed) noexcept;
+            // Adds the entrances on the right and bottom borders of @p cluster
+            void _add_Cluster_Entrances(const uint32_t cluster, const bool right, const bool bottom) noexcept;
+            // Connects the entrances inside each of @p clusters, in parallel
+            void _connect_Clusters(const std::vector<uint32_t>& clusters) noexcept;
+            // Adds entrances along a cluster border starting at @p start, stepping by @p step, crossing to the tile at @p across.
+            void _add_Entrances(const Tile start, const Tile step, const Tile across, const uint32_t length) noexcept;
+            uint32_t _get_Node(const Tile tile) noexcept;
+            uint32_t _get_Cluster(const Tile tile) const noexcept;
+            Rect _get_Cluster_Rect(const uint32_t cluster) const noexcept;
+            uint8_t _get_Cost(const Tile tile) const noexcept;
+            // Dijkstra, or A* when @p goal is inside @p rect, from @p start within @p rect.
+            void _search(const Tile start, const Tile* goal, const Rect& rect, Search_Scratch& scratch) const noexcept;
+            // Appends the tiles after the search origin up to and including @p to.
+            static void _append_Path_To(const Tile to, const Search_Scratch& scratch, std::vector<Tile>& path) noexcept;
+            // Appends the tiles after @p from up to and including the search origin.
+            static void _append_Path_From(const Tile from, const Search_Scratch& scratch, std::vector<Tile>& path) noexcept;
+            // @return Nodes from an entrance of the start cluster to one of the goal cluster, or empty if unreachable.
+            std::vector<uint32_t> _search_Abstract(
+                const uint32_t startCluster, const uint32_t goalCluster, const Tile goal,
+                const Search_Scratch& fromStart, const Search_Scratch& fromGoal
+            ) const noexcept;
+            void _append_Abstract_Path(const std::vector<uint32_t>& nodes, std::vector<Tile>& path) const noexcept;
+
+            const World& _world;
+            ThreadPool& _pool;
+            Settings _settings;
+
+            // Snapshot of the world's tile costs, so queries never read the world while it is edited
+            std::vector<uint8_t> _tileCosts;
+            uint32_t _width = 0;
+            uint32_t _depth = 0;
+            uint32_t _clustersX = 0;
+            uint32_t _clustersZ = 0;
+            uint64_t _builtVersion = UINT64_MAX;
+            std::vector<Node> _nodes;
+            // Nodes of removed entrances, reused by _get_Node()
+            std::vector<uint32_t> _freeNodes;
+            std::vector<std::vector<uint32_t>> _clusterNodes;
+            std::unordered_map<uint64_t, uint32_t> _tileNodes;
+            std::shared_mutex _graphMutex;
+
+            std::mutex _cacheMutex;
+            std::unordered_map<uint64_t, std::vector<uint32_t>> _cache;
+
+            std::atomic<uint64_t> _queries = 0;
+            std::atomic<uint64_t> _cacheHits = 0;
+            std::atomic<uint64_t> _failedQueries = 0;
+            std::atomic<size_t> _tasksInFlight = 0;
+    };
+}
+
+#endif // LOVE_PATHFINDER_HPP
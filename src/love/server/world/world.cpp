@@ -0,0 +1,604 @@
+#include "world.hpp"
+
+#include "../components/component.hpp"
+
+#include <love/common/data/bkv/bkv.hpp>
+#include <love/common/data/bkv/bkv_builder.hpp>
+#include <love/common/data/files/file_compression.hpp>
+#include <love/common/error/stack_trace.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+namespace love_engine {
+    World::World(const uint32_t width, const uint32_t depth, const Settings settings, const Chunk_Generator& generator)
+    : _width(width), _depth(depth), _settings(settings), _generator(generator) {
+        if (_settings.chunkSize == 0) _settings.chunkSize = 64;
+
+        if (_settings.saveDirectory.empty()) {
+            // Nothing to stream from, so every chunk stays resident
+            const int32_t size = static_cast<int32_t>(_settings.chunkSize);
+            for (int32_t chunkZ = 0; chunkZ * size < static_cast<int32_t>(_depth); ++chunkZ) {
+                for (int32_t chunkX = 0; chunkX * size < static_cast<int32_t>(_width); ++chunkX) {
+                    const Chunk_Key key = _get_Key(chunkX, chunkZ);
+                    _chunks.emplace(key, std::make_unique<Chunk>(Chunk{.tiles = std::make_shared<std::vector<uint8_t>>(_generate_Chunk(key))}));
+                }
+            }
+        } else {
+            // Changes appended since their chunks were last saved, applied when those chunks load
+            _journal = std::make_unique<FileJournal>(_settings.saveDirectory + "/tile_changes.bin", FileJournal::Settings{
+                .compactionThreshold = _settings.journalCompactionBytes,
+            });
+            const std::vector<uint8_t> base = _journal->open([this](const uint64_t sequence, const uint8_t*const data, const size_t size) {
+                for (size_t head = 0; head + JOURNAL_DELTA_SIZE <= size; head += JOURNAL_DELTA_SIZE) _add_Replayed_Delta(sequence, data + head);
+            });
+            constexpr size_t baseDeltaSize = sizeof(uint64_t) + JOURNAL_DELTA_SIZE;
+            for (size_t head = 0; head + baseDeltaSize <= base.size(); head += baseDeltaSize) {
+                uint64_t sequence;
+                std::memcpy(&sequence, base.data() + head, sizeof(sequence));
+                _add_Replayed_Delta(sequence, base.data() + head + sizeof(sequence));
+            }
+            _journalSequence = _journal->get_Sequence();
+            // The base is read after the records, but its deltas are older
+            for (auto& [key, deltas] : _replayedDeltas) {
+                std::stable_sort(deltas.begin(), deltas.end(), [](const Journal_Delta& a, const Journal_Delta& b) { return a.sequence < b.sequence; });
+            }
+            _get_IO_Pool();
+        }
+    }
+
+    World::~World() {
+        if (!_ioPool) return;
+        if (_journal) _start_Compaction();
+        // Also finishes snapshot saves
+        flush();
+    }
+
+    void World::_add_Replayed_Delta(const uint64_t sequence, const uint8_t*const delta) noexcept {
+        Journal_Delta replayed{.sequence = sequence, .x = 0, .z = 0, .cost = delta[2 * sizeof(int32_t)]};
+        std::memcpy(&replayed.x, delta, sizeof(int32_t));
+        std::memcpy(&replayed.z, delta + sizeof(int32_t), sizeof(int32_t));
+        if (!contains(replayed.x, replayed.z)) return;
+        const int32_t size = static_cast<int32_t>(_settings.chunkSize);
+        _replayedDeltas[_get_Key(replayed.x / size, replayed.z / size)].push_back(replayed);
+    }
+
+    ThreadPool& World::_get_IO_Pool() noexcept {
+        if (!_ioPool) _ioPool = std::make_unique<ThreadPool>("WORLD_IO", std::max<size_t>(_settings.ioThreads, 1));
+        return *_ioPool;
+    }
+
+    void World::set_Tile_Cost(const int32_t x, const int32_t z, const uint8_t cost) noexcept {
+        if (!contains(x, z)) return;
+        const int32_t size = static_cast<int32_t>(_settings.chunkSize);
+        const auto chunk = _chunks.find(_get_Key(x / size, z / size));
+        if (chunk == _chunks.end()) return;
+
+        // Copy on write if a save or snapshot still holds the tiles. A stale count only causes a needless copy.
+        // The snapshot chunk list's own reference only counts while a snapshot shares the list.
+        std::shared_ptr<std::vector<uint8_t>>& tiles = chunk->second->tiles;
+        const long owners = (chunk->second->inSnapshot && (_snapshotChunks.use_count() == 1)) ? 2 : 1;
+        if (tiles.use_count() > owners) {
+            tiles = std::make_shared<std::vector<uint8_t>>(*tiles);
+            chunk->second->inSnapshot = false;
+            ++_statistics.copiedChunks;
+        }
+        (*tiles)[_get_Tile_Index(x, z)] = cost;
+        chunk->second->dirty = true;
+        chunk->second->lastUsedTick = _tick;
+        _mark_Changed(chunk->first);
+
+        if (_journal) {
+            uint8_t delta[JOURNAL_DELTA_SIZE];
+            std::memcpy(delta, &x, sizeof(int32_t));
+            std::memcpy(delta + sizeof(int32_t), &z, sizeof(int32_t));
+            delta[2 * sizeof(int32_t)] = cost;
+            _journalBuffer.insert(_journalBuffer.end(), delta, delta + JOURNAL_DELTA_SIZE);
+        }
+    }
+
+    void World::_mark_Changed(const Chunk_Key key) noexcept {
+        ++_version;
+        if (_snapshotChunks) _snapshotDirty.insert(key);
+        if (!_changes.empty() && (_changes.back().key == key)) {
+            _changes.back().version = _version;
+            return;
+        }
+        _changes.push_back(Change{.version = _version, .key = key});
+
+        // Forget the oldest half. Readers that far behind start over.
+        if (_changes.size() > MAX_TRACKED_CHANGES) {
+            const size_t dropped = _changes.size() / 2;
+            _changesFloor = _changes[dropped - 1].version;
+            _changes.erase(_changes.begin(), _changes.begin() + dropped);
+        }
+    }
+
+    bool World::get_Changed_Chunks(const uint64_t version, std::vector<Chunk_Change>& changes) const noexcept {
+        if (version < _changesFloor) return false;
+
+        const auto first = std::upper_bound(_changes.begin(), _changes.end(), version,
+            [](const uint64_t value, const Change& change) { return value < change.version; });
+        std::unordered_set<Chunk_Key> seen;
+        for (auto change = first; change != _changes.end(); ++change) {
+            if (seen.insert(change->key).second) changes.push_back(Chunk_Change{.chunkX = _get_Chunk_X(change->key), .chunkZ = _get_Chunk_Z(change->key)});
+        }
+        return true;
+    }
+
+    void World::copy_Tile_Costs(uint8_t*const costs) const noexcept {
+        std::memset(costs, 0, static_cast<size_t>(_width) * _depth);
+
+        const uint32_t size = _settings.chunkSize;
+        for (const auto& [key, chunk] : _chunks) {
+            const uint32_t x0 = static_cast<uint32_t>(_get_Chunk_X(key)) * size, z0 = static_cast<uint32_t>(_get_Chunk_Z(key)) * size;
+            const uint32_t rowLength = std::min(size, _width - x0), rows = std::min(size, _depth - z0);
+            for (uint32_t row = 0; row < rows; ++row) {
+                std::memcpy(costs + static_cast<size_t>(z0 + row) * _width + x0, chunk->tiles->data() + static_cast<size_t>(row) * size, rowLength);
+            }
+        }
+    }
+
+    void World::copy_Chunk_Tile_Costs(const int32_t chunkX, const int32_t chunkZ, uint8_t*const costs) const noexcept {
+        const uint32_t size = _settings.chunkSize;
+        const uint32_t x0 = static_cast<uint32_t>(chunkX) * size, z0 = static_cast<uint32_t>(chunkZ) * size;
+        if ((chunkX < 0) || (chunkZ < 0) || (x0 >= _width) || (z0 >= _depth)) return;
+
+        const auto chunk = _chunks.find(_get_Key(chunkX, chunkZ));
+        const uint32_t rowLength = std::min(size, _width - x0), rows = std::min(size, _depth - z0);
+        for (uint32_t row = 0; row < rows; ++row) {
+            uint8_t*const destination = costs + static_cast<size_t>(z0 + row) * _width + x0;
+            if (chunk == _chunks.end()) std::memset(destination, 0, rowLength);
+            else std::memcpy(destination, chunk->second->tiles->data() + static_cast<size_t>(row) * size, rowLength);
+        }
+    }
+
+    std::string World::_get_Chunk_Path(const Chunk_Key key) const noexcept {
+        std::stringstream path;
+        path << _settings.saveDirectory << "/chunk_" << _get_Chunk_X(key) << '_' << _get_Chunk_Z(key) << ".bkv";
+        return path.str();
+    }
+
+    std::vector<uint8_t> World::_generate_Chunk(const Chunk_Key key) const noexcept {
+        std::vector<uint8_t> tiles(static_cast<size_t>(_settings.chunkSize) * _settings.chunkSize, _settings.defaultCost);
+        if (_generator) _generator(_get_Chunk_X(key), _get_Chunk_Z(key), tiles);
+        return tiles;
+    }
+
+    void World::_load_Chunk(const Chunk_Key key) noexcept {
+        _loadingChunks.insert(key);
+        _get_IO_Pool().submit([this, key]() {
+            IO_Result result{.key = key, .kind = IO_Kind::LOAD, .failed = false, .tiles = {}};
+            const std::string path = _get_Chunk_Path(key);
+            try {
+                if (!std::filesystem::exists(path)) result.tiles = _generate_Chunk(key);
+                else {
+                    const FileIO::FileContent content = FileCompression::decompress_File_Raw(path.c_str());
+                    const BKV chunk(content.data(), content.size());
+                    if ((chunk.get_I32("x") != _get_Chunk_X(key)) || (chunk.get_I32("z") != _get_Chunk_Z(key))
+                        || (chunk.get_I32("size") != static_cast<int32_t>(_settings.chunkSize))) {
+                        std::stringstream error;
+                        error << "Chunk file does not match its chunk: " << path;
+                        throw std::runtime_error(error.str());
+                    }
+                    result.tiles = chunk.get_Bytes("tiles");
+                    // Missing in chunks saved before the world had a journal
+                    if (chunk.contains("journalSequence")) result.journalSequence = static_cast<uint64_t>(chunk.get_I64("journalSequence"));
+                    if (result.tiles.size() != static_cast<size_t>(_settings.chunkSize) * _settings.chunkSize) {
+                        std::stringstream error;
+                        error << "Chunk file has the wrong number of tiles: " << path;
+                        throw std::runtime_error(error.str());
+                    }
+                }
+            } catch (const std::exception&) {
+                result.failed = true;
+            }
+
+            std::lock_guard<std::mutex> lock(_ioResultsMutex);
+            _ioResults.push_back(std::move(result));
+        });
+    }
+
+    void World::_save_Chunk(const Chunk_Key key, Chunk& chunk) noexcept {
+        // Replay skips the records up to the sequence stored with the tiles, so those must hold every change in them.
+        // Changes still buffered get a later sequence and replay harmlessly over the tiles.
+        _append_Journal();
+        // The task shares the tiles, so the chunk can keep changing or unload while it runs
+        chunk.dirty = false;
+        Queued_Save save{.tiles = chunk.tiles, .journalSequence = _journalSequence};
+        if (_savingChunks.contains(key)) _queuedSaves[key] = std::move(save);
+        else _submit_Save(key, std::move(save));
+    }
+
+    void World::_submit_Save(const Chunk_Key key, Queued_Save save) noexcept {
+        _savingChunks.insert(key);
+        _get_IO_Pool().submit([this, key, save = std::move(save)]() {
+            IO_Result result{.key = key, .kind = IO_Kind::SAVE, .failed = false, .tiles = {}};
+            const std::vector<uint8_t>& tiles = *save.tiles;
+            try {
+                BKV_Builder builder;
+                builder.add_I32("x", _get_Chunk_X(key))
+                    .add_I32("z", _get_Chunk_Z(key))
+                    .add_I32("size", static_cast<int32_t>(_settings.chunkSize))
+                    .add_I64("journalSequence", static_cast<int64_t>(save.journalSequence))
+                    .add_Bytes("tiles", tiles.data(), tiles.size());
+                const BKV chunk = builder.build();
+
+                const std::string path = _get_Chunk_Path(key);
+                FileIO::ensure_Parent_Directory_Exists(path);
+                FileCompression::compress_File(path.c_str(), chunk.data(), chunk.size());
+            } catch (const std::exception&) {
+                result.failed = true;
+                result.tiles = tiles;
+            }
+
+            std::lock_guard<std::mutex> lock(_ioResultsMutex);
+            _ioResults.push_back(std::move(result));
+        });
+    }
+
+    void World::_unload_Chunk(const Chunk_Key key) noexcept {
+        const auto chunk = _chunks.find(key);
+        if (chunk->second->dirty) _save_Chunk(key, *chunk->second);
+        _chunks.erase(chunk);
+        _mark_Changed(key);
+    }
+
+    void World::_apply_IO_Results() noexcept {
+        std::vector<IO_Result> results;
+        {
+            std::lock_guard<std::mutex> lock(_ioResultsMutex);
+            results.swap(_ioResults);
+        }
+
+        for (IO_Result& result : results) {
+            if (result.kind == IO_Kind::COMPACTION) {
+                _compaction = Compaction_State::IDLE;
+                if (result.failed) ++_statistics.failedJournalCompactions;
+                else ++_statistics.journalCompactions;
+                continue;
+            }
+
+            if (result.kind == IO_Kind::LOAD) {
+                _loadingChunks.erase(result.key);
+                if (result.failed) {
+                    _failedChunks.insert(result.key);
+                    ++_statistics.failedLoads;
+                    continue;
+                }
+                // Replayed changes stay recorded until the chunk is saved with them
+                bool replayed = false;
+                const auto deltas = _replayedDeltas.find(result.key);
+                if (deltas != _replayedDeltas.end()) {
+                    for (const Journal_Delta& delta : deltas->second) {
+                        if (delta.sequence <= result.journalSequence) continue;
+                        result.tiles[_get_Tile_Index(delta.x, delta.z)] = delta.cost;
+                        replayed = true;
+                    }
+                }
+                _chunks.emplace(result.key, std::make_unique<Chunk>(Chunk{
+                    .tiles = std::make_shared<std::vector<uint8_t>>(std::move(result.tiles)),
+                    .lastUsedTick = _tick,
+                    .dirty = replayed,
+                }));
+                ++_statistics.loads;
+                _mark_Changed(result.key);
+                continue;
+            }
+
+            _savingChunks.erase(result.key);
+            const auto queued = _queuedSaves.find(result.key);
+            const bool superseded = queued != _queuedSaves.end();
+            if (superseded) {
+                _submit_Save(result.key, std::move(queued->second));
+                _queuedSaves.erase(queued);
+            }
+            if (!result.failed) {
+                ++_statistics.saves;
+                // Only resident chunks are saved, so their replayed changes were applied before
+                _replayedDeltas.erase(result.key);
+                continue;
+            }
+
+            // Keep the unsaved tiles resident, so the next save retries them. A newer resident copy or queued save
+            // already supersedes them.
+            ++_statistics.failedSaves;
+            _compactionFailed = true;
+            if (superseded) continue;
+            const auto [chunk, inserted] = _chunks.try_emplace(result.key, nullptr);
+            if (inserted) {
+                chunk->second = std::make_unique<Chunk>(Chunk{
+                    .tiles = std::make_shared<std::vector<uint8_t>>(std::move(result.tiles)),
+                    .lastUsedTick = _tick,
+                });
+                _mark_Changed(result.key);
+            }
+            chunk->second->dirty = true;
+        }
+
+        // Every record in the journal is now in a chunk file or in _replayedDeltas
+        if ((_compaction == Compaction_State::SAVING) && _savingChunks.empty()) {
+            if (_compactionFailed) _compaction = Compaction_State::IDLE;
+            else _submit_Compaction();
+        }
+    }
+
+    void World::_append_Journal() noexcept {
+        // Held back while compacting, since compact() drops everything appended before it finishes
+        if (_journalBuffer.empty() || (_compaction != Compaction_State::IDLE)) return;
+        try {
+            _journal->append(_journalBuffer.data(), _journalBuffer.size());
+            _journalBuffer.clear();
+            _journalSequence = _journal->get_Sequence();
+            ++_statistics.journalAppends;
+        } catch (const std::exception& e) {
+            // Kept for the next append. Their chunks stay changed either way.
+            ++_statistics.failedJournalAppends;
+            if (_logger) _logger->log(Log_Status::ERROR, std::string("Could not append world changes to the journal: ") + e.what());
+        }
+    }
+
+    void World::_start_Compaction() noexcept {
+        _append_Journal();
+        if (_compaction == Compaction_State::IDLE) {
+            _compaction = Compaction_State::SAVING;
+            _compactionFailed = false;
+        }
+        for (auto& [key, chunk] : _chunks) {
+            if (chunk->dirty) _save_Chunk(key, *chunk);
+        }
+    }
+
+    void World::_submit_Compaction() noexcept {
+        _compaction = Compaction_State::WRITING;
+        std::vector<uint8_t> base;
+        for (const auto& [key, deltas] : _replayedDeltas) {
+            for (const Journal_Delta& delta : deltas) {
+                uint8_t entry[sizeof(uint64_t) + JOURNAL_DELTA_SIZE];
+                std::memcpy(entry, &delta.sequence, sizeof(uint64_t));
+                std::memcpy(entry + sizeof(uint64_t), &delta.x, sizeof(int32_t));
+                std::memcpy(entry + sizeof(uint64_t) + sizeof(int32_t), &delta.z, sizeof(int32_t));
+                entry[sizeof(uint64_t) + 2 * sizeof(int32_t)] = delta.cost;
+                base.insert(base.end(), entry, entry + sizeof(entry));
+            }
+        }
+
+        _get_IO_Pool().submit([this, base = std::move(base)]() {
+            IO_Result result{.key = 0, .kind = IO_Kind::COMPACTION, .failed = false, .tiles = {}};
+            try {
+                _journal->compact(base.data(), base.size());
+            } catch (const std::exception& e) {
+                result.failed = true;
+                if (_logger) _logger->log(Log_Status::ERROR, std::string("Could not compact the world journal: ") + e.what());
+            }
+
+            std::lock_guard<std::mutex> lock(_ioResultsMutex);
+            _ioResults.push_back(std::move(result));
+        });
+    }
+
+    void World::update() noexcept {
+        ++_tick;
+        if (_settings.saveDirectory.empty()) return;
+        _apply_IO_Results();
+
+        // Touch resident chunks near focus points and request missing ones
+        const int32_t size = static_cast<int32_t>(_settings.chunkSize);
+        const int32_t radius = static_cast<int32_t>(_settings.loadRadius);
+        const int32_t lastChunkX = (static_cast<int32_t>(_width) - 1) / size, lastChunkZ = (static_cast<int32_t>(_depth) - 1) / size;
+        for (const Focus& focus : _focusPoints) {
+            const int32_t focusX = std::clamp(focus.x, 0, static_cast<int32_t>(_width) - 1) / size;
+            const int32_t focusZ = std::clamp(focus.z, 0, static_cast<int32_t>(_depth) - 1) / size;
+            for (int32_t chunkZ = std::max(focusZ - radius, 0); chunkZ <= std::min(focusZ + radius, lastChunkZ); ++chunkZ) {
+                for (int32_t chunkX = std::max(focusX - radius, 0); chunkX <= std::min(focusX + radius, lastChunkX); ++chunkX) {
+                    const Chunk_Key key = _get_Key(chunkX, chunkZ);
+                    const auto chunk = _chunks.find(key);
+                    if (chunk != _chunks.end()) chunk->second->lastUsedTick = _tick;
+                    else if (!_loadingChunks.contains(key) && !_failedChunks.contains(key) && !_savingChunks.contains(key)) _load_Chunk(key);
+                }
+            }
+        }
+
+        // Unload idle chunks, then the least recently used ones until the world fits its budget.
+        // Chunks used this tick are never evicted, even over budget.
+        std::vector<std::pair<uint64_t, Chunk_Key>> evictable;
+        for (const auto& [key, chunk] : _chunks) {
+            if (chunk->lastUsedTick + _settings.idleTicks < _tick) evictable.emplace_back(0, key);
+            else if (chunk->lastUsedTick != _tick) evictable.emplace_back(chunk->lastUsedTick, key);
+        }
+        std::sort(evictable.begin(), evictable.end());
+
+        const size_t chunkBytes = _get_Chunk_Bytes();
+        for (const auto& [lastUsedTick, key] : evictable) {
+            if ((lastUsedTick != 0) && (_chunks.size() * chunkBytes <= _settings.memoryBudget)) break;
+            _unload_Chunk(key);
+        }
+    }
+
+    size_t World::save_Dirty() noexcept {
+        if (!_journal) return 0;
+
+        const size_t changes = _journalBuffer.size() / JOURNAL_DELTA_SIZE;
+        _append_Journal();
+        if ((_compaction == Compaction_State::IDLE) && _journal->needs_Compaction()) _start_Compaction();
+        return changes;
+    }
+
+    void World::flush() noexcept {
+        if (!_ioPool) return;
+        // Finished saves submit the saves queued behind them, and the compaction waiting for them
+        do {
+            _ioPool->wait_For_Idle();
+            _apply_IO_Results();
+        } while (!_savingChunks.empty() || (_compaction != Compaction_State::IDLE));
+    }
+
+    SystemScheduler::System World::get_System() noexcept {
+        return SystemScheduler::System{
+            .name = "world",
+            .reads = {},
+            .writes = {Component::get_Id<World>()},
+            .update = [this](ThreadPool&) { update(); },
+        };
+    }
+
+    World::Statistics World::get_Statistics() const noexcept {
+        Statistics statistics = _statistics;
+        statistics.residentChunks = _chunks.size();
+        statistics.residentBytes = _chunks.size() * _get_Chunk_Bytes();
+        statistics.pendingLoads = _loadingChunks.size();
+        statistics.pendingSaves = _savingChunks.size() + _queuedSaves.size();
+        statistics.snapshotSaves = _snapshotSaves.load();
+        statistics.lastSnapshotSaveTime = std::chrono::nanoseconds(_lastSnapshotSaveTime.load());
+        return statistics;
+    }
+
+    World::Snapshot World::take_Snapshot() noexcept {
+        if (!_snapshotChunks) {
+            _snapshotChunks = std::make_shared<std::vector<Snapshot::Chunk>>();
+            _snapshotChunks->reserve(_chunks.size());
+            for (const auto& [key, chunk] : _chunks) {
+                _snapshotIndices.emplace(key, _snapshotChunks->size());
+                _snapshotChunks->push_back(Snapshot::Chunk{.chunkX = _get_Chunk_X(key), .chunkZ = _get_Chunk_Z(key), .tiles = chunk->tiles});
+                chunk->inSnapshot = true;
+            }
+        } else if (!_snapshotDirty.empty()) {
+            // The last snapshot keeps its list, so only a still held one makes this copy the list
+            if (_snapshotChunks.use_count() > 1) _snapshotChunks = std::make_shared<std::vector<Snapshot::Chunk>>(*_snapshotChunks);
+            std::vector<Snapshot::Chunk>& chunks = *_snapshotChunks;
+            for (const Chunk_Key key : _snapshotDirty) {
+                const auto resident = _chunks.find(key);
+                const auto index = _snapshotIndices.find(key);
+                if (resident != _chunks.end()) {
+                    const Snapshot::Chunk entry{.chunkX = _get_Chunk_X(key), .chunkZ = _get_Chunk_Z(key), .tiles = resident->second->tiles};
+                    if (index != _snapshotIndices.end()) chunks[index->second] = entry;
+                    else {
+                        _snapshotIndices.emplace(key, chunks.size());
+                        chunks.push_back(entry);
+                    }
+                    resident->second->inSnapshot = true;
+                } else if (index != _snapshotIndices.end()) {
+                    // Unloaded, so swap the last chunk into its place
+                    const size_t removed = index->second;
+                    _snapshotIndices.erase(index);
+                    if (removed + 1 != chunks.size()) {
+                        chunks[removed] = std::move(chunks.back());
+                        _snapshotIndices[_get_Key(chunks[removed].chunkX, chunks[removed].chunkZ)] = removed;
+                    }
+                    chunks.pop_back();
+                }
+            }
+            _snapshotDirty.clear();
+        }
+        return Snapshot{.width = _width, .depth = _depth, .chunkSize = _settings.chunkSize, .chunks = _snapshotChunks};
+    }
+
+    void World::save_Snapshot(const std::string& filePath) noexcept {
+        _get_IO_Pool().submit([this, filePath, snapshot = take_Snapshot()]() {
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                write_Snapshot(snapshot, filePath);
+            } catch (const std::exception& e) {
+                if (_logger) _logger->log(Log_Status::ERROR, std::string("Could not save world snapshot: ") + e.what());
+                return;
+            }
+            const std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - start;
+            _lastSnapshotSaveTime.store(duration.count());
+            ++_snapshotSaves;
+
+            if (_logger) {
+                std::stringstream message;
+                message << "Saved world snapshot of " << snapshot.chunks->size() << " chunks to \"" << filePath << "\" in "
+                    << std::chrono::duration<double, std::milli>(duration).count() << " ms.";
+                _logger->log(message.str());
+            }
+        });
+    }
+
+    void World::apply_Snapshot(const Snapshot& snapshot) {
+        if ((snapshot.width != _width) || (snapshot.depth != _depth) || (snapshot.chunkSize != _settings.chunkSize)) {
+            throw std::invalid_argument(StackTrace::append_Stacktrace("The snapshot does not match the world's dimensions."));
+        }
+
+        for (const Snapshot::Chunk& chunk : *snapshot.chunks) {
+            const Chunk_Key key = _get_Key(chunk.chunkX, chunk.chunkZ);
+            std::unique_ptr<Chunk>& resident = _chunks[key];
+            if (!resident) resident = std::make_unique<Chunk>();
+            resident->tiles = std::make_shared<std::vector<uint8_t>>(*chunk.tiles);
+            resident->inSnapshot = false;
+            resident->lastUsedTick = _tick;
+            resident->dirty = true;
+            _mark_Changed(key);
+            // Not in the journal, so saved right away
+            if (_journal) _save_Chunk(key, *resident);
+        }
+    }
+
+    void World::write_Snapshot(const Snapshot& snapshot, const std::string& filePath) {
+        // Chunks are packed as [x: i32][z: i32][tiles] into one byte array
+        const size_t tileCount = static_cast<size_t>(snapshot.chunkSize) * snapshot.chunkSize;
+        const size_t chunkBytes = 2 * sizeof(int32_t) + tileCount;
+        const std::vector<Snapshot::Chunk>& snapshotChunks = *snapshot.chunks;
+        std::vector<uint8_t> chunks(snapshotChunks.size() * chunkBytes);
+        for (size_t i = 0; i < snapshotChunks.size(); ++i) {
+            uint8_t* head = chunks.data() + i * chunkBytes;
+            std::memcpy(head, &snapshotChunks[i].chunkX, sizeof(int32_t));
+            std::memcpy(head + sizeof(int32_t), &snapshotChunks[i].chunkZ, sizeof(int32_t));
+            std::memcpy(head + 2 * sizeof(int32_t), snapshotChunks[i].tiles->data(), tileCount);
+        }
+
+        BKV_Builder builder;
+        builder.add_String("type", "world_snapshot")
+            .add_I32("width", static_cast<int32_t>(snapshot.width))
+            .add_I32("depth", static_cast<int32_t>(snapshot.depth))
+            .add_I32("chunkSize", static_cast<int32_t>(snapshot.chunkSize))
+            .add_Bytes("chunks", chunks.data(), chunks.size());
+        const BKV record = builder.build();
+
+        FileIO::ensure_Parent_Directory_Exists(filePath);
+        FileCompression::compress_File(filePath.c_str(), record.data(), record.size());
+    }
+
+    World::Snapshot World::read_Snapshot(const std::string& filePath) {
+        const FileIO::FileContent content = FileCompression::decompress_File_Raw(filePath.c_str());
+        const BKV record(content.data(), content.size());
+
+        Snapshot snapshot;
+        std::vector<uint8_t> chunks;
+        try {
+            if (record.get_String("type") != "world_snapshot") throw std::invalid_argument("Wrong record type.");
+            snapshot.width = static_cast<uint32_t>(record.get_I32("width"));
+            snapshot.depth = static_cast<uint32_t>(record.get_I32("depth"));
+            snapshot.chunkSize = static_cast<uint32_t>(record.get_I32("chunkSize"));
+            chunks = record.get_Bytes("chunks");
+        } catch (const std::invalid_argument&) {
+            std::stringstream error;
+            error << "File is not a world snapshot: " << filePath;
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+
+        const size_t tileCount = static_cast<size_t>(snapshot.chunkSize) * snapshot.chunkSize;
+        const size_t chunkBytes = 2 * sizeof(int32_t) + tileCount;
+        if ((tileCount == 0) || (chunks.size() % chunkBytes != 0)) {
+            std::stringstream error;
+            error << "World snapshot is truncated: " << filePath;
+            throw std::runtime_error(StackTrace::append_Stacktrace(error));
+        }
+
+        auto snapshotChunks = std::make_shared<std::vector<Snapshot::Chunk>>();
+        snapshotChunks->reserve(chunks.size() / chunkBytes);
+        for (size_t head = 0; head < chunks.size(); head += chunkBytes) {
+            Snapshot::Chunk chunk;
+            std::memcpy(&chunk.chunkX, chunks.data() + head, sizeof(int32_t));
+            std::memcpy(&chunk.chunkZ, chunks.data() + head + sizeof(int32_t), sizeof(int32_t));
+            const uint8_t* tiles = chunks.data() + head + 2 * sizeof(int32_t);
+            chunk.tiles = std::make_shared<const std::vector<uint8_t>>(tiles, tiles + tileCount);
+            snapshotChunks->push_back(std::move(chunk));
+        }
+        snapshot.chunks = std::move(snapshotChunks);
+        return snapshot;
+    }
+}
@@ -0,0 +1,314 @@
+#ifndef LOVE_WORLD_HPP
+#define LOVE_WORLD_HPP
+
+#include "../systems/system_scheduler.hpp"
+
+#include <love/common/data/files/file_journal.hpp>
+#include <love/common/data/files/logger.hpp>
+#include <love/common/system/thread_pool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace love_engine {
+    // Tile terrain on the x/z plane. Each tile has a movement cost, where 0 is impassable.
+    // The world is stored in square chunks. With a save directory, chunks are streamed: they load in the background
+    // around focus points (usually players), unload once idle or over the memory budget, and only changed chunks are
+    // saved. Tiles of chunks that are not resident read as impassable and cannot be changed.
+    // Tile changes are also appended to a journal in the save directory by save_Dirty(), which is cheap enough to
+    // call often. Chunks are saved in full when they unload and when the journal is compacted, and the journal is
+    // replayed over the chunk files when the world opens again.
+    // Chunk tiles are copy-on-write: saves and snapshots share them, and a chunk is only copied when the tick
+    // changes it while a save still holds it.
+    // Not thread-safe. Call everything from the tick thread; file work runs on the world's own IO threads.
+    class World {
+        public:
+            // Fills a new chunk's tiles, chunkSize * chunkSize of them in rows of x.
+            typedef std::function<void(const int32_t chunkX, const int32_t chunkZ, std::vector<uint8_t>& tiles)> Chunk_Generator;
+
+            typedef struct Settings_ {
+                uint32_t chunkSize = 64;
+                uint8_t defaultCost = 1;
+                // Empty keeps the whole world in memory.
+                std::string saveDirectory;
+                // Chunks within this many chunks of a focus point are kept loaded.
+                uint32_t loadRadius = 4;
+                // Ticks a chunk stays loaded after it leaves every load radius.
+                uint64_t idleTicks = 200;
+                size_t memoryBudget = 64 * 1024 * 1024;
+                size_t ioThreads = 2;
+                // Journal size at which save_Dirty() saves every changed chunk and empties the journal.
+                size_t journalCompactionBytes = 4 * 1024 * 1024;
+            } Settings;
+
+            typedef struct Focus_ {
+                int32_t x;
+                int32_t z;
+            } Focus;
+
+            typedef struct Chunk_Change_ {
+                int32_t chunkX;
+                int32_t chunkZ;
+            } Chunk_Change;
+
+            typedef struct Statistics_ {
+                size_t residentChunks = 0;
+                size_t residentBytes = 0;
+                size_t pendingLoads = 0;
+                size_t pendingSaves = 0;
+                uint64_t loads = 0;
+                uint64_t saves = 0;
+                uint64_t failedLoads = 0;
+                uint64_t failedSaves = 0;
+                // Chunks copied because a save or snapshot still shared them when they changed
+                uint64_t copiedChunks = 0;
+                uint64_t snapshotSaves = 0;
+                std::chrono::nanoseconds lastSnapshotSaveTime{0};
+                uint64_t journalAppends = 0;
+                uint64_t failedJournalAppends = 0;
+                uint64_t journalCompactions = 0;
+                uint64_t failedJournalCompactions = 0;
+            } Statistics;
+
+            // Resident tiles at one tick. Holding a snapshot never blocks the world.
+            typedef struct Snapshot_ {
+                typedef struct Chunk_ {
+                    int32_t chunkX;
+                    int32_t chunkZ;
+                    std::shared_ptr<const std::vector<uint8_t>> tiles;
+                } Chunk;
+
+                uint32_t width = 0;
+                uint32_t depth = 0;
+                uint32_t chunkSize = 0;
+                // Shared with the world's next snapshot, which copies it only if this one is still held
+                std::shared_ptr<const std::vector<Chunk>> chunks = std::make_shared<const std::vector<Chunk>>();
+            } Snapshot;
+
+            // In-memory world filled with @p defaultCost.
+            World(const uint32_t width, const uint32_t depth, const uint8_t defaultCost = 1)
+            : World(width, depth, Settings{.defaultCost = defaultCost}) {}
+            // Without a generator, new chunks are filled with Settings::defaultCost.
+            // @throw std::runtime_error If the save directory's journal cannot be read.
+            World(const uint32_t width, const uint32_t depth, const Settings settings, const Chunk_Generator& generator = nullptr);
+            World(World const&) = delete;
+            void operator=(World const&) = delete;
+            // Saves changed chunks in full, compacts the journal and waits for all file work.
+            ~World();
+
+            uint32_t get_Width() const noexcept { return _width; }
+            uint32_t get_Depth() const noexcept { return _depth; }
+            uint32_t get_Chunk_Size() const noexcept { return _settings.chunkSize; }
+
+            bool contains(const int32_t x, const int32_t z) const noexcept {
+                return (x >= 0) && (z >= 0) && (static_cast<uint32_t>(x) < _width) && (static_cast<uint32_t>(z) < _depth);
+            }
+            bool is_Loaded(const int32_t x, const int32_t z) const noexcept { return contains(x, z) && (_find_Chunk(x, z) != nullptr); }
+            // @return 0 if the tile is impassable, outside the world or not loaded.
+            uint8_t get_Tile_Cost(const int32_t x, const int32_t z) const noexcept {
+                if (!contains(x, z)) return 0;
+                const Chunk* chunk = _find_Chunk(x, z);
+                return chunk ? (*chunk->tiles)[_get_Tile_Index(x, z)] : 0;
+            }
+            bool is_Walkable(const int32_t x, const int32_t z) const noexcept { return get_Tile_Cost(x, z) != 0; }
+            // Ignored if the tile is outside the world or not loaded.
+            void set_Tile_Cost(const int32_t x, const int32_t z, const uint8_t cost) noexcept;
+            // Writes every tile cost into @p costs, width * depth of them in rows of x. Tiles that are not loaded are 0.
+            void copy_Tile_Costs(uint8_t*const costs) const noexcept;
+            // Like copy_Tile_Costs(), but only writes the tiles of one chunk.
+            void copy_Chunk_Tile_Costs(const int32_t chunkX, const int32_t chunkZ, uint8_t*const costs) const noexcept;
+
+            // Incremented by every terrain change, including chunks loading and unloading.
+            uint64_t get_Version() const noexcept { return _version; }
+            // Appends each chunk changed since get_Version() returned @p version once.
+            // @return false If changes that old are no longer tracked, so any chunk may have changed.
+            bool get_Changed_Chunks(const uint64_t version, std::vector<Chunk_Change>& changes) const noexcept;
+
+            // Chunks around these tiles are loaded and kept resident.
+            void set_Focus_Points(const std::vector<Focus>& points) noexcept { _focusPoints = points; }
+            // Applies finished loads, requests chunks near focus points and unloads idle chunks.
+            void update() noexcept;
+            // Appends the tile changes since the last call to the journal. Once the journal is large, every changed
+            // chunk is saved in the background and the journal is compacted after them.
+            // @return Number of tile changes since the last call.
+            size_t save_Dirty() noexcept;
+            // Waits for queued loads and saves and applies their results.
+            void flush() noexcept;
+
+            // Costs one pointer copy per chunk changed since the last snapshot, plus one per resident chunk if the
+            // last snapshot is still held. Later changes copy the chunks they touch.
+            Snapshot take_Snapshot() noexcept;
+            // Snapshots the world and writes it to @p filePath in the background. The duration is logged.
+            void save_Snapshot(const std::string& filePath) noexcept;
+            // Replaces the resident chunks covered by @p snapshot. They are marked changed, and with a save directory
+            // saved right away.
+            // @throw std::invalid_argument If the snapshot has different dimensions or chunk size.
+            void apply_Snapshot(const Snapshot& snapshot);
+            // @throw std::runtime_error If a file error occurs.
+            static void write_Snapshot(const Snapshot& snapshot, const std::string& filePath);
+            // @throw std::runtime_error If a file error occurs or the file is not a world snapshot.
+            static Snapshot read_Snapshot(const std::string& filePath);
+
+            // Logs snapshot saves. May be null.
+            void set_Logger(const Logger* logger) noexcept { _logger = logger; }
+
+            // System that updates this world once per tick.
+            SystemScheduler::System get_System() noexcept;
+
+            Statistics get_Statistics() const noexcept;
+
+        private:
+            typedef uint64_t Chunk_Key;
+
+            typedef struct Chunk_ {
+                // Shared with saves and snapshots while they run
+                std::shared_ptr<std::vector<uint8_t>> tiles;
+                uint64_t lastUsedTick = 0;
+                bool dirty = false;
+                // Set while _snapshotChunks holds these tiles
+                bool inSnapshot = false;
+            } Chunk;
+
+            typedef struct Change_ {
+                uint64_t version;
+                Chunk_Key key;
+            } Change;
+
+            enum class IO_Kind {
+                LOAD,
+                SAVE,
+                COMPACTION,
+            };
+
+            typedef struct IO_Result_ {
+                Chunk_Key key;
+                IO_Kind kind;
+                bool failed;
+                // Loaded tiles, or the unsaved tiles of a failed save
+                std::vector<uint8_t> tiles;
+                // Last journal record the loaded tiles contain
+                uint64_t journalSequence = 0;
+            } IO_Result;
+
+            typedef struct Queued_Save_ {
+                std::shared_ptr<const std::vector<uint8_t>> tiles;
+                // Last journal record the tiles contain
+                uint64_t journalSequence;
+            } Queued_Save;
+
+            // A tile change read from the journal
+            typedef struct Journal_Delta_ {
+                uint64_t sequence;
+                int32_t x;
+                int32_t z;
+                uint8_t cost;
+            } Journal_Delta;
+
+            // Journal records hold deltas of [x: i32][z: i32][cost: u8]. The compacted base holds the ones no chunk
+            // file contains yet, each as [sequence: u64][delta].
+            static constexpr size_t JOURNAL_DELTA_SIZE = 2 * sizeof(int32_t) + sizeof(uint8_t);
+
+            enum class Compaction_State {
+                IDLE,
+                // Saving every chunk changed before the compaction started. Appends wait.
+                SAVING,
+                // Writing the new base on an IO thread. Appends wait.
+                WRITING,
+            };
+
+            static Chunk_Key _get_Key(const int32_t chunkX, const int32_t chunkZ) noexcept {
+                return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkZ);
+            }
+            static int32_t _get_Chunk_X(const Chunk_Key key) noexcept { return static_cast<int32_t>(key >> 32); }
+            static int32_t _get_Chunk_Z(const Chunk_Key key) noexcept { return static_cast<int32_t>(key & UINT32_MAX); }
+
+            const Chunk* _find_Chunk(const int32_t x, const int32_t z) const noexcept {
+                const int32_t size = static_cast<int32_t>(_settings.chunkSize);
+                const auto chunk = _chunks.find(_get_Key(x / size, z / size));
+                return (chunk != _chunks.end()) ? chunk->second.get() : nullptr;
+            }
+            size_t _get_Tile_Index(const int32_t x, const int32_t z) const noexcept {
+                const uint32_t size = _settings.chunkSize;
+                return static_cast<size_t>(static_cast<uint32_t>(z) % size) * size + static_cast<uint32_t>(x) % size;
+            }
+            size_t _get_Chunk_Bytes() const noexcept { return static_cast<size_t>(_settings.chunkSize) * _settings.chunkSize + sizeof(Chunk); }
+            std::string _get_Chunk_Path(const Chunk_Key key) const noexcept;
+            // Bumps the version and records @p key as changed
+            void _mark_Changed(const Chunk_Key key) noexcept;
+
+            std::vector<uint8_t> _generate_Chunk(const Chunk_Key key) const noexcept;
+            void _load_Chunk(const Chunk_Key key) noexcept;
+            // Saves of one chunk never overlap. While one runs, the newest tiles wait in _queuedSaves.
+            void _save_Chunk(const Chunk_Key key, Chunk& chunk) noexcept;
+            void _submit_Save(const Chunk_Key key, Queued_Save save) noexcept;
+            void _add_Replayed_Delta(const uint64_t sequence, const uint8_t*const delta) noexcept;
+            // Appends _journalBuffer unless a compaction runs
+            void _append_Journal() noexcept;
+            // Saves every changed chunk, then empties the journal once those saves finished
+            void _start_Compaction() noexcept;
+            void _submit_Compaction() noexcept;
+            void _unload_Chunk(const Chunk_Key key) noexcept;
+            void _apply_IO_Results() noexcept;
+            ThreadPool& _get_IO_Pool() noexcept;
+
+            uint32_t _width;
+            uint32_t _depth;
+            Settings _settings;
+            Chunk_Generator _generator;
+            const Logger* _logger = nullptr;
+            uint64_t _version = 0;
+            uint64_t _tick = 0;
+            // Ascending by version. Repeated changes to one chunk share an entry.
+            std::vector<Change> _changes;
+            // Every change after this version is in _changes
+            uint64_t _changesFloor = 0;
+            static constexpr size_t MAX_TRACKED_CHANGES = 16384;
+            // Chunk list the next snapshot is built from, each chunk's index in it, and the chunks changed since
+            std::shared_ptr<std::vector<Snapshot::Chunk>> _snapshotChunks;
+            std::unordered_map<Chunk_Key, size_t> _snapshotIndices;
+            std::unordered_set<Chunk_Key> _snapshotDirty;
+
+            std::unordered_map<Chunk_Key, std::unique_ptr<Chunk>> _chunks;
+            std::vector<Focus> _focusPoints;
+            std::unordered_set<Chunk_Key> _loadingChunks;
+            // Chunks whose file could not be read. They are never loaded, so their file is never overwritten.
+            std::unordered_set<Chunk_Key> _failedChunks;
+            // Chunks with a save in flight. A chunk is not loaded again until its saves finish.
+            std::unordered_set<Chunk_Key> _savingChunks;
+            // Tiles to save once the save in flight for their chunk finishes
+            std::unordered_map<Chunk_Key, Queued_Save> _queuedSaves;
+
+            // Null without a save directory
+            std::unique_ptr<FileJournal> _journal;
+            // The journal's sequence, kept here so saves never wait on its lock while it compacts
+            uint64_t _journalSequence = 0;
+            // Deltas changed since the last append
+            std::vector<uint8_t> _journalBuffer;
+            // Replayed deltas, in order, per chunk not saved since. Applied when their chunk loads, skipping the
+            // ones the chunk file already contains.
+            std::unordered_map<Chunk_Key, std::vector<Journal_Delta>> _replayedDeltas;
+            Compaction_State _compaction = Compaction_State::IDLE;
+            // Set if a save failed since the compaction started, so the journal must keep its records
+            bool _compactionFailed = false;
+
+            Statistics _statistics;
+            std::mutex _ioResultsMutex;
+            std::vector<IO_Result> _ioResults;
+            // Written by snapshot saves on IO threads
+            std::atomic<uint64_t> _snapshotSaves = 0;
+            std::atomic<int64_t> _lastSnapshotSaveTime = 0;
+            // Last member, so IO threads are joined before the state they report to is destroyed
+            std::unique_ptr<ThreadPool> _ioPool;
+    };
+}
+
+#endif // LOVE_WORLD_HPP
@@ -0,0 +1,232 @@
+#include <love/common/error/crash_dump.hpp>
+
+#include <cinttypes>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <elf.h>
+#endif
+
+using namespace love_engine;
+
+#ifdef __linux__
+
+typedef struct Location_ {
+    std::string function;
+    std::string line;
+} Location;
+
+// Innermost first, then the functions it was inlined into
+typedef std::vector<Location> Resolved_Frame;
+
+// Prefers a copy from a symbol directory, since the module that crashed may be stripped
+static std::string _find_Module_File(const std::string& modulePath, const std::vector<std::string>& symbolDirectories) {
+    const std::filesystem::path name = std::filesystem::path(modulePath).filename();
+    for (const std::string& directory : symbolDirectories) {
+        const std::filesystem::path candidate = std::filesystem::path(directory) / name;
+        std::error_code error;
+        if (std::filesystem::is_regular_file(candidate, error)) return candidate.string();
+    }
+    return modulePath;
+}
+
+// Converts a file offset to the address the module's debug information uses
+static uint64_t _get_Module_Address(const std::string& filePath, const uint64_t fileOffset) {
+    std::ifstream file(filePath, std::ios::binary);
+    Elf64_Ehdr header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return fileOffset;
+    if ((std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0) || (header.e_ident[EI_CLASS] != ELFCLASS64)) return fileOffset;
+
+    for (uint16_t i = 0; i < header.e_phnum; ++i) {
+        Elf64_Phdr program;
+        file.seekg(static_cast<std::streamoff>(header.e_phoff + i * header.e_phentsize));
+        if (!file.read(reinterpret_cast<char*>(&program), sizeof(program))) break;
+        if ((program.p_type == PT_LOAD) && (fileOffset >= program.p_offset) && (fileOffset < program.p_offset + program.p_filesz)) {
+            return fileOffset - program.p_offset + program.p_vaddr;
+        }
+    }
+    return fileOffset;
+}
+
+static std::string _quote(const std::string& text) {
+    std::string quoted = "'";
+    for (const char c : text) {
+        if (c == '\'') quoted += "'\\''";
+        else quoted += c;
+    }
+    return quoted + "'";
+}
+
+// @return One frame per address, empty where addr2line failed.
+static std::vector<Resolved_Frame> _resolve(const std::string& addr2line, const std::string& filePath, const std::vector<uint64_t>& addresses) {
+    std::vector<Resolved_Frame> frames(addresses.size());
+    std::string command = _quote(addr2line) + " -a -f -C -i -e " + _quote(filePath);
+    for (const uint64_t address : addresses) {
+        char text[24];
+        std::snprintf(text, sizeof(text), " 0x%" PRIx64, address);
+        command += text;
+    }
+    command += " 2>/dev/null";
+
+    FILE* output = popen(command.c_str(), "r");
+    if (output == nullptr) return frames;
+
+    // "0xADDRESS", then a function and "file:line" pair per inlining level
+    std::vector<std::string> lines;
+    char buffer[4096];
+    while (std::fgets(buffer, sizeof(buffer), output)) {
+        std::string line(buffer);
+        while (!line.empty() && ((line.back() == '\n') || (line.back() == '\r'))) line.pop_back();
+        lines.push_back(line);
+    }
+    pclose(output);
+
+    long frame = -1;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (lines[i].starts_with("0x")) {
+            ++frame;
+            continue;
+        }
+        if ((frame < 0) || (static_cast<size_t>(frame) >= frames.size()) || (i + 1 >= lines.size())) break;
+        frames[frame].push_back(Location{.function = lines[i], .line = lines[i + 1]});
+        ++i;
+    }
+    return frames;
+}
+
+static std::string _get_Thread_Name(const CrashDump::Dump& dump, const int64_t id) {
+    for (const CrashDump::Thread_Entry& thread : dump.threads) {
+        if (thread.id == id) return thread.name;
+    }
+    return "?";
+}
+
+// crashsym <dump> [--symbols <directory>]... [--addr2line <path>]
+// Prints a crash dump written by the crash signal handler, with every frame resolved to its function, file and line.
+// Modules are looked for by file name in each --symbols directory first, so unstripped copies of release binaries
+// can be used.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <dump> [--symbols <directory>]... [--addr2line <path>]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<std::string> symbolDirectories;
+    std::string addr2line = "addr2line";
+    for (int i = 2; i < argc; ++i) {
+        if ((std::strcmp(argv[i], "--symbols") == 0) && (i + 1 < argc)) symbolDirectories.push_back(argv[++i]);
+        else if ((std::strcmp(argv[i], "--addr2line") == 0) && (i + 1 < argc)) addr2line = argv[++i];
+    }
+
+    CrashDump::Dump dump;
+    try {
+        dump = CrashDump::read(argv[1]);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        exit(EXIT_FAILURE);
+    }
+
+    // Resolve every module's frames with one addr2line run
+    typedef struct Frame_Address_ {
+        size_t frame;
+        uint64_t address;
+    } Frame_Address;
+    std::map<std::string, std::vector<Frame_Address>> moduleFrames;
+    std::vector<std::string> frameModules(dump.frames.size());
+    std::vector<uint64_t> frameOffsets(dump.frames.size(), 0);
+    // Frames before the faulting instruction are the signal handler's own
+    size_t firstFrame = 0;
+    for (size_t i = 0; i < dump.frames.size(); ++i) {
+        if ((dump.header.instructionAddress != 0) && (dump.frames[i] == dump.header.instructionAddress)) {
+            firstFrame = i;
+            break;
+        }
+    }
+    for (size_t i = firstFrame; i < dump.frames.size(); ++i) {
+        const CrashDump::Module* module = CrashDump::find_Module(dump, dump.frames[i]);
+        if (module == nullptr) continue;
+        // Return addresses point past the call, which may already be the next line
+        const bool faulted = (dump.frames[i] == dump.header.instructionAddress);
+        const uint64_t pc = faulted ? dump.frames[i] : dump.frames[i] - 1;
+        frameModules[i] = module->path;
+        frameOffsets[i] = pc - module->start + module->offset;
+        moduleFrames[module->path].push_back(Frame_Address{.frame = i, .address = 0});
+    }
+
+    std::vector<Resolved_Frame> resolved(dump.frames.size());
+    for (auto& [modulePath, frames] : moduleFrames) {
+        const std::string filePath = _find_Module_File(modulePath, symbolDirectories);
+        std::vector<uint64_t> addresses;
+        for (Frame_Address& frame : frames) {
+            frame.address = _get_Module_Address(filePath, frameOffsets[frame.frame]);
+            addresses.push_back(frame.address);
+        }
+        const std::vector<Resolved_Frame> locations = _resolve(addr2line, filePath, addresses);
+        for (size_t i = 0; i < frames.size(); ++i) resolved[frames[i].frame] = locations[i];
+    }
+
+    const CrashDump::Header& header = dump.header;
+    const time_t seconds = static_cast<time_t>(header.timeSeconds);
+    char timeBuffer[64] = "?";
+    if (const std::tm* time = std::gmtime(&seconds)) std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", time);
+
+    std::printf("---- Crash Dump ----\n");
+    std::printf("Time: %s.%06" PRId64 " UTC\n", timeBuffer, header.timeNanoseconds / 1000);
+    std::printf("Signal: %d (%s), code %d\n", header.signal, strsignal(header.signal), header.code);
+    std::printf("Fault Address: 0x%" PRIx64 "\n", header.faultAddress);
+    std::printf("Instruction Address: 0x%" PRIx64 "\n", header.instructionAddress);
+    std::printf("Crashing Thread: %s (%" PRId64 ")\n", _get_Thread_Name(dump, header.crashingThread).c_str(), header.crashingThread);
+
+    std::printf("\n---- Stack Trace -----\n");
+    if (firstFrame > 0) std::printf("(%zu frames in the signal handler skipped)\n", firstFrame);
+    for (size_t i = firstFrame; i < dump.frames.size(); ++i) {
+        std::printf("#%-3zu 0x%016" PRIx64, i - firstFrame, dump.frames[i]);
+        if (frameModules[i].empty()) {
+            std::printf(" ??\n");
+            continue;
+        }
+        const std::string module = std::filesystem::path(frameModules[i]).filename().string();
+        if (resolved[i].empty() || (resolved[i][0].function == "??")) {
+            std::printf(" %s+0x%" PRIx64 "\n", module.c_str(), frameOffsets[i]);
+            continue;
+        }
+        std::printf(" %s at %s (%s+0x%" PRIx64 ")\n", resolved[i][0].function.c_str(), resolved[i][0].line.c_str(), module.c_str(), frameOffsets[i]);
+        for (size_t j = 1; j < resolved[i].size(); ++j) {
+            std::printf("     inlined into %s at %s\n", resolved[i][j].function.c_str(), resolved[i][j].line.c_str());
+        }
+    }
+
+    std::printf("\n---- Threads ---------\n");
+    for (const CrashDump::Thread_Entry& thread : dump.threads) {
+        std::printf("%c %8" PRId64 " %s\n", (thread.id == header.crashingThread) ? '*' : ' ', thread.id, thread.name.c_str());
+    }
+
+    std::printf("\n---- Last Log Messages ----\n");
+    for (const std::string& message : dump.logMessages) std::printf("%s\n", message.c_str());
+
+    std::printf("\n---- Modules ---------\n");
+    for (const CrashDump::Module& module : dump.modules) {
+        std::printf("0x%016" PRIx64 "-0x%016" PRIx64 " +0x%-8" PRIx64 " %s\n", module.start, module.end, module.offset, module.path.c_str());
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+#else
+
+int main(int argc, char** argv) {
+    std::fprintf(stderr, "%s: only supported on Linux\n", (argc > 0) ? argv[0] : "crashsym");
+    exit(EXIT_FAILURE);
+}
+
+#endif
@@ -0,0 +1,486 @@
+#include <love/common/system/fixed_timestep.hpp>
+#include <love/common/system/metrics.hpp>
+#include <love/common/system/thread.hpp>
+#include <love/common/system/thread_placement.hpp>
+#include <love/server/server_instance.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace love_engine;
+
+#ifdef __linux__
+
+typedef std::chrono::steady_clock Clock;
+
+static constexpr uint32_t _INPUT_MAGIC = 0x4C494E50; // "LINP"
+static constexpr uint32_t _STATE_MAGIC = 0x4C535441; // "LSTA"
+// Every datagram also costs its UDP and IPv4 headers on the wire
+static constexpr size_t _HEADER_BYTES = 28;
+
+typedef struct Input_Packet_ {
+    uint32_t magic;
+    uint32_t client;
+    uint32_t sequence;
+    // Last state the client received, as a real client would acknowledge
+    uint32_t ack;
+    int8_t moveX, moveZ;
+    uint8_t buttons;
+    uint8_t padding[13];
+} Input_Packet;
+
+// Followed by filler up to --state-bytes, standing in for nearby entities
+typedef struct State_Header_ {
+    uint32_t magic;
+    uint32_t client;
+    uint32_t sequence;
+    uint32_t lastInput;
+    float x, z;
+} State_Header;
+
+typedef struct Settings_ {
+    std::vector<size_t> clients = {8, 32, 128, 512};
+    double stepSeconds = 5.;
+    double inputRate = 30.;
+    float msPerTick = 50.f;
+    size_t stateBytes = 256;
+    size_t driverThreads = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 8);
+    size_t workerThreads = std::thread::hardware_concurrency();
+    std::string csvPath;
+    bool pinThreads = false;
+} Settings;
+
+// Written by the receiver and worker threads, read once the step is over
+typedef struct Server_Client_ {
+    std::atomic<uint64_t> receivedInputs = 0, receivedBytes = 0;
+    std::atomic<uint64_t> sentStates = 0, sentBytes = 0, failedStates = 0;
+    // Set once by the receiver from the first input, then only read
+    sockaddr_in address;
+    std::atomic<bool> known = false;
+
+    // Only used by the tick thread
+    float x = 0.f, z = 0.f;
+    int8_t moveX = 0, moveZ = 0;
+    uint32_t lastInput = 0;
+} Server_Client;
+
+typedef struct Client_ {
+    int socket = -1;
+    uint32_t id = 0;
+    std::mt19937 random;
+    Clock::time_point nextInput;
+
+    // Current segment of the input script
+    int8_t moveX = 0, moveZ = 0;
+    uint8_t buttons = 0;
+    uint32_t segmentInputs = 0;
+
+    uint32_t sequence = 0;
+    uint64_t sentBytes = 0;
+    uint32_t lastState = 0;
+    uint64_t receivedStates = 0, receivedBytes = 0;
+} Client;
+
+typedef struct Step_Result_ {
+    size_t clients = 0;
+    uint64_t ticks = 0, overrunTicks = 0;
+    double p50Ms = 0., p90Ms = 0., p99Ms = 0., maxMs = 0.;
+    double upBytesPerClient = 0., downBytesPerClient = 0.;
+    double upLoss = 0., downLoss = 0.;
+} Step_Result;
+
+class Input_Command : public Command {
+    public:
+        Input_Command(Server_Client& client, const uint32_t id, const uint32_t sequence, const int8_t moveX, const int8_t moveZ)
+        : _client(client), _id(id), _sequence(sequence), _moveX(moveX), _moveZ(moveZ) {}
+
+        void execute([[maybe_unused]] ServerInstance& server) noexcept override {
+            // Datagrams may arrive out of order, so older inputs are dropped
+            if (_sequence <= _client.lastInput) return;
+            _client.lastInput = _sequence;
+            _client.moveX = _moveX;
+            _client.moveZ = _moveZ;
+        }
+
+        std::string get_Type() const noexcept override { return "loadgen_input"; }
+        void serialize(BKV_Builder& builder) const override {
+            builder.add_I32("client", static_cast<int32_t>(_id)).add_I32("sequence", static_cast<int32_t>(_sequence));
+            builder.add_I8("moveX", _moveX).add_I8("moveZ", _moveZ);
+        }
+
+    private:
+        Server_Client& _client;
+        uint32_t _id, _sequence;
+        int8_t _moveX, _moveZ;
+};
+
+static bool _read_Count_List(const char* text, std::vector<size_t>& counts) {
+    counts.clear();
+    for (const char* p = text; *p;) {
+        char* end;
+        const size_t count = std::strtoull(p, &end, 10);
+        if ((end == p) || (count == 0)) return false;
+        counts.push_back(count);
+        p = (*end == ',') ? end + 1 : end;
+        if ((*end != ',') && (*end != '\0')) return false;
+    }
+    return !counts.empty();
+}
+
+// Walks in a direction, idles or presses a button for a few seconds, like a player would
+static void _next_Segment(Client& client, const double inputRate) {
+    const uint32_t roll = client.random() % 10;
+    client.moveX = client.moveZ = 0;
+    client.buttons = 0;
+    if (roll < 7) {
+        do {
+            client.moveX = static_cast<int8_t>(static_cast<int>(client.random() % 3) - 1);
+            client.moveZ = static_cast<int8_t>(static_cast<int>(client.random() % 3) - 1);
+        } while ((client.moveX == 0) && (client.moveZ == 0));
+    } else if (roll == 9) client.buttons = static_cast<uint8_t>(1 << (client.random() % 4));
+    const double seconds = 0.5 + (client.random() % 2500) / 1000.;
+    client.segmentInputs = std::max<uint32_t>(1, static_cast<uint32_t>(seconds * inputRate));
+}
+
+static void _send_Input(Client& client, const Settings& settings) {
+    if (client.segmentInputs == 0) _next_Segment(client, settings.inputRate);
+    --client.segmentInputs;
+
+    Input_Packet packet;
+    std::memset(&packet, 0, sizeof(packet));
+    packet.magic = _INPUT_MAGIC;
+    packet.client = client.id;
+    packet.sequence = ++client.sequence;
+    packet.ack = client.lastState;
+    packet.moveX = client.moveX;
+    packet.moveZ = client.moveZ;
+    packet.buttons = client.buttons;
+    // A failed send is a lost packet, as it would be on a congested link
+    if (send(client.socket, &packet, sizeof(packet), MSG_DONTWAIT) == static_cast<ssize_t>(sizeof(packet))) {
+        client.sentBytes += sizeof(packet) + _HEADER_BYTES;
+    }
+
+    // Input timing follows the client's frame rate, so it jitters by up to 10%
+    const double jitter = 0.9 + (client.random() % 2001) / 10000.;
+    client.nextInput += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(jitter / settings.inputRate));
+}
+
+static void _drive_Clients(std::vector<Client*> clients, const Settings& settings, const Clock::time_point sendDeadline, const std::atomic<bool>& stopping) {
+    std::vector<pollfd> requests(clients.size());
+    for (size_t i = 0; i < clients.size(); ++i) requests[i] = pollfd{.fd = clients[i]->socket, .events = POLLIN, .revents = 0};
+    std::vector<char> buffer(std::max(settings.stateBytes, sizeof(State_Header)) + 1);
+
+    while (!stopping) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point wake = now + std::chrono::milliseconds(5);
+        if (now < sendDeadline) {
+            for (Client* client : clients) {
+                if (client->nextInput <= now) _send_Input(*client, settings);
+                wake = std::min(wake, client->nextInput);
+            }
+        }
+
+        const int timeout = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wake - Clock::now()).count());
+        if (poll(requests.data(), requests.size(), std::max(timeout, 0)) <= 0) continue;
+        for (size_t i = 0; i < requests.size(); ++i) {
+            if (!(requests[i].revents & POLLIN)) continue;
+            Client& client = *clients[i];
+            ssize_t length;
+            while ((length = recv(client.socket, buffer.data(), buffer.size(), MSG_DONTWAIT)) >= static_cast<ssize_t>(sizeof(State_Header))) {
+                State_Header header;
+                std::memcpy(&header, buffer.data(), sizeof(header));
+                if ((header.magic != _STATE_MAGIC) || (header.client != client.id)) continue;
+                ++client.receivedStates;
+                client.receivedBytes += static_cast<uint64_t>(length) + _HEADER_BYTES;
+                client.lastState = std::max(client.lastState, header.sequence);
+            }
+        }
+    }
+}
+
+static void _receive_Inputs(const int serverSocket, Server_Client* serverClients, const size_t clientCount, CommandQueue& queue, const std::atomic<bool>& stopping) {
+    pollfd request{.fd = serverSocket, .events = POLLIN, .revents = 0};
+    Input_Packet packet;
+    sockaddr_in address;
+    while (!stopping) {
+        if (poll(&request, 1, 10) <= 0) continue;
+        for (;;) {
+            socklen_t addressLength = sizeof(address);
+            const ssize_t length = recvfrom(serverSocket, &packet, sizeof(packet), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&address), &addressLength);
+            if (length < 0) break;
+            if ((length != sizeof(packet)) || (packet.magic != _INPUT_MAGIC) || (packet.client >= clientCount)) continue;
+
+            Server_Client& client = serverClients[packet.client];
+            if (!client.known.load(std::memory_order_relaxed)) {
+                client.address = address;
+                client.known.store(true, std::memory_order_release);
+            }
+            client.receivedInputs.fetch_add(1, std::memory_order_relaxed);
+            client.receivedBytes.fetch_add(static_cast<uint64_t>(length) + _HEADER_BYTES, std::memory_order_relaxed);
+            queue.push<Input_Command>(client, packet.client, packet.sequence, packet.moveX, packet.moveZ);
+        }
+    }
+}
+
+// @return -1 If the socket could not be created.
+static int _open_Socket(const sockaddr_in* bindAddress, const sockaddr_in* connectAddress, const int receiveBuffer) {
+    const int socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket < 0) return -1;
+    if (receiveBuffer > 0) setsockopt(socket, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+    if (bindAddress && bind(socket, reinterpret_cast<const sockaddr*>(bindAddress), sizeof(*bindAddress))) {
+        close(socket);
+        return -1;
+    }
+    if (connectAddress && connect(socket, reinterpret_cast<const sockaddr*>(connectAddress), sizeof(*connectAddress))) {
+        close(socket);
+        return -1;
+    }
+    return socket;
+}
+
+static bool _run_Step(const size_t clientCount, const Settings& settings, Step_Result& result) {
+    sockaddr_in serverAddress;
+    std::memset(&serverAddress, 0, sizeof(serverAddress));
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    const int serverSocket = _open_Socket(&serverAddress, nullptr, 8 * 1024 * 1024);
+    if (serverSocket < 0) {
+        std::fprintf(stderr, "Could not open the server socket: %s\n", std::strerror(errno));
+        return false;
+    }
+    socklen_t addressLength = sizeof(serverAddress);
+    getsockname(serverSocket, reinterpret_cast<sockaddr*>(&serverAddress), &addressLength);
+
+    std::vector<Client> clients(clientCount);
+    for (size_t i = 0; i < clientCount; ++i) {
+        clients[i].socket = _open_Socket(nullptr, &serverAddress, 0);
+        if (clients[i].socket < 0) {
+            std::fprintf(stderr, "Could not open socket for client %zu: %s\n", i, std::strerror(errno));
+            for (size_t j = 0; j < i; ++j) close(clients[j].socket);
+            close(serverSocket);
+            return false;
+        }
+        clients[i].id = static_cast<uint32_t>(i);
+        clients[i].random.seed(static_cast<uint32_t>(i * 7919 + 17));
+    }
+
+    std::unique_ptr<Server_Client[]> serverClients(new Server_Client[clientCount]);
+    ServerInstance server(ServerInstance::Settings{.msPerTick = settings.msPerTick, .workerThreads = settings.workerThreads, .pinThreads = settings.pinThreads});
+
+    const size_t stateBytes = std::max(settings.stateBytes, sizeof(State_Header));
+    uint32_t tick = 0;
+    server.get_Scheduler().add_System(SystemScheduler::System{
+        .name = "loadgen_state",
+        .reads = {},
+        .writes = {},
+        .update = [&](ThreadPool& pool) {
+            ++tick;
+            const float step = settings.msPerTick / 1000.f * 4.f;
+            pool.parallel_For(0, clientCount, 64, [&](size_t begin, size_t end) {
+                std::vector<char> packet(stateBytes, 0);
+                for (size_t i = begin; i < end; ++i) {
+                    Server_Client& client = serverClients[i];
+                    client.x += client.moveX * step;
+                    client.z += client.moveZ * step;
+                    if (!client.known.load(std::memory_order_acquire)) continue;
+
+                    const State_Header header{
+                        .magic = _STATE_MAGIC, .client = static_cast<uint32_t>(i), .sequence = tick,
+                        .lastInput = client.lastInput, .x = client.x, .z = client.z,
+                    };
+                    std::memcpy(packet.data(), &header, sizeof(header));
+                    const ssize_t sent = sendto(serverSocket, packet.data(), packet.size(), MSG_DONTWAIT,
+                        reinterpret_cast<const sockaddr*>(&client.address), sizeof(client.address)
+                    );
+                    if (sent == static_cast<ssize_t>(packet.size())) {
+                        client.sentStates.fetch_add(1, std::memory_order_relaxed);
+                        client.sentBytes.fetch_add(packet.size() + _HEADER_BYTES, std::memory_order_relaxed);
+                    } else client.failedStates.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        },
+    });
+
+    // Timed here instead of through ServerInstance::run(), so every step gets its own percentiles
+    std::unique_ptr<Metrics::Histogram> tickTimes = std::make_unique<Metrics::Histogram>();
+    FixedTimestep timestep(FixedTimestep::Settings{
+        .tickDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double, std::milli>(settings.msPerTick)),
+    });
+
+    std::atomic<bool> tickStopping = false, receiverStopping = false, clientsStopping = false;
+    Thread receiver("LOADGEN_RECEIVER", [&]() {
+        if (settings.pinThreads) ThreadPlacement::pin_Current_Thread(ThreadPlacement::Role::NETWORK_IO);
+        _receive_Inputs(serverSocket, serverClients.get(), clientCount, server.get_Command_Queue(), receiverStopping);
+    });
+    Thread ticker("LOADGEN_TICK", [&]() {
+        if (settings.pinThreads) ThreadPlacement::pin_Current_Thread(ThreadPlacement::Role::TICK);
+        timestep.run([&]() { return tickStopping.load(); }, [&]() {
+            const Clock::time_point start = Clock::now();
+            server.tick();
+            tickTimes->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+        });
+    });
+
+    // Clients join at random points of the first input interval, rather than all at once
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point sendDeadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(settings.stepSeconds));
+    std::uniform_real_distribution<double> offset(0., 1. / settings.inputRate);
+    std::mt19937 random(static_cast<uint32_t>(clientCount));
+    for (Client& client : clients) client.nextInput = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(offset(random)));
+
+    const size_t driverCount = std::min(settings.driverThreads, clientCount);
+    std::vector<std::unique_ptr<Thread>> drivers;
+    for (size_t d = 0; d < driverCount; ++d) {
+        std::vector<Client*> owned;
+        for (size_t i = d; i < clientCount; i += driverCount) owned.push_back(&clients[i]);
+        drivers.push_back(std::make_unique<Thread>("LOADGEN_CLIENTS_" + std::to_string(d), [&settings, sendDeadline, &clientsStopping](std::vector<Client*> owned) {
+            _drive_Clients(std::move(owned), settings, sendDeadline, clientsStopping);
+        }, std::move(owned)));
+    }
+
+    // Stop ticking when inputs stop, then give packets in flight time to land before counting
+    std::this_thread::sleep_until(sendDeadline);
+    tickStopping = true;
+    ticker.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    clientsStopping = true;
+    for (auto& driver : drivers) driver->join();
+    receiverStopping = true;
+    receiver.join();
+
+    uint64_t upSent = 0, upReceived = 0, upBytes = 0, downAttempted = 0, downReceived = 0, downBytes = 0;
+    for (size_t i = 0; i < clientCount; ++i) {
+        upSent += clients[i].sequence;
+        upBytes += clients[i].sentBytes;
+        downReceived += clients[i].receivedStates;
+        downBytes += clients[i].receivedBytes;
+        upReceived += serverClients[i].receivedInputs.load();
+        downAttempted += serverClients[i].sentStates.load() + serverClients[i].failedStates.load();
+        close(clients[i].socket);
+    }
+    close(serverSocket);
+
+    const FixedTimestep::Statistics& statistics = timestep.get_Statistics();
+    result.clients = clientCount;
+    result.ticks = statistics.ticks;
+    result.overrunTicks = statistics.overrunTicks;
+    result.p50Ms = tickTimes->get_Quantile(0.5) / 1e6;
+    result.p90Ms = tickTimes->get_Quantile(0.9) / 1e6;
+    result.p99Ms = tickTimes->get_Quantile(0.99) / 1e6;
+    result.maxMs = tickTimes->get_Max() / 1e6;
+    result.upBytesPerClient = upBytes / settings.stepSeconds / clientCount;
+    result.downBytesPerClient = downBytes / settings.stepSeconds / clientCount;
+    result.upLoss = upSent ? 100. * (upSent - std::min(upReceived, upSent)) / upSent : 0.;
+    result.downLoss = downAttempted ? 100. * (downAttempted - std::min(downReceived, downAttempted)) / downAttempted : 0.;
+    return true;
+}
+
+// Every client needs its own socket
+static void _raise_File_Limit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit)) return;
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+// loadgen [--clients 8,32,128,512] [--duration seconds] [--input-rate hz] [--tick-ms ms]
+//         [--state-bytes bytes] [--driver-threads n] [--worker-threads n] [--csv file] [--pin]
+// Runs a server and simulated clients in one process, talking UDP over loopback. Each client sends scripted
+// inputs at the input rate and receives a state update every tick. For each client count, reports server
+// tick times, bandwidth per client including UDP/IPv4 headers, and the share of packets lost each way.
+// --pin places the tick, receiver and worker threads with ThreadPlacement; client drivers stay unpinned.
+int main(int argc, char** argv) {
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (hasValue && (std::strcmp(argv[i], "--clients") == 0)) {
+            if (!_read_Count_List(argv[++i], settings.clients)) {
+                std::fprintf(stderr, "Invalid client counts: %s\n", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+        } else if (hasValue && (std::strcmp(argv[i], "--duration") == 0)) settings.stepSeconds = std::max(0.1, std::strtod(argv[++i], nullptr));
+        else if (hasValue && (std::strcmp(argv[i], "--input-rate") == 0)) settings.inputRate = std::max(1., std::strtod(argv[++i], nullptr));
+        else if (hasValue && (std::strcmp(argv[i], "--tick-ms") == 0)) settings.msPerTick = std::max(1.f, std::strtof(argv[++i], nullptr));
+        else if (hasValue && (std::strcmp(argv[i], "--state-bytes") == 0)) settings.stateBytes = std::min<size_t>(60000, std::strtoull(argv[++i], nullptr, 10));
+        else if (hasValue && (std::strcmp(argv[i], "--driver-threads") == 0)) settings.driverThreads = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        else if (hasValue && (std::strcmp(argv[i], "--worker-threads") == 0)) settings.workerThreads = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        else if (hasValue && (std::strcmp(argv[i], "--csv") == 0)) settings.csvPath = argv[++i];
+        else if (std::strcmp(argv[i], "--pin") == 0) settings.pinThreads = true;
+        else {
+            std::fprintf(stderr, "Usage: %s [--clients 8,32,128,512] [--duration seconds] [--input-rate hz] [--tick-ms ms] "
+                "[--state-bytes bytes] [--driver-threads n] [--worker-threads n] [--csv file] [--pin]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    _raise_File_Limit();
+
+    std::printf("%.1f ms ticks, %.0f inputs/s per client, %zu byte states, %.1f s per step\n",
+        settings.msPerTick, settings.inputRate, std::max(settings.stateBytes, sizeof(State_Header)), settings.stepSeconds
+    );
+    if (settings.pinThreads) std::printf("%s\n", ThreadPlacement::get_Description().c_str());
+    std::printf("%8s %8s %8s %8s %8s %8s %12s %12s %10s %10s\n",
+        "clients", "ticks", "p50 ms", "p90 ms", "p99 ms", "max ms", "up B/s/cl", "down B/s/cl", "up loss%", "down loss%"
+    );
+    std::fflush(stdout);
+
+    std::vector<Step_Result> results;
+    for (const size_t clientCount : settings.clients) {
+        Step_Result result;
+        if (!_run_Step(clientCount, settings, result)) exit(EXIT_FAILURE);
+        std::printf("%8zu %8llu %8.3f %8.3f %8.3f %8.3f %12.0f %12.0f %10.3f %10.3f%s\n",
+            result.clients, static_cast<unsigned long long>(result.ticks), result.p50Ms, result.p90Ms, result.p99Ms, result.maxMs,
+            result.upBytesPerClient, result.downBytesPerClient, result.upLoss, result.downLoss,
+            result.overrunTicks ? (" (" + std::to_string(result.overrunTicks) + " overruns)").c_str() : ""
+        );
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+
+    if (!settings.csvPath.empty()) {
+        FILE* file = std::fopen(settings.csvPath.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "Could not open %s: %s\n", settings.csvPath.c_str(), std::strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+        std::fprintf(file, "clients,ticks,overrun_ticks,tick_p50_ms,tick_p90_ms,tick_p99_ms,tick_max_ms,"
+            "up_bytes_per_second_per_client,down_bytes_per_second_per_client,up_loss_percent,down_loss_percent\n");
+        for (const Step_Result& result : results) {
+            std::fprintf(file, "%zu,%llu,%llu,%.4f,%.4f,%.4f,%.4f,%.1f,%.1f,%.4f,%.4f\n",
+                result.clients, static_cast<unsigned long long>(result.ticks), static_cast<unsigned long long>(result.overrunTicks),
+                result.p50Ms, result.p90Ms, result.p99Ms, result.maxMs,
+                result.upBytesPerClient, result.downBytesPerClient, result.upLoss, result.downLoss
+            );
+        }
+        std::fclose(file);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+#else
+
+int main(int argc, char** argv) {
+    std::fprintf(stderr, "%s: only supported on Linux\n", (argc > 0) ? argv[0] : "loadgen");
+    exit(EXIT_FAILURE);
+}
+
+#endif
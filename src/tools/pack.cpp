@@ -0,0 +1,36 @@
+#include <love/common/data/files/pack_archive.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace love_engine;
+
+// pack <directory> <archive> [--store]
+// Bundles every file under a directory into a pack archive. --store disables compression.
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: %s <directory> <archive> [--store]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    PackArchive::Pack_Settings settings;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--store") == 0) settings.compress = false;
+    }
+
+    try {
+        const PackArchive::Pack_Result result = PackArchive::pack(argv[1], argv[2], settings);
+        std::printf("Packed %zu files (%zu compressed), %llu bytes into %llu bytes: %s\n",
+            result.entries, result.compressedEntries,
+            static_cast<unsigned long long>(result.inputBytes), static_cast<unsigned long long>(result.archiveBytes), argv[2]
+        );
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        exit(EXIT_FAILURE);
+    }
+
+    exit(EXIT_SUCCESS);
+}